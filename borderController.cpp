@@ -0,0 +1,216 @@
+#include "pch.hpp"
+#include "borderController.hpp"
+
+#include "inputEvent.hpp"
+#include "tinylog.hpp"
+#include "utils/dwm.hpp"
+#include "utils/mon.hpp"
+#include "utils/render_stats.hpp"
+#include "utils/utils.hpp"
+
+// One pooled border window, stacked directly above the window it outlines
+class BorderController::Surface {
+  public:
+    Surface(HINSTANCE hi, const Config* cfg) : config(cfg) {
+        ok = overlay.Init(hi, cfg->m_settings.softwareRenderer, false);
+    }
+
+    bool Ok() const { return ok; }
+
+    void Place(const utils::pool::Placement& p) {
+        const Settings& s = config->m_settings;
+        // no rotation: a persistent border only redraws when its window changes
+        if (p.active && s.gradient)
+            overlay.SetGradient(s.color, s.color2, s.gradientAngleDeg);
+        else
+            overlay.SetColor(p.active ? s.color : s.inactiveColor);
+        overlay.SetBorderThickness(s.borderThickness);
+
+        overlay.SetGeometry(Rect(p), InsertAfter(p));
+        overlay.Show();
+        overlay.Render();
+    }
+
+    // Same bounds and colour, but windows changed z-order: only move back above the target
+    void Restack(const utils::pool::Placement& p) {
+        if (const std::optional<HWND> after = InsertAfter(p))
+            overlay.SetGeometry(Rect(p), after);
+    }
+
+    void Park() {
+        overlay.Hide();
+    }
+
+  private:
+    static RECT Rect(const utils::pool::Placement& p) {
+        return {p.bounds.left, p.bounds.top, p.bounds.right, p.bounds.bottom};
+    }
+
+    // Directly above the target: after the window above it, HWND_TOP when the target is topmost of
+    // its band, nothing when the border already sits there
+    std::optional<HWND> InsertAfter(const utils::pool::Placement& p) const {
+        const HWND above = GetWindow(reinterpret_cast<HWND>(p.key), GW_HWNDPREV);
+        if (above == overlay.GetHwnd())
+            return std::nullopt;
+        return above ? above : HWND_TOP;
+    }
+
+    const Config* config;
+    OverlayWindow overlay;
+    bool ok = false;
+};
+
+BorderController::BorderController(HINSTANCE hi, Config* cfg) : hInstance(hi), config(cfg) {
+    instance = this;
+    borderThread = std::jthread([this](std::stop_token st) { BorderLoop(st); });
+}
+
+BorderController::~BorderController() {
+    if (borderThread.joinable()) {
+        borderThread.request_stop(); // the stop callback wakes the message wait
+        borderThread.join();
+    }
+    instance = nullptr;
+}
+
+void BorderController::Refresh() noexcept {
+    dirty.store(true, std::memory_order_release);
+    if (const DWORD tid = threadId.load(std::memory_order_acquire))
+        PostThreadMessageW(tid, WM_NULL, 0, 0);
+}
+
+// Out of context: runs on the border thread while it pumps messages
+void CALLBACK BorderController::WinEventProc(HWINEVENTHOOK, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD, DWORD) {
+    if (!instance || !hwnd)
+        return;
+    // top-level z-order changes are reported on the desktop, not as OBJID_WINDOW; a foreground
+    // change raises the window above its border
+    if (event == EVENT_OBJECT_REORDER || event == EVENT_SYSTEM_FOREGROUND) {
+        const HWND desktop = GetDesktopWindow();
+        if (event == EVENT_SYSTEM_FOREGROUND || hwnd == desktop || GetAncestor(hwnd, GA_PARENT) == desktop) {
+            instance->restack.store(true, std::memory_order_relaxed);
+            instance->dirty.store(true, std::memory_order_relaxed);
+        }
+        return;
+    }
+    if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF)
+        return;
+    // child windows move all the time (scrolling, layout), only top-levels carry a border
+    if (event == EVENT_OBJECT_LOCATIONCHANGE && GetAncestor(hwnd, GA_PARENT) != GetDesktopWindow())
+        return;
+    instance->dirty.store(true, std::memory_order_relaxed);
+}
+
+void BorderController::Hook() {
+    // own windows (borders, drag overlay) are skipped at the source
+    const auto add = [&](DWORD first, DWORD last) {
+        if (HWINEVENTHOOK h = SetWinEventHook(first, last, nullptr, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS))
+            hooks.push_back(h);
+        else
+            LOG_E("Border WinEvent hook {:#x} failed: {}", first, GetLastError());
+    };
+    HOOK_INSTALL();
+    add(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND);
+    add(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND);
+    add(EVENT_OBJECT_DESTROY, EVENT_OBJECT_REORDER); // destroy, show, hide, reorder
+    add(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE);
+    add(EVENT_OBJECT_CLOAKED, EVENT_OBJECT_UNCLOAKED); // virtual desktop switches
+}
+
+void BorderController::Unhook() {
+    HOOK_REMOVE();
+    for (HWINEVENTHOOK h : hooks)
+        UnhookWinEvent(h);
+    hooks.clear();
+}
+
+void BorderController::Sync(Pool& pool) {
+    const Settings& s = config->m_settings;
+    placements.clear();
+
+    const auto add = [&](HWND h, bool active) {
+        RECT r{};
+        if (utils::dwm::GetWindowVisualRect(h, r))
+            placements.push_back({reinterpret_cast<uint64_t>(h), {r.left, r.top, r.right, r.bottom}, active});
+    };
+
+    const HWND focused = utils::FilteredTopLevel(GetForegroundWindow());
+    if (s.borders == BorderMode::Active && focused) {
+        add(focused, true);
+    } else if (s.borders == BorderMode::All) {
+        const auto each = [&](HWND h) {
+            if (utils::FilteredTopLevel(h) == h)
+                add(h, h == focused);
+        };
+        EnumWindows(
+          [](HWND h, LPARAM lp) -> BOOL {
+              (*reinterpret_cast<decltype(each)*>(lp))(h);
+              return TRUE;
+          },
+          reinterpret_cast<LPARAM>(&each));
+    }
+
+    const utils::pool::ChurnStats before = pool.Stats();
+    pool.Apply(placements, restack.exchange(false, std::memory_order_relaxed));
+    const utils::pool::ChurnStats& after = pool.Stats();
+
+    using utils::render::Count;
+    using utils::render::g_counters;
+    Count(g_counters.borderFrames);
+    Count(g_counters.borderCreates, after.created - before.created);
+    Count(g_counters.borderReuses, after.reused - before.reused);
+    Count(g_counters.borderPlaces, after.placed - before.placed);
+    Count(g_counters.borderRestacks, after.restacked - before.restacked);
+}
+
+void BorderController::BorderLoop(std::stop_token st) {
+    SET_THREAD_NAME("Borders");
+
+    MSG msg;
+    PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE); // message queue exists before the id is published
+    threadId.store(GetCurrentThreadId(), std::memory_order_release);
+    std::stop_callback onStop(st, [this] { PostThreadMessageW(threadId.load(std::memory_order_relaxed), WM_NULL, 0, 0); });
+
+    // destroyed on this thread, the windows belong to it
+    Pool pool([this]() -> std::unique_ptr<Surface> {
+        auto s = std::make_unique<Surface>(hInstance, config);
+        if (!s->Ok())
+            return nullptr;
+        return s;
+    });
+
+    // event bursts (a drag emits a location change per move) collapse into one update per refresh
+    const uint64_t periodNs = 1'000'000'000ull / static_cast<uint64_t>(utils::mon::GetRefreshRate(MonitorFromPoint({0, 0}, MONITOR_DEFAULTTOPRIMARY)));
+    uint64_t nextFrameNs = 0;
+
+    while (!st.stop_requested()) {
+        DWORD timeoutMs = INFINITE;
+        if (dirty.load(std::memory_order_acquire)) {
+            const uint64_t now = input::NowNs();
+            timeoutMs = now >= nextFrameNs ? 0 : static_cast<DWORD>((nextFrameNs - now + 999'999) / 1'000'000);
+        }
+        MsgWaitForMultipleObjectsEx(0, nullptr, timeoutMs, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+
+        if (!dirty.load(std::memory_order_acquire))
+            continue;
+        const uint64_t now = input::NowNs();
+        if (now < nextFrameNs)
+            continue;
+        dirty.store(false, std::memory_order_relaxed);
+        nextFrameNs = now + periodNs;
+
+        // no hooks while borders are off, nothing wakes this thread but Refresh
+        const bool enabled = config->m_settings.borders != BorderMode::Off;
+        if (enabled && hooks.empty())
+            Hook();
+        else if (!enabled && !hooks.empty())
+            Unhook();
+        Sync(pool);
+    }
+
+    Unhook();
+}
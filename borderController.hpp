@@ -0,0 +1,43 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "overlay.hpp"
+#include "settings/config.hpp"
+#include "utils/surface_pool.hpp"
+
+// Persistent borders (BORDERS = ACTIVE | ALL) drawn with pooled, non-topmost overlay windows.
+// WinEvent notifications only mark the border set dirty; the border thread rebuilds it at most
+// once per display frame and hands it to the pool, which recycles windows across focus changes.
+class BorderController {
+  public:
+    BorderController(HINSTANCE hi, Config* cfg);
+    ~BorderController();
+
+    // Settings may have changed (config reload): re-read them on the next frame
+    void Refresh() noexcept;
+
+  private:
+    class Surface;
+    using Pool = utils::pool::SurfacePool<Surface>;
+
+    void BorderLoop(std::stop_token st);
+    void Sync(Pool& pool);
+    void Hook();
+    void Unhook();
+    static void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD thread, DWORD time);
+
+    static inline BorderController* instance = nullptr;
+    HINSTANCE hInstance;
+    Config* config = nullptr;
+
+    std::vector<HWINEVENTHOOK> hooks; // border thread
+    std::vector<utils::pool::Placement> placements; // border thread, rebuilt each frame
+    std::atomic<bool> dirty{true};
+    std::atomic<bool> restack{false}; // z-order changed: restack unchanged borders on the next frame
+    std::atomic<DWORD> threadId{0};
+
+    std::jthread borderThread; // last: stopped before the rest goes away
+};
@@ -0,0 +1,67 @@
+#pragma once
+// inputEvent.hpp
+// Compact POD record carried from the low-level hooks to the input threads.
+// Portable on purpose (no Windows headers) so queues and later stages can be exercised off-target.
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+
+namespace input {
+enum class Kind : uint8_t { Key, Button, Move, Wheel };
+enum class Button : uint8_t { Left, Right, Middle };
+
+enum Flags : uint8_t {
+    Down = 1 << 0,
+    Injected = 1 << 1,  // LLKHF_INJECTED / LLMHF_INJECTED
+    Synthetic = 1 << 2, // produced by HyprWin itself, never seen by a hook
+    Replayed = 1 << 3,  // fed back from an input trace, only replay sessions consume these
+};
+
+// Monotonic capture clock in nanoseconds (QueryPerformanceCounter backed on MSVC)
+inline uint64_t NowNs() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+struct Event {
+    uint64_t captureNs = 0; // NowNs() at hook entry
+    uint32_t time = 0;      // hook struct time (ms, GetTickCount base)
+    int32_t x = 0;          // screen point, 0 for keys
+    int32_t y = 0;
+    uint16_t code = 0; // vk for Key, Button for Button, signed delta for Wheel
+    Kind kind = Kind::Key;
+    uint8_t flags = 0;
+
+    constexpr bool IsDown() const noexcept {
+        return (flags & Down) != 0;
+    }
+    constexpr Button GetButton() const noexcept {
+        return static_cast<Button>(code);
+    }
+    constexpr int16_t WheelDelta() const noexcept {
+        return static_cast<int16_t>(code);
+    }
+};
+static_assert(sizeof(Event) == 24, "input::Event must stay compact");
+static_assert(std::is_trivially_copyable_v<Event> && std::is_standard_layout_v<Event>, "input::Event must be POD");
+
+// Producers. Hooks pass their own timestamps, synthetic sources default to now.
+constexpr Event MakeKey(uint32_t vk, bool down, uint32_t time, uint64_t captureNs, uint8_t extraFlags = 0) noexcept {
+    return Event{captureNs, time, 0, 0, static_cast<uint16_t>(vk), Kind::Key, static_cast<uint8_t>((down ? Down : 0) | extraFlags)};
+}
+
+constexpr Event MakeButton(Button b, bool down, int32_t x, int32_t y, uint32_t time, uint64_t captureNs, uint8_t extraFlags = 0) noexcept {
+    return Event{captureNs, time, x, y, static_cast<uint16_t>(b), Kind::Button, static_cast<uint8_t>((down ? Down : 0) | extraFlags)};
+}
+
+constexpr Event MakeMove(int32_t x, int32_t y, uint32_t time, uint64_t captureNs, uint8_t extraFlags = 0) noexcept {
+    return Event{captureNs, time, x, y, 0, Kind::Move, extraFlags};
+}
+
+constexpr Event MakeWheel(int16_t delta, int32_t x, int32_t y, uint32_t time, uint64_t captureNs, uint8_t extraFlags = 0) noexcept {
+    return Event{captureNs, time, x, y, static_cast<uint16_t>(delta), Kind::Wheel, extraFlags};
+}
+
+inline Event MakeSyntheticButton(Button b, bool down) noexcept {
+    return MakeButton(b, down, 0, 0, 0, NowNs(), Synthetic);
+}
+} // namespace input
@@ -0,0 +1,352 @@
+#pragma once
+// inputQueue.hpp
+// Multi-producer, single-consumer queue for input::Event with two lanes:
+//  - critical (keys, button down/up): bounded MPSC ring, never dropped. When the ring is full
+//    events spill into per-(code, edge) slots and are handed back in push order.
+//  - coalescable (move, wheel): the latest captured move wins, wheel deltas are summed, nothing
+//    overflows. A pending move captured before the next critical event is delivered ahead of it,
+//    so a button release never overtakes the last position of the drag.
+// Portable (no Windows headers).
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "inputEvent.hpp"
+#include "wakeup.hpp"
+
+template <size_t Size>
+class InputQueue {
+    static_assert((Size & (Size - 1)) == 0, "Size must be power of 2");
+    static_assert(Size >= 2, "Size too small");
+
+  public:
+    struct Stats {
+        uint64_t critical = 0;   // events accepted on the critical lane
+        uint64_t overflowed = 0; // critical events that went through the spill slots
+        uint64_t coalesced = 0;  // move/wheel events merged into an undelivered one
+    };
+
+    InputQueue() noexcept {
+        for (size_t i = 0; i < Size; ++i)
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    InputQueue(const InputQueue&) = delete;
+    InputQueue& operator=(const InputQueue&) = delete;
+
+    // Safe from any number of producer threads. Returns false only for events that
+    // cannot be represented (never for keys/buttons).
+    bool push(const input::Event& ev) noexcept {
+        switch (ev.kind) {
+            case input::Kind::Move:
+                PushMove(ev);
+                return true;
+            case input::Kind::Wheel:
+                PushWheel(ev);
+                return true;
+            default:
+                return PushCritical(ev);
+        }
+    }
+
+    // Single consumer. Critical events in order, each preceded by a pending move captured before
+    // it; then the latest move and summed wheel.
+    bool pop(input::Event& out) noexcept {
+        input::Event critical;
+        if (!NextCritical(critical))
+            return PopCoalesced(out);
+        if (MovePendingBefore(critical.captureNs) && PopMove(out)) {
+            held_ = critical;
+            hasHeld_ = true;
+            return true;
+        }
+        out = critical;
+        return true;
+    }
+
+    Stats GetStats() const noexcept {
+        return {critical_.load(std::memory_order_relaxed), overflowed_.load(std::memory_order_relaxed), coalesced_.load(std::memory_order_relaxed)};
+    }
+
+  private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> seq{0};
+        input::Event ev{};
+    };
+
+    // keys: (vk, edge), buttons: (button, edge)
+    static constexpr size_t kKeySlots = 256 * 2;
+    static constexpr size_t kSpillSlots = kKeySlots + 4 * 2;
+
+    struct SpillSlot {
+        std::atomic<bool> lock{false};    // fields below are written and collected as one
+        std::atomic<uint32_t> pending{0}; // pushes folded into this slot since the last collect
+        std::atomic<uint64_t> ticket{0};
+        std::atomic<uint64_t> captureNs{0};
+        std::atomic<uint64_t> xy{0};
+        std::atomic<uint32_t> time{0};
+        std::atomic<uint8_t> flags{0};
+    };
+
+    static constexpr uint64_t PackXY(int32_t x, int32_t y) noexcept {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+    static constexpr int32_t UnpackX(uint64_t xy) noexcept {
+        return static_cast<int32_t>(static_cast<uint32_t>(xy >> 32));
+    }
+    static constexpr int32_t UnpackY(uint64_t xy) noexcept {
+        return static_cast<int32_t>(static_cast<uint32_t>(xy));
+    }
+
+    static void Lock(std::atomic<bool>& l) noexcept {
+        while (l.exchange(true, std::memory_order_acquire))
+            while (l.load(std::memory_order_relaxed))
+                Wakeup::CpuRelax();
+    }
+    static void Unlock(std::atomic<bool>& l) noexcept {
+        l.store(false, std::memory_order_release);
+    }
+
+    static size_t SlotIndex(const input::Event& ev) noexcept {
+        const size_t edge = ev.IsDown() ? 1 : 0;
+        if (ev.kind == input::Kind::Key)
+            return (ev.code & 0xFF) * 2 + edge;
+        return kKeySlots + (ev.code & 3) * 2 + edge;
+    }
+
+    bool NextCritical(input::Event& out) noexcept {
+        if (hasHeld_) {
+            hasHeld_ = false;
+            out = held_;
+            return true;
+        }
+        if (spillIdx_ < spillLen_) {
+            out = spillBuf_[spillIdx_++];
+            return true;
+        }
+        if (PopRing(out))
+            return true;
+        if (spillCount_.load(std::memory_order_acquire) > 0 && CollectSpill()) {
+            out = spillBuf_[spillIdx_++];
+            return true;
+        }
+        return false;
+    }
+
+    bool PushCritical(const input::Event& ev) noexcept {
+        critical_.fetch_add(1, std::memory_order_relaxed);
+        // keep per-producer order: once anything spilled, follow it until the consumer caught up
+        if (spillCount_.load(std::memory_order_acquire) == 0 && PushRing(ev))
+            return true;
+        Spill(ev);
+        return true;
+    }
+
+    bool PushRing(const input::Event& ev) noexcept {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & (Size - 1)];
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            } else if (dif < 0) {
+                return false; // full
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->ev = ev;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool PopRing(input::Event& out) noexcept {
+        Cell& cell = cells_[dequeuePos_ & (Size - 1)];
+        const size_t seq = cell.seq.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(dequeuePos_ + 1) < 0)
+            return false; // empty
+        out = cell.ev;
+        cell.seq.store(dequeuePos_ + Size, std::memory_order_release);
+        ++dequeuePos_;
+        return true;
+    }
+
+    void Spill(const input::Event& ev) noexcept {
+        overflowed_.fetch_add(1, std::memory_order_relaxed);
+        spillCount_.fetch_add(1, std::memory_order_acq_rel);
+
+        SpillSlot& s = spill_[SlotIndex(ev)];
+        Lock(s.lock);
+        s.ticket.store(tickets_.fetch_add(1, std::memory_order_acq_rel), std::memory_order_relaxed);
+        s.captureNs.store(ev.captureNs, std::memory_order_relaxed);
+        s.xy.store(PackXY(ev.x, ev.y), std::memory_order_relaxed);
+        s.time.store(ev.time, std::memory_order_relaxed);
+        s.flags.store(ev.flags, std::memory_order_relaxed);
+        s.pending.fetch_add(1, std::memory_order_relaxed);
+        Unlock(s.lock);
+    }
+
+    // Same-slot pushes collapse into one event (same key/button and edge), which preserves state
+    bool CollectSpill() noexcept {
+        struct Pending {
+            uint64_t ticket;
+            input::Event ev;
+        };
+        Pending tmp[kSpillSlots];
+        size_t n = 0;
+        uint32_t folded = 0;
+        // Only pushes ticketed before the scan: the scan may pass a slot just before a producer
+        // fills it and then find that producer's next push further on. Anything ticketed earlier
+        // was completely written before its producer's next ticket, so it is visible here.
+        const uint64_t cutoff = tickets_.load(std::memory_order_acquire);
+
+        for (size_t i = 0; i < kSpillSlots; ++i) {
+            SpillSlot& s = spill_[i];
+            if (s.pending.load(std::memory_order_relaxed) == 0)
+                continue;
+            // a producer mid-write would otherwise hand us its new fields now and again next time
+            Lock(s.lock);
+            if (s.ticket.load(std::memory_order_relaxed) >= cutoff) {
+                Unlock(s.lock); // next collect
+                continue;
+            }
+            const uint32_t hits = s.pending.exchange(0, std::memory_order_relaxed);
+            if (!hits) {
+                Unlock(s.lock);
+                continue;
+            }
+            folded += hits;
+
+            input::Event ev{};
+            ev.kind = (i < kKeySlots) ? input::Kind::Key : input::Kind::Button;
+            ev.code = static_cast<uint16_t>(((i < kKeySlots) ? i : i - kKeySlots) / 2);
+            ev.captureNs = s.captureNs.load(std::memory_order_relaxed);
+            const uint64_t xy = s.xy.load(std::memory_order_relaxed);
+            ev.x = UnpackX(xy);
+            ev.y = UnpackY(xy);
+            ev.time = s.time.load(std::memory_order_relaxed);
+            ev.flags = static_cast<uint8_t>((s.flags.load(std::memory_order_relaxed) & ~input::Down) | ((i & 1) ? input::Down : 0));
+            tmp[n++] = {s.ticket.load(std::memory_order_relaxed), ev};
+            Unlock(s.lock);
+        }
+        spillCount_.fetch_sub(folded, std::memory_order_acq_rel);
+
+        std::sort(tmp, tmp + n, [](const Pending& a, const Pending& b) { return a.ticket < b.ticket; });
+        for (size_t i = 0; i < n; ++i)
+            spillBuf_[i] = tmp[i].ev;
+        spillIdx_ = 0;
+        spillLen_ = n;
+        return n != 0;
+    }
+
+    void PushMove(const input::Event& ev) noexcept {
+        // producers serialize on the slot for a handful of stores; the later capture wins, not the
+        // producer that happens to get the lock last
+        Lock(moveLock_);
+        if (ev.captureNs < moveNs_.load(std::memory_order_relaxed)) {
+            Unlock(moveLock_);
+            coalesced_.fetch_add(1, std::memory_order_relaxed); // an older sample lost the race
+            return;
+        }
+        const uint32_t s = moveSeq_.load(std::memory_order_relaxed);
+        // release on the fields: a reader that observes any of them also observes the odd sequence
+        moveSeq_.store(s + 1, std::memory_order_relaxed);
+        moveNs_.store(ev.captureNs, std::memory_order_release);
+        moveXY_.store(PackXY(ev.x, ev.y), std::memory_order_release);
+        moveTime_.store(ev.time, std::memory_order_release);
+        moveFlags_.store(ev.flags, std::memory_order_release);
+        moveSeq_.store(s + 2, std::memory_order_release);
+        const bool merged = movePending_.exchange(true, std::memory_order_release);
+        Unlock(moveLock_);
+
+        if (merged)
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void PushWheel(const input::Event& ev) noexcept {
+        wheelDelta_.fetch_add(ev.WheelDelta(), std::memory_order_relaxed);
+        wheelNs_.store(ev.captureNs, std::memory_order_relaxed);
+        wheelXY_.store(PackXY(ev.x, ev.y), std::memory_order_relaxed);
+        if (wheelPending_.exchange(true, std::memory_order_release))
+            coalesced_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool MovePendingBefore(uint64_t captureNs) const noexcept {
+        return movePending_.load(std::memory_order_acquire) && moveNs_.load(std::memory_order_acquire) < captureNs;
+    }
+
+    bool PopMove(input::Event& out) noexcept {
+        if (!movePending_.load(std::memory_order_relaxed) || !movePending_.exchange(false, std::memory_order_acquire))
+            return false;
+        uint32_t s1, s2;
+        uint64_t ns, xy;
+        uint32_t time;
+        uint8_t flags;
+        do {
+            s1 = moveSeq_.load(std::memory_order_acquire);
+            ns = moveNs_.load(std::memory_order_acquire);
+            xy = moveXY_.load(std::memory_order_acquire);
+            time = moveTime_.load(std::memory_order_acquire);
+            flags = moveFlags_.load(std::memory_order_acquire);
+            s2 = moveSeq_.load(std::memory_order_relaxed);
+        } while ((s1 & 1) || s1 != s2);
+        // a producer may publish between our exchange and the read; that sample was taken now
+        // and its raised flag must not deliver it a second time
+        if (s1 == moveTaken_)
+            return false;
+        moveTaken_ = s1;
+        out = input::MakeMove(UnpackX(xy), UnpackY(xy), time, ns, flags);
+        return true;
+    }
+
+    bool PopCoalesced(input::Event& out) noexcept {
+        if (PopMove(out))
+            return true;
+        if (wheelPending_.load(std::memory_order_relaxed) && wheelPending_.exchange(false, std::memory_order_acquire)) {
+            const int32_t delta = wheelDelta_.exchange(0, std::memory_order_relaxed);
+            const uint64_t xy = wheelXY_.load(std::memory_order_relaxed);
+            const int16_t clamped = static_cast<int16_t>(std::clamp<int32_t>(delta, INT16_MIN, INT16_MAX));
+            out = input::MakeWheel(clamped, UnpackX(xy), UnpackY(xy), 0, wheelNs_.load(std::memory_order_relaxed));
+            return true;
+        }
+        return false;
+    }
+
+    // critical lane
+    Cell cells_[Size];
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0;
+
+    // spill (consumer side buffer is only touched by the consumer)
+    alignas(64) std::atomic<uint32_t> spillCount_{0};
+    std::atomic<uint64_t> tickets_{0};
+    SpillSlot spill_[kSpillSlots];
+    input::Event spillBuf_[kSpillSlots]{};
+    size_t spillIdx_ = 0;
+    size_t spillLen_ = 0;
+    input::Event held_{}; // critical event waiting behind an earlier move
+    uint32_t moveTaken_ = 0; // moveSeq_ of the last move handed out
+    bool hasHeld_ = false;
+
+    // coalescable lane
+    alignas(64) std::atomic<bool> moveLock_{false};
+    std::atomic<bool> movePending_{false};
+    std::atomic<uint32_t> moveSeq_{0};
+    std::atomic<uint64_t> moveNs_{0};
+    std::atomic<uint64_t> moveXY_{0};
+    std::atomic<uint32_t> moveTime_{0};
+    std::atomic<uint8_t> moveFlags_{0};
+
+    std::atomic<bool> wheelPending_{false};
+    std::atomic<int32_t> wheelDelta_{0};
+    std::atomic<uint64_t> wheelNs_{0};
+    std::atomic<uint64_t> wheelXY_{0};
+
+    alignas(64) std::atomic<uint64_t> critical_{0};
+    std::atomic<uint64_t> overflowed_{0};
+    std::atomic<uint64_t> coalesced_{0};
+};
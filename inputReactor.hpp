@@ -0,0 +1,76 @@
+#pragma once
+// inputReactor.hpp
+// One consumer for both hooks: keyboard and mouse events share a single InputQueue and Wakeup,
+// so SUPER/modifier state and mouse gestures are handled in order on one thread.
+// Portable (no Windows headers); the handler decides what an event does.
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stop_token>
+
+#include "inputEvent.hpp"
+#include "inputQueue.hpp"
+#include "utils/latency.hpp"
+#include "wakeup.hpp"
+
+template <size_t Size>
+class InputReactor {
+  public:
+    struct Stats {
+        uint64_t events = 0; // events handed to the handler
+        uint64_t rounds = 0; // wakeups that found work (one per context switch into the reactor)
+        typename InputQueue<Size>::Stats queue{};
+        Wakeup::Stats wake{};
+    };
+
+    InputReactor() noexcept = default;
+    // recordStages: queue latency goes to the global key/mouse.queue stages (off for replay sessions)
+    explicit InputReactor(bool recordStages) noexcept : recordStages(recordStages) {}
+
+    // Any producer thread. Moves and wheel coalesce silently, everything else wakes the reactor.
+    void Post(const input::Event& ev) noexcept {
+        queue.push(ev);
+        if (ev.kind == input::Kind::Key || ev.kind == input::Kind::Button)
+            wake.Notify();
+    }
+
+    // Consumer loop, returns once st is stopped
+    template <typename Handler>
+    void Run(std::stop_token st, Handler&& handle) {
+        std::stop_callback onStop(st, [this] { wake.Notify(); });
+        while (!st.stop_requested()) {
+            const uint32_t seen = wake.Epoch();
+
+            input::Event ev;
+            bool any = false;
+            while (queue.pop(ev)) {
+                if (recordStages) {
+                    const bool key = ev.kind == input::Kind::Key;
+                    utils::latency::Record(key ? utils::latency::Stage::KeyQueue : utils::latency::Stage::MouseQueue, input::NowNs() - ev.captureNs);
+                }
+                handle(ev);
+                events.fetch_add(1, std::memory_order_relaxed);
+                any = true;
+            }
+            if (any)
+                rounds.fetch_add(1, std::memory_order_relaxed);
+
+            wake.Wait(seen);
+        }
+    }
+
+    Stats GetStats() const noexcept {
+        return {events.load(std::memory_order_relaxed), rounds.load(std::memory_order_relaxed), queue.GetStats(), wake.GetStats()};
+    }
+
+  private:
+    InputQueue<Size> queue;
+    Wakeup wake;
+    bool recordStages = true;
+    alignas(64) std::atomic<uint64_t> events{0};
+    std::atomic<uint64_t> rounds{0};
+};
+
+namespace input {
+using Reactor = InputReactor<128>;
+}
@@ -0,0 +1,118 @@
+#pragma once
+// inputReplay.hpp
+// Replays an input trace through the decode half of the input pipeline, isolated from the live
+// one: each Session has its own reactor, consumer thread and KeyDecoder, and hit-tests clicks
+// through a caller-supplied HitTest instead of the drag overlay. Nothing is dispatched and no
+// window moves, so a trace that ends with SUPER held or a button down leaves the live managers
+// untouched. Latency goes to the session's own histograms, not the global stages.
+// Portable (no Windows headers): the app passes a hit-test over the real windows, tests and the
+// standalone driver (tests/trace_replay.cpp) pass one over a synthetic window registry.
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "inputEvent.hpp"
+#include "inputReactor.hpp"
+#include "inputTrace.hpp"
+#include "keyDecoder.hpp"
+#include "settings/key_trie.hpp"
+#include "utils/latency.hpp"
+
+namespace input::replay {
+struct Bindings {
+    const KeyTrie* trie = nullptr; // nullptr: key state only, no lookups
+    uint32_t superVk = 0x5B;       // VK_LWIN
+    uint64_t sequenceTimeoutNs = 1'000'000'000;
+};
+
+// Window under a screen point, 0 for none
+using HitTest = std::function<uint64_t(int32_t x, int32_t y)>;
+
+struct Stats {
+    trace::ReplayStats feed{};
+    uint64_t handled = 0; // events out of the session queue (moves coalesce)
+    uint64_t keys = 0;    // bindable key downs looked up
+    uint64_t actions = 0; // lookups that completed a bind
+    uint64_t submaps = 0;
+    uint64_t clicks = 0;  // button downs hit-tested
+    uint64_t targets = 0; // ... that found a window
+    bool superHeldAtEnd = false; // the trace stopped mid-gesture (seen by this session only)
+    utils::latency::Histogram::Snapshot keyLatency{};   // capture -> bind looked up
+    utils::latency::Histogram::Snapshot clickLatency{}; // capture -> target found
+};
+
+class Session {
+  public:
+    Session(Bindings b, HitTest hit) : bindings(b), hitTest(std::move(hit)) {}
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+
+    // Blocking; any thread. Every call starts from released keys.
+    Stats Run(const std::vector<Event>& events, bool realTime) {
+        stats = {};
+        decoder = {};
+        keyTimes.Reset();
+        clickTimes.Reset();
+        done.store(false, std::memory_order_relaxed);
+
+        InputReactor<128> reactor(false);
+        std::jthread consumer([&](std::stop_token st) { reactor.Run(st, [this](const Event& ev) { Handle(ev); }); });
+
+        stats.feed = trace::Replay(events, [&](const Event& ev) { reactor.Post(ev); }, realTime);
+        // critical events are delivered in order, earlier moves ahead of them: once the marker is
+        // handled, so is everything fed before it
+        reactor.Post(MakeKey(kEndMarker, true, 0, NowNs(), Synthetic | Replayed));
+        done.wait(false, std::memory_order_acquire);
+        consumer.request_stop();
+        consumer.join();
+
+        stats.superHeldAtEnd = decoder.IsKeySet(bindings.superVk);
+        stats.keyLatency = keyTimes.Snap();
+        stats.clickLatency = clickTimes.Snap();
+        return stats;
+    }
+
+  private:
+    static constexpr uint16_t kEndMarker = 0; // no key has VK 0
+
+    void Handle(const Event& ev) {
+        if (ev.kind == Kind::Key && ev.code == kEndMarker && (ev.flags & Synthetic)) {
+            done.store(true, std::memory_order_release);
+            done.notify_one();
+            return;
+        }
+        ++stats.handled;
+
+        if (ev.kind == Kind::Key) {
+            if (decoder.Track(ev, bindings.superVk) != KeyDecoder::Edge::Key || !bindings.trie)
+                return;
+            const KeySequencer::Step step = decoder.Lookup(*bindings.trie, ev, bindings.sequenceTimeoutNs);
+            ++stats.keys;
+            if (step.result == KeySequencer::Result::Action)
+                ++stats.actions;
+            else if (step.result == KeySequencer::Result::Submap)
+                ++stats.submaps;
+            keyTimes.Record(NowNs() - ev.captureNs);
+            return;
+        }
+
+        if (ev.kind == Kind::Button && ev.IsDown() && hitTest) {
+            ++stats.clicks;
+            if (hitTest(ev.x, ev.y))
+                ++stats.targets;
+            clickTimes.Record(NowNs() - ev.captureNs);
+        }
+    }
+
+    Bindings bindings;
+    HitTest hitTest;
+    KeyDecoder decoder; // consumer thread while running
+    Stats stats{};
+    utils::latency::Histogram keyTimes;
+    utils::latency::Histogram clickTimes;
+    std::atomic<bool> done{false};
+};
+} // namespace input::replay
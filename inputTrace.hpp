@@ -0,0 +1,187 @@
+#pragma once
+// inputTrace.hpp
+// Binary input trace: the raw input::Event stream the hooks hand to the input threads,
+// plus a replay driver that feeds a trace back through an input queue.
+// File: TraceHeader followed by packed 24-byte input::Event records.
+// Portable (no Windows headers) so traces can be read and replayed off-target.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "inputEvent.hpp"
+#include "lockfreequeue.hpp"
+
+namespace input::trace {
+struct TraceHeader {
+    char magic[4] = {'H', 'W', 'T', 'R'};
+    uint16_t version = 1;
+    uint16_t recordSize = sizeof(Event);
+    uint64_t startNs = 0; // NowNs() when recording started
+};
+static_assert(sizeof(TraceHeader) == 16, "trace header layout is part of the file format");
+
+// One single-producer lane per hook thread
+enum class Source : uint8_t { Keyboard, Mouse, Count };
+
+// Hooks call Record(); when not recording that is one relaxed load.
+// A writer thread drains both lanes every few ms, orders the batch by capture time and appends it.
+class Recorder {
+  public:
+    struct Stats {
+        uint64_t recorded = 0;
+        uint64_t dropped = 0; // lane full, writer fell behind
+    };
+
+    ~Recorder() {
+        Stop();
+    }
+
+    bool Start(const std::string& path) {
+        Stop();
+        out.open(path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+            return false;
+
+        TraceHeader hdr{};
+        hdr.startNs = NowNs();
+        out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+
+        Event stale;
+        for (auto& lane : lanes) {
+            while (lane.pop(stale)) {} // pushed after the previous Stop() drained
+        }
+        recorded.store(0, std::memory_order_relaxed);
+        dropped.store(0, std::memory_order_relaxed);
+        writer = std::jthread([this](std::stop_token st) { WriterLoop(st); });
+        enabled.store(true, std::memory_order_release);
+        return true;
+    }
+
+    void Stop() {
+        enabled.store(false, std::memory_order_release);
+        if (writer.joinable()) {
+            writer.request_stop();
+            writer.join();
+        }
+        if (out.is_open())
+            out.close();
+    }
+
+    bool IsRecording() const noexcept {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    // Producer side, one thread per Source
+    void Record(Source src, const Event& ev) noexcept {
+        if (!enabled.load(std::memory_order_relaxed))
+            return;
+        if (lanes[static_cast<size_t>(src)].push(ev))
+            recorded.fetch_add(1, std::memory_order_relaxed);
+        else
+            dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Stats GetStats() const noexcept {
+        return {recorded.load(std::memory_order_relaxed), dropped.load(std::memory_order_relaxed)};
+    }
+
+  private:
+    void WriterLoop(std::stop_token st) {
+        std::vector<Event> batch;
+        batch.reserve(kLaneSize * static_cast<size_t>(Source::Count));
+        for (;;) {
+            const bool last = st.stop_requested(); // drain once more after stop
+            Event ev;
+            for (auto& lane : lanes) {
+                while (lane.pop(ev))
+                    batch.push_back(ev);
+            }
+            if (!batch.empty()) {
+                std::stable_sort(batch.begin(), batch.end(), [](const Event& a, const Event& b) { return a.captureNs < b.captureNs; });
+                out.write(reinterpret_cast<const char*>(batch.data()), static_cast<std::streamsize>(batch.size() * sizeof(Event)));
+                batch.clear();
+            }
+            if (last)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        out.flush();
+    }
+
+    static constexpr size_t kLaneSize = 4096;
+
+    std::atomic<bool> enabled{false};
+    LockFreeQueue<Event, kLaneSize> lanes[static_cast<size_t>(Source::Count)];
+    std::atomic<uint64_t> recorded{0};
+    std::atomic<uint64_t> dropped{0};
+    std::ofstream out;
+    std::jthread writer;
+};
+
+inline Recorder g_recorder;
+
+inline bool Load(const std::string& path, std::vector<Event>& events, std::string& error) {
+    events.clear();
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    TraceHeader hdr{};
+    const TraceHeader expected{};
+    in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr));
+    if (!in || !std::equal(std::begin(hdr.magic), std::end(hdr.magic), std::begin(expected.magic))) {
+        error = "not an input trace";
+        return false;
+    }
+    if (hdr.version != expected.version || hdr.recordSize != sizeof(Event)) {
+        error = "unsupported trace version";
+        return false;
+    }
+
+    Event ev;
+    while (in.read(reinterpret_cast<char*>(&ev), sizeof(ev)))
+        events.push_back(ev);
+    return true;
+}
+
+struct ReplayStats {
+    uint64_t events = 0;
+    uint64_t elapsedNs = 0;
+
+    double EventsPerSec() const noexcept {
+        return elapsedNs ? events * 1e9 / elapsedNs : 0.0;
+    }
+};
+
+// Feeds every event to sink(const Event&) with captureNs restamped to now and the Replayed
+// flag set, so consumers measure their own latency. Live managers drop Replayed events; feed a
+// replay::Session (inputReplay.hpp) instead of the live reactor.
+// realTime keeps the recorded spacing, otherwise events are pushed back to back.
+template <typename Sink>
+ReplayStats Replay(const std::vector<Event>& events, Sink&& sink, bool realTime) {
+    ReplayStats stats{};
+    if (events.empty())
+        return stats;
+
+    const auto start = std::chrono::steady_clock::now();
+    const uint64_t startNs = NowNs();
+    const uint64_t firstNs = events.front().captureNs;
+    for (Event ev : events) {
+        if (realTime && ev.captureNs > firstNs)
+            std::this_thread::sleep_until(start + std::chrono::nanoseconds(ev.captureNs - firstNs));
+        ev.captureNs = NowNs();
+        ev.flags |= Replayed;
+        sink(ev);
+        ++stats.events;
+    }
+    stats.elapsedNs = NowNs() - startNs;
+    return stats;
+}
+} // namespace input::trace
@@ -0,0 +1,86 @@
+#pragma once
+// keyDecoder.hpp
+// Key state of one keyboard consumer: held keys, the modifier mask and the bind sequencer, fed one
+// input::Event at a time. KeyboardManager owns one and adds the side effects (arming the mouse
+// hook, dispatching actions); trace replay runs its own instance, so nothing it decodes reaches
+// the live state.
+// Portable (no Windows headers): VK codes are plain integers.
+#include <cstdint>
+
+#include "inputEvent.hpp"
+#include "settings/key_trie.hpp"
+
+class KeyDecoder {
+  public:
+    enum class Edge : uint8_t {
+        Repeat,   // auto-repeat of a held key
+        SuperDown,
+        SuperUp,  // state already cleared
+        Released, // any other key up
+        Modifier, // shift/ctrl/alt down, only changes the mask
+        Key,      // bindable key down: Lookup() it
+    };
+
+    // Key state only; cheap enough to run before the caller decides anything
+    Edge Track(const input::Event& ev, uint32_t superVk) noexcept {
+        const uint32_t vk = ev.code & 0xFF;
+        if (!ev.IsDown()) {
+            ClearKey(vk);
+            if (vk != superVk)
+                return Edge::Released;
+            ClearAll();
+            sequencer.Reset();
+            return Edge::SuperUp;
+        }
+        if (IsKeySet(vk))
+            return Edge::Repeat;
+        SetKey(vk);
+        if (vk == superVk)
+            return Edge::SuperDown;
+        return IsModifier(vk) ? Edge::Modifier : Edge::Key;
+    }
+
+    // Bind lookup for an Edge::Key, with the modifiers held right now
+    KeySequencer::Step Lookup(const KeyTrie& trie, const input::Event& ev, uint64_t timeoutNs) noexcept {
+        return sequencer.Feed(trie, KeyTrie::KeyCode(ev.code, Mods()), ev.captureNs, timeoutNs);
+    }
+
+    // Same bits as ModMask: LSHIFT, RSHIFT, LCTRL, RCTRL, LALT, RALT
+    uint8_t Mods() const noexcept {
+        uint8_t m = 0;
+        for (uint8_t i = 0; i < 6; ++i)
+            if (IsKeySet(kModifierVks[i]))
+                m |= static_cast<uint8_t>(1u << i);
+        return m;
+    }
+
+    bool IsKeySet(uint32_t vk) const noexcept {
+        return (keyBits[(vk & 0xFF) >> 6] >> (vk & 63)) & 1;
+    }
+    void SetKey(uint32_t vk) noexcept {
+        keyBits[(vk & 0xFF) >> 6] |= 1ull << (vk & 63);
+    }
+    void ClearKey(uint32_t vk) noexcept {
+        keyBits[(vk & 0xFF) >> 6] &= ~(1ull << (vk & 63));
+    }
+    void ClearAll() noexcept {
+        for (uint64_t& bits : keyBits)
+            bits = 0;
+    }
+
+    const KeySequencer& Sequencer() const noexcept {
+        return sequencer;
+    }
+
+    // VK_LSHIFT, VK_RSHIFT, VK_LCONTROL, VK_RCONTROL, VK_LMENU, VK_RMENU: mask bit order
+    static constexpr uint32_t kModifierVks[6] = {0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5};
+
+    // VK_SHIFT/CONTROL/MENU and their sides never start a bind on their own
+    static constexpr bool IsModifier(uint32_t vk) noexcept {
+        return (vk >= 0x10 && vk <= 0x12) || (vk >= 0xA0 && vk <= 0xA5);
+    }
+
+  private:
+    uint64_t keyBits[4]{};
+    KeySequencer sequencer;
+};
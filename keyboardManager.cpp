@@ -1,70 +1,55 @@
 #include "pch.hpp"
 
+#include <condition_variable>
+#include <mutex>
 #include <stop_token>
 #include <thread>
 #include <utility>
 
 #include "keyboardManager.hpp"
+#include "inputTrace.hpp"
 #include "utils/utils.hpp"
+#include "utils/latency.hpp"
+#include "utils/watchdog.hpp"
 
 #include "settings/config.hpp"
 #include "settings/action_registry.hpp"
 
-// Encode key state into VK code
-static bool g_superDown = false;
-constexpr UINT KEY_DOWN_FLAG = 0x8000u;
+using utils::latency::Stage;
 
-static __forceinline constexpr UINT EncodeKey(UINT vkCode, WPARAM wParam) noexcept {
-    return (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN) ? (vkCode | KEY_DOWN_FLAG) : vkCode;
-}
-static inline constexpr UINT DecodeKey(UINT encodedKey) noexcept {
-    return encodedKey & ~KEY_DOWN_FLAG;
-}
-static inline constexpr bool IsKeyDown(UINT encodedKey) noexcept {
-    return (encodedKey & KEY_DOWN_FLAG) != 0;
-}
+static std::atomic<bool> g_superDown{false}; // hook thread writes, watchdog probes
 
 namespace km {
-KeyboardManager::KeyboardManager(Config* cfg) : config(cfg) {
+KeyboardManager::KeyboardManager(Config* cfg, input::Reactor* r) : config(cfg), reactor(r) {
     instance = this;
 
-    inputThread = std::jthread([this](std::stop_token st) {
-        utils::BoostThread();
-        (void)CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
-        InputLoop(st);
-        CoUninitialize();
-    });
-
     hookThread = std::jthread([this](std::stop_token st) {
         utils::BoostThread();
         HookLoop(st);
     });
+
+    watchdogThread = std::jthread([this](std::stop_token st) { WatchdogLoop(st); });
 }
 
 KeyboardManager::~KeyboardManager() {
-    inputThread.request_stop();
     hookThread.request_stop();
+    watchdogThread.request_stop();
 
     PostThreadMessage(hookThreadId, WM_NULL, 0, 0);
-    cv.notify_one();
     dispatcher::IPCMessage({0xBEEF00FF, L"PCSTATUS_REFRESH_MSG", L"D2DOverlayStatusWnd"});
 
-    cv.notify_all();
-    hookCv.notify_all();
-
-    if (inputThread.joinable())
-        inputThread.join();
     if (hookThread.joinable())
         hookThread.join();
+    if (watchdogThread.joinable())
+        watchdogThread.join();
 }
 
 void KeyboardManager::SeedModifierStates() noexcept {
-    static constexpr UINT modifiers[] = {VK_LSHIFT, VK_RSHIFT, VK_LCONTROL, VK_RCONTROL, VK_LMENU, VK_RMENU};
-    for (UINT vk : modifiers) {
-        if (GetAsyncKeyState(vk) & 0x8000)
-            SetKey(vk);
+    for (uint32_t vk : KeyDecoder::kModifierVks) {
+        if (GetAsyncKeyState(static_cast<int>(vk)) & 0x8000)
+            decoder.SetKey(vk);
         else
-            ClearKey(vk);
+            decoder.ClearKey(vk);
     }
 }
 
@@ -80,16 +65,21 @@ LRESULT CALLBACK KeyboardManager::HookProc(int code, WPARAM wParam, LPARAM lPara
     if (code != HC_ACTION || !instance || !lParam)
         return CallNextHookEx(nullptr, code, wParam, lParam);
 
+    const uint64_t captureNs = input::NowNs();
+    utils::watchdog::HookScope scope(instance->hookStats, captureNs, instance->watchdog.GetLimits().budgetNs);
     const KBDLLHOOKSTRUCT* kb = (const KBDLLHOOKSTRUCT*)lParam;
     const UINT vk = kb->vkCode;
+    const bool down = (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN);
     const UINT superVk = instance->config->m_settings.SUPER;
     if ((kb->flags & (LLKHF_INJECTED | LLKHF_LOWER_IL_INJECTED)) != 0)
         return CallNextHookEx(nullptr, code, wParam, lParam);
 
     if (vk != superVk) {
-        if (g_superDown) {
-            instance->keyQueue.push(EncodeKey(vk, wParam));
-            instance->cv.notify_one();
+        if (g_superDown.load(std::memory_order_relaxed)) {
+            const input::Event ev = input::MakeKey(vk, down, kb->time, captureNs);
+            instance->reactor->Post(ev);
+            input::trace::g_recorder.Record(input::trace::Source::Keyboard, ev);
+            utils::latency::Record(Stage::KeyHook, input::NowNs() - captureNs);
             switch (vk) {
                 case VK_LSHIFT:
                 case VK_RSHIFT:
@@ -105,93 +95,61 @@ LRESULT CALLBACK KeyboardManager::HookProc(int code, WPARAM wParam, LPARAM lPara
         return CallNextHookEx(nullptr, code, wParam, lParam);
     }
 
-    const bool down = (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN);
-    g_superDown = down;
-    instance->keyQueue.push(EncodeKey(vk, wParam));
-    instance->cv.notify_one();
+    g_superDown.store(down, std::memory_order_relaxed);
+    const input::Event ev = input::MakeKey(vk, down, kb->time, captureNs);
+    instance->reactor->Post(ev);
+    input::trace::g_recorder.Record(input::trace::Source::Keyboard, ev);
+    utils::latency::Record(Stage::KeyHook, input::NowNs() - captureNs);
     return 1;
 }
 
-void KeyboardManager::InputLoop(std::stop_token st) {
-    SET_THREAD_NAME("KB INPUT");
-    while (!st.stop_requested()) {
-        std::unique_lock lock(cvMutex);
-        cv.wait(lock, [&] { return st.stop_requested() || !keyQueue.empty(); });
-
-        if (st.stop_requested())
-            continue;
-
-        while (!keyQueue.empty()) {
-            UINT vk;
-            if (keyQueue.pop(vk)) {
-                ProcessKey(vk);
-            }
-        }
-    }
-}
-
-void KeyboardManager::ProcessKey(UINT vk) {
-    UINT decodedVK = DecodeKey(vk);
-
-    if (IsKeyDown(vk)) {
-        if (IsKeySet(decodedVK))
-            return;
+void KeyboardManager::ProcessKey(const input::Event& ev) {
+    // trace replay decodes on its own KeyDecoder (inputReplay.hpp), never on the live one
+    if (ev.flags & input::Replayed)
+        return;
 
-        if (decodedVK == config->m_settings.SUPER) {
+    const uint64_t decodeStart = input::NowNs();
+    switch (decoder.Track(ev, config->m_settings.SUPER)) {
+        case KeyDecoder::Edge::SuperDown:
             SeedModifierStates();
             if (superPressedCallback)
                 superPressedCallback();
-        }
-
-        SetKey(decodedVK);
-    } else {
-        ClearKey(decodedVK);
-        if (decodedVK == config->m_settings.SUPER && superReleasedCallback) {
-            superReleasedCallback();
-            ClearAllKeys();
+            return;
+        case KeyDecoder::Edge::SuperUp:
+            if (superReleasedCallback)
+                superReleasedCallback();
             dispatcher::IPCMessage({0xBEEF00FF, L"PCSTATUS_REFRESH_MSG", L"D2DOverlayStatusWnd"});
-        }
-        return;
-    }
-
-    switch (decodedVK) {
-        case VK_SHIFT:
-        case VK_LSHIFT:
-        case VK_RSHIFT:
-        case VK_CONTROL:
-        case VK_LCONTROL:
-        case VK_RCONTROL:
-        case VK_MENU:
-        case VK_LMENU:
-        case VK_RMENU:
+            return;
+        case KeyDecoder::Edge::Key:
+            break;
+        default:
             return;
     }
 
-    LOG_E("Key event: {} {}", decodedVK, IsKeyDown(vk) ? "DOWN" : "UP");
-
-    uint8_t modMask = 0;
-    if (IsKeySet(VK_LSHIFT))
-        modMask |= ModMask::LSHIFT;
-    if (IsKeySet(VK_RSHIFT))
-        modMask |= ModMask::RSHIFT;
-    if (IsKeySet(VK_LCONTROL))
-        modMask |= ModMask::LCTRL;
-    if (IsKeySet(VK_RCONTROL))
-        modMask |= ModMask::RCTRL;
-    if (IsKeySet(VK_LMENU))
-        modMask |= ModMask::LALT;
-    if (IsKeySet(VK_RMENU))
-        modMask |= ModMask::RALT;
-
-    KeyEvent key{decodedVK, modMask};
-
-    auto it = config->m_keybinds.find(key);
-    if (it == config->m_keybinds.end())
+    LOG_E("Key event: {} {}", ev.code, ev.IsDown() ? "DOWN" : "UP");
+
+    const uint64_t lookupStart = input::NowNs();
+    utils::latency::Record(Stage::KeyDecode, lookupStart - decodeStart);
+
+    const uint64_t timeoutNs = static_cast<uint64_t>(config->m_settings.sequenceTimeoutMs) * 1'000'000;
+    const KeySequencer::Step step = decoder.Lookup(config->m_bindTable.Trie(), ev, timeoutNs);
+    const uint64_t actionStart = input::NowNs();
+    utils::latency::Record(Stage::KeyLookup, actionStart - lookupStart);
+
+    if (step.result == KeySequencer::Result::Submap) {
+        LOG_I("Submap: {}", step.index ? config->m_submaps[step.index] : "reset");
         return;
+    }
+    if (step.result != KeySequencer::Result::Action)
+        return;
+
+    const Actions4& actions = config->m_bindTable.ActionsAt(step.index);
+    for (uint8_t i = 0; i < actions.count; ++i)
+        DispatchAction(actions.items[i], &config->m_settings);
 
-    const auto& vec = it->second;
-    for (uint8_t i = 0; i < vec.count; ++i)
-        DispatchAction(vec.items[i], &config->m_settings);
+    const uint64_t done = input::NowNs();
+    utils::latency::Record(Stage::KeyAction, done - actionStart);
+    utils::latency::Record(Stage::KeyTotal, done - ev.captureNs);
 }
 
 void KeyboardManager::HookLoop(std::stop_token st) {
@@ -199,15 +157,54 @@ void KeyboardManager::HookLoop(std::stop_token st) {
     SET_THREAD_NAME("KB HOOK");
 
     hookHandle = SetWindowsHookExW(WH_KEYBOARD_LL, HookProc, nullptr, 0);
+    // the decoder belongs to the reactor: it starts empty and SUPER down reseeds the modifiers
     if (hookHandle) {
-        ClearAllKeys();
-
         MSG msg;
-        while (!st.stop_requested() && GetMessageW(&msg, nullptr, 0, 0) > 0) {}
-        // no Translate/Dispatch needed for LL hook
+        while (!st.stop_requested() && GetMessageW(&msg, nullptr, 0, 0) > 0) {
+            // no Translate/Dispatch needed for LL hook
+            if (msg.message == kReinstallHookMsg) {
+                UnhookWindowsHookEx(hookHandle);
+                hookHandle = SetWindowsHookExW(WH_KEYBOARD_LL, HookProc, nullptr, 0);
+                if (!hookHandle) {
+                    LOG_E("Keyboard hook reinstall failed: {}", GetLastError());
+                    break;
+                }
+            }
+        }
 
-        UnhookWindowsHookEx(hookHandle);
+        if (hookHandle)
+            UnhookWindowsHookEx(hookHandle);
         hookHandle = nullptr;
     }
 }
+
+void KeyboardManager::WatchdogLoop(std::stop_token st) {
+    SET_THREAD_NAME("KB Watchdog");
+    using utils::watchdog::Verdict;
+
+    std::mutex m;
+    std::condition_variable_any cv;
+    std::unique_lock lock(m);
+    while (!st.stop_requested()) {
+        cv.wait_for(lock, st, kWatchdogPeriod, [] { return false; });
+        if (st.stop_requested())
+            break;
+
+        // a live hook swallows SUPER, so the system only sees it held when the hook is gone
+        const bool superHeld = (GetAsyncKeyState(config->m_settings.SUPER) & 0x8000) != 0;
+        const bool evidence = superHeld && !g_superDown.load(std::memory_order_relaxed);
+
+        switch (watchdog.Check(hookStats.Snap(), evidence, input::NowNs())) {
+            case Verdict::Silent:
+                LOG_W("Keyboard hook stopped receiving input, reinstalling (worst callback {:.3f} ms)", hookStats.TakeWorst() / 1e6);
+                PostThreadMessageW(hookThreadId, kReinstallHookMsg, 0, 0);
+                break;
+            case Verdict::OverBudget:
+                LOG_W("Keyboard hook callback over budget (worst {:.3f} ms)", hookStats.TakeWorst() / 1e6);
+                break;
+            default:
+                break;
+        }
+    }
+}
 } // namespace km
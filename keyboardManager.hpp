@@ -1,49 +1,37 @@
 #pragma once
 #include <windows.h>
 #include <atomic>
+#include <chrono>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 #include <functional>
-#include "lockfreequeue.hpp"
+#include "inputEvent.hpp"
+#include "inputReactor.hpp"
+#include "keyDecoder.hpp"
+#include "utils/watchdog.hpp"
 
 #include "settings/config.hpp"
 
 namespace km {
 class KeyboardManager {
   public:
-    KeyboardManager(Config* cfg);
+    KeyboardManager(Config* cfg, input::Reactor* reactor);
     ~KeyboardManager();
 
     void SetSuperReleasedCallback(std::function<void()> cb);
     void SetSuperPressedCallback(std::function<void()> cb);
 
+    // Reactor thread only
+    void ProcessKey(const input::Event& ev);
+
   private:
     static LRESULT CALLBACK HookProc(int code, WPARAM wParam, LPARAM lParam) noexcept;
-    void InputLoop(std::stop_token st);
     void HookLoop(std::stop_token st);
-    void ProcessKey(UINT wp);
+    void WatchdogLoop(std::stop_token st);
     void SeedModifierStates() noexcept;
 
-    inline bool IsKeySet(int vk) const noexcept {
-        return (keyBits[vk >> 6] >> (vk & 63)) & 1;
-    }
-
-    inline void SetKey(int vk) noexcept {
-        keyBits[vk >> 6] |= (1ull << (vk & 63));
-    }
-
-    inline void ClearKey(int vk) noexcept {
-        keyBits[vk >> 6] &= ~(1ull << (vk & 63));
-    }
-
-    inline void ClearAllKeys() noexcept {
-        for (auto& bits : keyBits)
-            bits = 0;
-    }
-
     static inline KeyboardManager* instance = nullptr;
     Config* config = nullptr;
+    input::Reactor* reactor = nullptr;
 
     std::function<void()> superPressedCallback;
     std::function<void()> superReleasedCallback;
@@ -51,19 +39,14 @@ class KeyboardManager {
     HHOOK hookHandle = nullptr;
     DWORD hookThreadId = 0;
 
-    std::jthread inputThread;
     std::jthread hookThread;
+    std::jthread watchdogThread;
 
-    std::condition_variable cv;
-    std::mutex cvMutex;
-
-    std::condition_variable hookCv;
-    std::mutex hookCvMutex;
-
-    bool installHookRequested = false;
-    bool uninstallHookRequested = false;
+    static constexpr UINT kReinstallHookMsg = WM_APP + 1;
+    static constexpr std::chrono::milliseconds kWatchdogPeriod{250};
+    utils::watchdog::HookStats hookStats;
+    utils::watchdog::Watchdog watchdog;
 
-    LockFreeQueue<UINT, 32> keyQueue;
-    uint64_t keyBits[4]{};
+    KeyDecoder decoder; // reactor thread only, cleared on SUPER release
 };
 } // namespace km
\ No newline at end of file
@@ -8,7 +8,15 @@
 #include "tray/tray.hpp"
 #include "keyboardManager.hpp"
 #include "mouseManager.hpp"
+#include "borderController.hpp"
+#include "utils/window_tracker.hpp"
+#include "utils/mon.hpp"
 #include "settings/config.hpp"
+#include "settings/dispatcher.hpp"
+#include "utils/latency.hpp"
+#include "utils/render_stats.hpp"
+#include "inputTrace.hpp"
+#include "inputReplay.hpp"
 #include "resource.h"
 #include "tinylog.hpp"
 
@@ -71,12 +79,33 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
         return CONFIG_ERROR;
     }
     utils::DisableProcessThrottling();
-    mm::MouseManager mm(hInstance, &state.cfg);
-    km::KeyboardManager km(&state.cfg);
+    utils::wnd::Tracker windowTracker; // outlives the reactor thread, which reads it
+    input::Reactor reactor;
+    mm::MouseManager mm(hInstance, &state.cfg, &reactor);
+    km::KeyboardManager km(&state.cfg, &reactor);
+    BorderController borders(hInstance, &state.cfg);
 
     km.SetSuperPressedCallback([&]() { mm.InstallHook(); });
     km.SetSuperReleasedCallback([&]() { mm.UninstallHook(); });
 
+    // Single consumer for both hooks: SUPER, modifiers and mouse gestures are handled in order on one thread
+    std::jthread reactorThread([&](std::stop_token st) {
+        utils::BoostThread();
+        (void)CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
+        SET_THREAD_NAME("Input Reactor");
+        utils::wnd::Tracker::BindReader(); // SUPER+click and dispatcher hit-tests read the window registry
+        reactor.Run(st, [&](const input::Event& ev) {
+            if (ev.kind == input::Kind::Key)
+                km.ProcessKey(ev);
+            else
+                mm.ProcessMouse(ev);
+        });
+        CoUninitialize();
+    });
+
+    std::atomic<bool> replaying{false};
+    std::jthread replayThread;
+
     // Tray on main thread
     try {
         Tray::Icon HW_ICON(IDI_HWICON);
@@ -86,6 +115,10 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
         sys_tray.DarkMode(Tray::dark::AppModeForceDark);
         sys_tray.onLeftClick([&] { return true; });
         sys_tray.onDoubleClick([&] { return false; });
+        sys_tray.onDisplayChange([&] {
+            utils::mon::RefreshTopology();
+            borders.Refresh();
+        });
 
         auto reloadBtn = sys_tray.addEntry(Tray::Button(L"Reload Config", [&] {
             Config newCfg;
@@ -94,6 +127,7 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
                 return;
             }
             state.cfg = std::move(newCfg);
+            borders.Refresh();
         }));
         reloadBtn->setGlyphIcon(Tray::Icon(IDI_HWICON));
         reloadBtn->setDefault(true);
@@ -111,6 +145,70 @@ int WINAPI WinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance, _
 
         sys_tray.addEntry(Tray::Separator());
 
+        Tray::Submenu latencyMenu(L"Latency Stats");
+        latencyMenu.addEntry(Tray::Button(L"Dump to latency.txt", [&] {
+            if (!dispatcher::WriteLatencyReport())
+                return;
+            const auto rs = reactor.GetStats();
+            LOG_I("Input reactor: events={} rounds={} spinHits={} parks={}", rs.events, rs.rounds, rs.wake.spinHits, rs.wake.parks);
+            LOG_I("Input queue: critical={} overflowed={} coalesced={}", rs.queue.critical, rs.queue.overflowed, rs.queue.coalesced);
+            const auto pc = utils::GetProcessCacheStats();
+            LOG_I("Process names: hits={} misses={} stale={} evictions={}", pc.hits, pc.misses, pc.stale, pc.evictions);
+            sys_tray.showNotification(L"HyprWin", L"Latency stats written to latency.txt");
+        }));
+        latencyMenu.addEntry(Tray::Button(L"Reset", [] {
+            utils::latency::ResetAll();
+            utils::render::ResetAll();
+        }));
+        sys_tray.addEntry(std::move(latencyMenu));
+
+        // Trace replay runs in its own session (own reactor, key state and hit-tests), never the live one:
+        // nothing is dispatched or moved, and a trace that stops mid-gesture cannot leave SUPER held.
+        // One replay at a time; clicks while one runs are ignored so the tray never joins a replay.
+        auto replay = [&](bool realTime) {
+            if (replaying.exchange(true))
+                return;
+            if (replayThread.joinable())
+                replayThread.join(); // already finished: replaying was cleared on its way out
+            input::replay::Bindings bindings{nullptr, state.cfg.m_settings.SUPER, static_cast<uint64_t>(state.cfg.m_settings.sequenceTimeoutMs) * 1'000'000};
+            replayThread = std::jthread([&, realTime, bindings, trie = state.cfg.m_bindTable.Trie()]() mutable {
+                SET_THREAD_NAME("Trace Replay");
+                std::vector<input::Event> events;
+                std::string error;
+                if (input::trace::Load("input.trace", events, error)) {
+                    bindings.trie = &trie; // a copy: Reload Config may replace the live table meanwhile
+                    input::replay::Session session(bindings, [](int32_t x, int32_t y) {
+                        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(utils::GetFilteredWindow(POINT{x, y})));
+                    });
+                    const auto stats = session.Run(events, realTime);
+                    LOG_I("Trace replay: {} events in {:.2f} ms ({:.0f} events/s)", stats.feed.events, stats.feed.elapsedNs / 1e6, stats.feed.EventsPerSec());
+                    LOG_I("Trace replay: keys={} actions={} submaps={} clicks={} targets={} superHeldAtEnd={}", stats.keys, stats.actions, stats.submaps, stats.clicks, stats.targets, stats.superHeldAtEnd);
+                    LOG_I("Trace replay latency: key p50={}ns p99={}ns, click p50={}ns p99={}ns", stats.keyLatency.p50, stats.keyLatency.p99, stats.clickLatency.p50, stats.clickLatency.p99);
+                } else {
+                    LOG_E("Trace replay: {}", error);
+                }
+                replaying.store(false, std::memory_order_release);
+            });
+        };
+
+        Tray::Submenu traceMenu(L"Input Trace");
+        traceMenu.addEntry(Tray::Button(L"Start Recording", [&] {
+            if (input::trace::g_recorder.Start("input.trace"))
+                sys_tray.showNotification(L"HyprWin", L"Recording input to input.trace");
+            else
+                LOG_E("Failed to open input.trace");
+        }));
+        traceMenu.addEntry(Tray::Button(L"Stop Recording", [&] {
+            input::trace::g_recorder.Stop();
+            const auto rs = input::trace::g_recorder.GetStats();
+            LOG_I("Trace: recorded={} dropped={}", rs.recorded, rs.dropped);
+        }));
+        traceMenu.addEntry(Tray::Button(L"Replay (Recorded Speed)", [&] { replay(true); }));
+        traceMenu.addEntry(Tray::Button(L"Replay (Max Speed)", [&] { replay(false); }));
+        sys_tray.addEntry(std::move(traceMenu));
+
+        sys_tray.addEntry(Tray::Separator());
+
         sys_tray
           .addEntry(Tray::Button(L"Exit",
             [&] {
@@ -1,6 +1,9 @@
 #include "pch.hpp"
 #include "mouseManager.hpp"
+#include "inputTrace.hpp"
 #include "utils/utils.hpp"
+#include "utils/latency.hpp"
+#include "utils/watchdog.hpp"
 #include "overlay.hpp"
 #include "overlayController.hpp"
 #include "settings/config.hpp"
@@ -9,34 +12,51 @@
 
 #include "tinylog.hpp"
 
+using utils::latency::Stage;
+
 namespace mm {
-MouseManager::MouseManager(HINSTANCE hi, Config* cfg) : hInstance(hi), config(cfg), overlayController(hi, cfg, &latestMousePos) {
+MouseManager::MouseManager(HINSTANCE hi, Config* cfg, input::Reactor* r)
+    : hInstance(hi), config(cfg), reactor(r), overlayController(hi, cfg, &latestMousePos, &motionSamples) {
     instance = this;
 
-    inputThread = std::jthread([this](std::stop_token st) {
-        utils::BoostThread();
-
-        InputLoop(st);
-    });
-
     hookThread = std::jthread([this](std::stop_token st) {
         utils::BoostThread();
 
         HookLoop(st);
     });
+
+    watchdogThread = std::jthread([this](std::stop_token st) { WatchdogLoop(st); });
 }
 
 MouseManager::~MouseManager() {
-    inputThread.request_stop();
     hookThread.request_stop();
+    watchdogThread.request_stop();
 
     UninstallHook();
 
-    cv.notify_all();
     hookCv.notify_all();
+
+    if (watchdogThread.joinable())
+        watchdogThread.join();
 }
 
 void MouseManager::InstallHook() {
+    const uint64_t armNs = input::NowNs();
+    const bool persistent = config->m_settings.persistentMouseHook;
+    armPersistent.store(persistent, std::memory_order_relaxed);
+    armStartNs.store(armNs, std::memory_order_relaxed);
+    firstClickPending.store(true, std::memory_order_relaxed);
+
+    if (persistent && hookActive.load(std::memory_order_acquire)) {
+        // hook already installed: opening the gate is the whole arm cost
+        allowLUpPassthrough.store((GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0, std::memory_order_relaxed);
+        allowRUpPassthrough.store((GetAsyncKeyState(VK_RBUTTON) & 0x8000) != 0, std::memory_order_relaxed);
+        capture.store(true, std::memory_order_release);
+        utils::latency::Record(Stage::ArmPersistent, input::NowNs() - armNs);
+        return;
+    }
+
+    capture.store(true, std::memory_order_release);
     {
         std::scoped_lock lock(hookCvMutex);
         installHookRequested = true;
@@ -46,51 +66,88 @@ void MouseManager::InstallHook() {
 }
 
 void MouseManager::UninstallHook() {
-    {
+    const bool keepHook = config->m_settings.persistentMouseHook && !hookThread.get_stop_token().stop_requested();
+    if (keepHook) {
+        capture.store(false, std::memory_order_release);
+    } else {
+        // on-demand keeps swallowing until the hook thread actually unhooks
         std::scoped_lock lock(hookCvMutex);
         uninstallHookRequested = true;
     }
-    mouseQueue.push(WM_LBUTTONUP);
-    mouseQueue.push(WM_RBUTTONUP);
-
-    hookCv.notify_one();
-    PostThreadMessage(hookThreadId, WM_NULL, 0, 0);
+    reactor->Post(input::MakeSyntheticButton(input::Button::Left, false));
+    reactor->Post(input::MakeSyntheticButton(input::Button::Right, false));
+
+    if (keepHook) {
+        ReleaseHeldButtons();
+    } else {
+        hookCv.notify_one();
+        PostThreadMessage(hookThreadId, WM_NULL, 0, 0);
+    }
+}
 
-    cv.notify_one();
+// Buttons the system still thinks are down would stick once we stop swallowing input
+void MouseManager::ReleaseHeldButtons() noexcept {
+    const int buttons[] = {VK_LBUTTON, VK_RBUTTON};
+    const DWORD flags[] = {MOUSEEVENTF_LEFTUP, MOUSEEVENTF_RIGHTUP};
+
+    for (int i = 0; i < 2; ++i) {
+        if (GetAsyncKeyState(buttons[i]) & 0x8000) {
+            INPUT in{};
+            in.type = INPUT_MOUSE;
+            in.mi.dwFlags = flags[i];
+            SendInput(1, &in, sizeof(in));
+        }
+    }
 }
 
 LRESULT CALLBACK MouseManager::MouseProc(int code, WPARAM wParam, LPARAM lParam) {
     if (code < 0 || !instance || !lParam)
         return CallNextHookEx(nullptr, code, wParam, lParam);
 
+    const uint64_t captureNs = input::NowNs();
+    utils::watchdog::HookScope scope(instance->hookStats, captureNs, instance->watchdog.GetLimits().budgetNs);
     MSLLHOOKSTRUCT* ms = reinterpret_cast<MSLLHOOKSTRUCT*>(lParam);
+
+    // persistent hook with SUPER up: pass everything through, keep the position fresh for the watchdog
+    if (!instance->capture.load(std::memory_order_acquire)) {
+        if (wParam == WM_MOUSEMOVE)
+            instance->latestMousePos.store(ms->pt, std::memory_order_relaxed);
+        return CallNextHookEx(nullptr, code, wParam, lParam);
+    }
+
     switch (wParam) {
         case WM_MOUSEMOVE:
             instance->latestMousePos.store(ms->pt, std::memory_order_relaxed);
+            instance->motionSamples.Push({captureNs, ms->pt.x, ms->pt.y});
+            instance->overlayController.NotifyInput();
+            instance->Queue(input::MakeMove(ms->pt.x, ms->pt.y, ms->time, captureNs)); // coalesced, no wake
             return CallNextHookEx(nullptr, code, wParam, lParam);
 
         case WM_LBUTTONDOWN:
-        case WM_RBUTTONDOWN:
-            instance->lastDownPt.store(ms->pt, std::memory_order_relaxed);
-            instance->mouseQueue.push(wParam);
-            instance->cv.notify_one();
+        case WM_RBUTTONDOWN: {
+            const input::Button b = (wParam == WM_LBUTTONDOWN) ? input::Button::Left : input::Button::Right;
+            instance->Queue(input::MakeButton(b, true, ms->pt.x, ms->pt.y, ms->time, captureNs));
+            utils::latency::Record(Stage::MouseHook, input::NowNs() - captureNs);
+            if (instance->firstClickPending.load(std::memory_order_relaxed) && instance->firstClickPending.exchange(false, std::memory_order_relaxed)) {
+                const Stage s = instance->armPersistent.load(std::memory_order_relaxed) ? Stage::FirstPersistent : Stage::FirstOnDemand;
+                utils::latency::Record(s, captureNs - instance->armStartNs.load(std::memory_order_relaxed));
+            }
             return 1;
+        }
 
         case WM_LBUTTONUP: {
-            instance->mouseQueue.push(wParam);
-            instance->cv.notify_one();
-            if (instance->allowLUpPassthrough) {
-                instance->allowLUpPassthrough = false;
+            instance->Queue(input::MakeButton(input::Button::Left, false, ms->pt.x, ms->pt.y, ms->time, captureNs));
+            utils::latency::Record(Stage::MouseHook, input::NowNs() - captureNs);
+            if (instance->allowLUpPassthrough.exchange(false, std::memory_order_relaxed)) {
                 return CallNextHookEx(nullptr, code, wParam, lParam);
             }
             return 1;
         }
 
         case WM_RBUTTONUP: {
-            instance->mouseQueue.push(wParam);
-            instance->cv.notify_one();
-            if (instance->allowRUpPassthrough) {
-                instance->allowRUpPassthrough = false;
+            instance->Queue(input::MakeButton(input::Button::Right, false, ms->pt.x, ms->pt.y, ms->time, captureNs));
+            utils::latency::Record(Stage::MouseHook, input::NowNs() - captureNs);
+            if (instance->allowRUpPassthrough.exchange(false, std::memory_order_relaxed)) {
                 return CallNextHookEx(nullptr, code, wParam, lParam);
             }
             return 1;
@@ -99,8 +156,11 @@ LRESULT CALLBACK MouseManager::MouseProc(int code, WPARAM wParam, LPARAM lParam)
         case WM_MBUTTONUP:
             return CallNextHookEx(nullptr, code, wParam, lParam);
 
-        case WM_MBUTTONDOWN:
         case WM_MOUSEWHEEL:
+            instance->Queue(input::MakeWheel(static_cast<int16_t>(HIWORD(ms->mouseData)), ms->pt.x, ms->pt.y, ms->time, captureNs));
+            return 1;
+
+        case WM_MBUTTONDOWN:
         case WM_MOUSEHWHEEL:
             return 1;
 
@@ -109,28 +169,21 @@ LRESULT CALLBACK MouseManager::MouseProc(int code, WPARAM wParam, LPARAM lParam)
     }
 }
 
-void MouseManager::InputLoop(std::stop_token st) {
-    SET_THREAD_NAME("Mouse Input");
-    while (!st.stop_requested()) {
-        std::unique_lock lock(cvMutex);
-        cv.wait(lock, [&] { return st.stop_requested() || !mouseQueue.empty(); });
-
-        if (st.stop_requested())
-            continue;
-
-        while (!mouseQueue.empty()) {
-            WPARAM wp;
-            if (mouseQueue.pop(wp)) {
-                ProcessMouse(wp);
-            }
-        }
-    }
+// Hook thread only: hand to the reactor and mirror into the trace recorder
+void MouseManager::Queue(const input::Event& ev) noexcept {
+    reactor->Post(ev);
+    input::trace::g_recorder.Record(input::trace::Source::Mouse, ev);
 }
 
 void MouseManager::HookLoop(std::stop_token st) {
     hookThreadId = GetCurrentThreadId();
     SET_THREAD_NAME("Mouse Hook");
 
+    if (config->m_settings.persistentMouseHook) {
+        std::scoped_lock lock(hookCvMutex);
+        installHookRequested = true; // gate stays closed until the first SUPER press
+    }
+
     while (!st.stop_requested()) {
         {
             std::unique_lock lock(hookCvMutex);
@@ -145,8 +198,16 @@ void MouseManager::HookLoop(std::stop_token st) {
                 installHookRequested = false;
                 uninstallHookRequested = false;
 
-                allowLUpPassthrough = (GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0;
-                allowRUpPassthrough = (GetAsyncKeyState(VK_RBUTTON) & 0x8000) != 0;
+                if (capture.load(std::memory_order_acquire)) {
+                    const Stage s = armPersistent.load(std::memory_order_relaxed) ? Stage::ArmPersistent : Stage::ArmOnDemand;
+                    utils::latency::Record(s, input::NowNs() - armStartNs.load(std::memory_order_relaxed));
+                }
+
+                allowLUpPassthrough.store((GetAsyncKeyState(VK_LBUTTON) & 0x8000) != 0, std::memory_order_relaxed);
+                allowRUpPassthrough.store((GetAsyncKeyState(VK_RBUTTON) & 0x8000) != 0, std::memory_order_relaxed);
+                if (POINT cursor{}; GetCursorPos(&cursor))
+                    latestMousePos.store(cursor, std::memory_order_relaxed); // baseline for the watchdog probe
+                hookActive.store(hookHandle != nullptr, std::memory_order_release);
             }
         }
 
@@ -158,36 +219,81 @@ void MouseManager::HookLoop(std::stop_token st) {
             BOOL result = GetMessageW(&msg, nullptr, 0, 0);
             if (result <= 0)
                 break;
+            if (msg.message == kReinstallHookMsg) {
+                UnhookWindowsHookEx(hookHandle);
+                hookHandle = SetWindowsHookExW(WH_MOUSE_LL, MouseProc, nullptr, 0);
+                if (!hookHandle) {
+                    LOG_E("Mouse hook reinstall failed: {}", GetLastError());
+                    break;
+                }
+            }
         }
 
+        hookActive.store(false, std::memory_order_release);
         if (hookHandle) {
             HOOK_REMOVE();
             UnhookWindowsHookEx(hookHandle);
             hookHandle = nullptr;
         }
 
-        const int buttons[] = {VK_LBUTTON, VK_RBUTTON};
-        const DWORD flags[] = {MOUSEEVENTF_LEFTUP, MOUSEEVENTF_RIGHTUP};
-
-        for (int i = 0; i < 2; ++i) {
-            if (GetAsyncKeyState(buttons[i]) & 0x8000) {
-                INPUT in{};
-                in.type = INPUT_MOUSE;
-                in.mi.dwFlags = flags[i];
-                SendInput(1, &in, sizeof(in));
-            }
-        }
+        ReleaseHeldButtons();
 
         uninstallHookRequested = false;
     }
 }
 
-void MouseManager::ProcessMouse(WPARAM wp) {
+void MouseManager::WatchdogLoop(std::stop_token st) {
+    SET_THREAD_NAME("Mouse Watchdog");
+    using utils::watchdog::Verdict;
+
+    std::mutex m;
+    std::condition_variable_any cv;
+    std::unique_lock lock(m);
+    LASTINPUTINFO last{sizeof(last)};
+    DWORD lastInput = GetLastInputInfo(&last) ? last.dwTime : 0;
+    while (!st.stop_requested()) {
+        cv.wait_for(lock, st, kWatchdogPeriod, [] { return false; });
+        if (st.stop_requested())
+            break;
+
+        // a live hook sees every move before the cursor does, so a cursor it never reported means it
+        // is gone; but SetCursorPos/ClipCursor move it without input, so user input must have
+        // happened too (GetLastInputInfo ignores those, while real and SendInput moves reach the hook)
+        const DWORD prevInput = lastInput;
+        if (GetLastInputInfo(&last))
+            lastInput = last.dwTime;
+        POINT cursor{};
+        const POINT seen = latestMousePos.load(std::memory_order_relaxed);
+        const bool evidence = hookActive.load(std::memory_order_acquire) && lastInput != prevInput && GetCursorPos(&cursor) && (cursor.x != seen.x || cursor.y != seen.y);
+
+        switch (watchdog.Check(hookStats.Snap(), evidence, input::NowNs())) {
+            case Verdict::Silent:
+                LOG_W("Mouse hook stopped receiving input, reinstalling (worst callback {:.3f} ms)", hookStats.TakeWorst() / 1e6);
+                PostThreadMessageW(hookThreadId, kReinstallHookMsg, 0, 0);
+                break;
+            case Verdict::OverBudget:
+                LOG_W("Mouse hook callback over budget (worst {:.3f} ms)", hookStats.TakeWorst() / 1e6);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void MouseManager::ProcessMouse(const input::Event& ev) {
+    // trace replay hit-tests in its own session (inputReplay.hpp), never against the live drag
+    if (ev.kind != input::Kind::Button || (ev.flags & input::Replayed))
+        return;
+
+    const bool left = ev.GetButton() == input::Button::Left;
+    const WPARAM wp = ev.IsDown() ? (left ? WM_LBUTTONDOWN : WM_RBUTTONDOWN) : (left ? WM_LBUTTONUP : WM_RBUTTONUP);
+
     switch (wp) {
         case WM_RBUTTONDOWN:
         case WM_LBUTTONDOWN:
             if (!overlayController.IsActive()) {
-                const POINT pt = lastDownPt.load(std::memory_order_acquire);
+                const uint64_t decodeStart = input::NowNs();
+                const POINT pt{ev.x, ev.y};
                 latestMousePos.store(pt, std::memory_order_relaxed);
 
                 HWND parent = utils::GetFilteredWindow(pt);
@@ -195,11 +301,15 @@ void MouseManager::ProcessMouse(WPARAM wp) {
                     break;
                 targetWindow = parent;
 
-                std::wstring name = utils::GetProcessName(targetWindow);
-                if (!_wcsicmp(name.c_str(), L"cs2.exe")) {
+                utils::proc::NameId app = utils::proc::kNoName;
+                const rules::Result rule = utils::MatchRules(config->m_settings.windowRules, targetWindow, &app);
+                if (rule.Has(rules::Ignore)) {
                     break;
                 }
 
+                const uint64_t actionStart = input::NowNs();
+                utils::latency::Record(Stage::MouseDecode, actionStart - decodeStart);
+
 #ifdef _DEBUG
                 utils::logWindowData(targetWindow);
 #endif
@@ -219,11 +329,14 @@ void MouseManager::ProcessMouse(WPARAM wp) {
 
                 OverlayState state{};
                 state.windowBounds = windowRect;
+                state.target = targetWindow;
+                state.appKey = app;
+                state.live = config->m_settings.liveResize;
                 state.action = (wp == WM_LBUTTONDOWN) ? OverlayAction::Move : OverlayAction::Resize;
 
                 if (wp == WM_RBUTTONDOWN) {
                     LONG_PTR style = GetWindowLongPtrW(targetWindow, GWL_STYLE);
-                    if ((style & WS_THICKFRAME) == 0) {
+                    if ((style & WS_THICKFRAME) == 0 || rule.Has(rules::FixedSize)) {
                         LOG_I("NOT RESIZABLE");
                         break;
                     }
@@ -275,23 +388,8 @@ void MouseManager::ProcessMouse(WPARAM wp) {
                     state.resizeStartRect = windowRect;
 
                     if (config->m_settings.resize_corner == ResizeCorner::None) {
-                        const int xRel = pt.x - windowRect.left;
-                        const int yRel = pt.y - windowRect.top;
-                        const int w = windowRect.right - windowRect.left;
-                        const int h = windowRect.bottom - windowRect.top;
-
-                        if (w > 0 && h > 0) {
-                            const float xRatio = static_cast<float>(xRel) / w;
-                            const float yRatio = static_cast<float>(yRel) / h;
-
-                            if (xRatio < 0.5f) {
-                                state.resizeCorner = (yRatio < 0.5f) ? ResizeCorner::TopLeft : ResizeCorner::BottomLeft;
-                            } else {
-                                state.resizeCorner = (yRatio < 0.5f) ? ResizeCorner::TopRight : ResizeCorner::BottomRight;
-                            }
-                        } else {
-                            state.resizeCorner = ResizeCorner::BottomRight;
-                        }
+                        const auto corner = utils::geom::PickCorner(utils::geom::FromRECT(windowRect), {pt.x, pt.y});
+                        state.resizeCorner = utils::geom::ToResizeCorner(corner);
                     } else {
                         state.resizeCorner = config->m_settings.resize_corner;
                     }
@@ -311,16 +409,17 @@ void MouseManager::ProcessMouse(WPARAM wp) {
                 }
 
                 overlayController.UpdateState(state);
+
+                const uint64_t done = input::NowNs();
+                utils::latency::Record(Stage::MouseAction, done - actionStart);
+                utils::latency::Record(Stage::MouseTotal, done - ev.captureNs);
             }
             break;
 
         case WM_LBUTTONUP:
         case WM_RBUTTONUP: {
             if (targetWindow && overlayController.IsActive()) {
-                RECT r = overlayController.GetLatestBounds();
-
-                SetWindowPos(targetWindow, nullptr, r.left, r.top, r.right - r.left, r.bottom - r.top, SWP_NOZORDER | SWP_NOACTIVATE);
-
+                overlayController.CommitBounds(targetWindow);
                 overlayController.ClearState();
                 targetWindow = nullptr;
             }
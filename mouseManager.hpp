@@ -1,10 +1,13 @@
 #pragma once
 #include <windows.h>
 #include <atomic>
+#include <chrono>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include "lockfreequeue.hpp"
+#include "inputEvent.hpp"
+#include "inputReactor.hpp"
+#include "utils/watchdog.hpp"
 #include "settings/config.hpp"
 #include "overlayController.hpp"
 
@@ -12,35 +15,43 @@ namespace mm {
 
 class MouseManager {
   public:
-    MouseManager(HINSTANCE hi, Config* cfg);
+    MouseManager(HINSTANCE hi, Config* cfg, input::Reactor* reactor);
     ~MouseManager();
 
     void InstallHook();
     void UninstallHook();
 
+    // Reactor thread only
+    void ProcessMouse(const input::Event& ev);
+
   private:
     static LRESULT CALLBACK MouseProc(int code, WPARAM wParam, LPARAM lParam);
-    void InputLoop(std::stop_token st);
+    void Queue(const input::Event& ev) noexcept;
     void HookLoop(std::stop_token st);
-    void ProcessMouse(WPARAM wp);
+    void WatchdogLoop(std::stop_token st);
+    void ReleaseHeldButtons() noexcept;
 
     static inline MouseManager* instance = nullptr;
     Config* config = nullptr;
+    input::Reactor* reactor = nullptr;
 
     HHOOK hookHandle = nullptr;
     DWORD hookThreadId = 0;
 
-    std::jthread inputThread;
     std::jthread hookThread;
+    std::jthread watchdogThread;
 
-    std::condition_variable cv;
-    std::mutex cvMutex;
+    static constexpr UINT kReinstallHookMsg = WM_APP + 1;
+    static constexpr std::chrono::milliseconds kWatchdogPeriod{250};
+    utils::watchdog::HookStats hookStats;
+    utils::watchdog::Watchdog watchdog;
+    std::atomic<bool> hookActive{false}; // HookLoop has a hook installed
 
     std::condition_variable hookCv;
     std::mutex hookCvMutex;
 
     std::atomic<POINT> latestMousePos = {POINT{0, 0}};
-    std::atomic<POINT> lastDownPt{POINT{0, 0}};
+    utils::motion::CursorRing motionSamples; // timestamped moves while capturing, for the overlay predictor
 
     POINT dragOffset = {};
     POINT resizeStartCursor = {};
@@ -53,10 +64,14 @@ class MouseManager {
     bool installHookRequested = false;
     bool uninstallHookRequested = false;
 
-    bool allowLUpPassthrough = false;
-    bool allowRUpPassthrough = false;
+    std::atomic<bool> allowLUpPassthrough{false};
+    std::atomic<bool> allowRUpPassthrough{false};
 
-    LockFreeQueue<WPARAM, 16> mouseQueue;
+    // Capture gate: MouseProc passes everything through while closed (SUPER up, persistent hook)
+    std::atomic<bool> capture{false};
+    std::atomic<bool> armPersistent{false};
+    std::atomic<uint64_t> armStartNs{0}; // SUPER down, for arm / first click latency
+    std::atomic<bool> firstClickPending{false};
 
     ResizeCorner resizeCorner = ResizeCorner::BottomRight; // default
 
@@ -1,23 +1,96 @@
 #include "pch.hpp"
 #include "overlay.hpp"
+#include "inputEvent.hpp"
+#include "utils/border_raster.hpp"
+#include "utils/frame_loop.hpp"
+#include "utils/frame_pacer.hpp"
+#include "utils/gradient.hpp"
+#include "utils/mon.hpp"
+#include "utils/render_stats.hpp"
 #include <Uxtheme.h>
 
+namespace {
+constexpr uint64_t kIdleFrameNs = 33'333'333;  // ~30 Hz while the cursor is still
+constexpr uint64_t kIdleAfterNs = 250'000'000;
+
+// Pacer clock: high-resolution waitable timer (Windows 10 1803+), plain waitable timer otherwise
+class TimerClock {
+  public:
+    TimerClock() {
+        timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (!timer)
+            timer = CreateWaitableTimerW(nullptr, TRUE, nullptr);
+    }
+    ~TimerClock() {
+        if (timer)
+            CloseHandle(timer);
+    }
+    TimerClock(const TimerClock&) = delete;
+    TimerClock& operator=(const TimerClock&) = delete;
+
+    uint64_t Now() const noexcept {
+        return input::NowNs();
+    }
+
+    void SleepUntil(uint64_t ns) noexcept {
+        const uint64_t now = Now();
+        if (ns <= now)
+            return;
+        if (!timer) {
+            Sleep(static_cast<DWORD>((ns - now) / 1'000'000));
+            return;
+        }
+        LARGE_INTEGER due{};
+        due.QuadPart = -static_cast<LONGLONG>((ns - now) / 100); // relative, 100 ns units
+        if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE))
+            WaitForSingleObject(timer, INFINITE);
+    }
+
+  private:
+    HANDLE timer = nullptr;
+};
+
+// One SetWindowPos per commit, flags from what changed
+class WindowPosRecorder final : public utils::render::GeometryRecorder {
+  public:
+    WindowPosRecorder(HWND hwnd, HWND insertAfter) : hwnd(hwnd), insertAfter(insertAfter) {}
+
+    void Commit(const utils::render::GeometryCommit& c) override {
+        UINT flags = SWP_NOACTIVATE;
+        if (!c.reorder)
+            flags |= SWP_NOZORDER;
+        if (!c.move)
+            flags |= SWP_NOMOVE;
+        if (!c.size)
+            flags |= SWP_NOSIZE;
+        SetWindowPos(hwnd, insertAfter, c.rect.left, c.rect.top, c.rect.Width(), c.rect.Height(), flags);
+        utils::render::Count(utils::render::g_counters.geometryCommits);
+    }
+
+  private:
+    HWND hwnd;
+    HWND insertAfter;
+};
+} // namespace
+
 OverlayWindow::OverlayWindow() {}
 
 OverlayWindow::~OverlayWindow() {
     Destroy();
 }
 
-bool OverlayWindow::Init(HINSTANCE hInstance) {
+bool OverlayWindow::Init(HINSTANCE hInstance, bool sw, bool top) {
     if (hwnd)
         Destroy();
-
-    D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, &d2dFactory);
+    software = sw;
+    topmost = top;
 
     WNDCLASSEXW wc = {sizeof(WNDCLASSEXW), CS_HREDRAW | CS_VREDRAW, DefWindowProcW, 0, 0, hInstance, nullptr, nullptr, nullptr, nullptr, kOverlayClassName, nullptr};
     RegisterClassExW(&wc);
 
-    hwnd = CreateWindowExW(WS_EX_TRANSPARENT | WS_EX_NOACTIVATE | WS_EX_TOPMOST, // NO WS_EX_LAYERED
+    // D2D draws into a DWM-composed window (NO WS_EX_LAYERED), the software path presents with UpdateLayeredWindow
+    const DWORD exStyle = WS_EX_TRANSPARENT | WS_EX_NOACTIVATE | (topmost ? WS_EX_TOPMOST : 0) | (software ? WS_EX_LAYERED : 0);
+    hwnd = CreateWindowExW(exStyle,
       kOverlayClassName,
       nullptr,
       WS_POPUP,
@@ -30,13 +103,21 @@ bool OverlayWindow::Init(HINSTANCE hInstance) {
       hInstance,
       nullptr);
 
+    if (software) {
+        memDC = CreateCompatibleDC(nullptr);
+        SetColor((D2D1_COLOR_F)65535);
+        return hwnd && memDC;
+    }
+
+    D2D1CreateFactory(D2D1_FACTORY_TYPE_SINGLE_THREADED, &d2dFactory);
+
     MARGINS margins = {-1};
     DwmExtendFrameIntoClientArea(hwnd, &margins);
 
     D2D1_RENDER_TARGET_PROPERTIES props =
       D2D1::RenderTargetProperties(D2D1_RENDER_TARGET_TYPE_DEFAULT, D2D1::PixelFormat(DXGI_FORMAT_B8G8R8A8_UNORM, D2D1_ALPHA_MODE_PREMULTIPLIED), 0.0f, 0.0f);
 
-    D2D1_HWND_RENDER_TARGET_PROPERTIES hwndProps = D2D1::HwndRenderTargetProperties(hwnd, D2D1::SizeU(1, 1), D2D1_PRESENT_OPTIONS_NONE);
+    D2D1_HWND_RENDER_TARGET_PROPERTIES hwndProps = D2D1::HwndRenderTargetProperties(hwnd, D2D1::SizeU(1, 1), vsync ? D2D1_PRESENT_OPTIONS_NONE : D2D1_PRESENT_OPTIONS_IMMEDIATELY);
 
     d2dFactory->CreateHwndRenderTarget(props, hwndProps, &renderTarget);
 
@@ -56,25 +137,33 @@ void OverlayWindow::Destroy() {
     SafeRelease(&gradientStopsOuter);
     SafeRelease(&gradientStopsInner);
 
+    ReleaseSurface();
+    if (memDC) {
+        DeleteDC(memDC);
+        memDC = nullptr;
+    }
+
     if (hwnd) {
         DestroyWindow(hwnd);
         hwnd = nullptr;
     }
 
     visible = false;
+    geometry.Reset();
     lastWidth = 0;
     lastHeight = 0;
+    damage.Invalidate();
 }
 
 void OverlayWindow::Show() {
     if (!visible) {
-        static float ang = gradientAngleDeg;
-        if (gradient && ang != gradientAngleDeg) {
-            ang = gradientAngleDeg;
-            CreateGradientBrushes();
-        }
+        if (gradient)
+            UpdateGradientEndpoints();
+        lastRotate = std::chrono::steady_clock::now(); // no jump for the time spent hidden
+        damage.Invalidate();
         ShowWindow(hwnd, SW_SHOWNOACTIVATE);
-        SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
+        if (topmost)
+            SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0, SWP_NOMOVE | SWP_NOSIZE | SWP_NOACTIVATE);
         visible = true;
     }
 }
@@ -86,28 +175,33 @@ void OverlayWindow::Hide() {
     }
 }
 
-void OverlayWindow::Move(int x, int y) {
-    SetWindowPos(hwnd, HWND_TOPMOST, x, y, 0, 0, SWP_NOSIZE | SWP_NOACTIVATE | SWP_NOZORDER);
+// Position and size in one SetWindowPos, so a frame never shows the new position with the old size.
+// insertAfter also restacks the window in the same call (persistent borders sit just above their target);
+// any value restacks, HWND_TOP included, nullopt keeps the z-order.
+void OverlayWindow::SetGeometry(const RECT& r, std::optional<HWND> insertAfter) {
+    WindowPosRecorder out(hwnd, insertAfter.value_or(HWND_TOPMOST));
+    const auto c = geometry.Set({r.left, r.top, r.right, r.bottom}, insertAfter.has_value(), out);
+    if (c.size)
+        ResizeSurface(c.rect.Width(), c.rect.Height());
 }
 
-void OverlayWindow::Resize(int width, int height) {
-    if (width == lastWidth && height == lastHeight)
-        return;
+void OverlayWindow::ResizeSurface(int width, int height) {
     lastWidth = width;
     lastHeight = height;
 
-    SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, width, height, SWP_NOMOVE | SWP_NOACTIVATE | SWP_NOZORDER);
-
-    if (!renderTarget)
-        return;
-
-    renderTarget->Resize(D2D1::SizeU(width, height));
-    renderTarget->SetDpi(96.0f, 96.0f);
-
-    if (gradient && !rotating) {
-        CreateGradientBrushes();
+    if (software) {
+        if (!CreateSurface(width, height))
+            return;
+    } else {
+        if (!renderTarget)
+            return;
+        renderTarget->Resize(D2D1::SizeU(width, height));
+        renderTarget->SetDpi(96.0f, 96.0f);
     }
 
+    if (gradient)
+        UpdateGradientEndpoints();
+
     thicknessOuter = std::floor(borderThickness / 2.0f);
     thicknessInner = borderThickness - thicknessOuter;
 
@@ -119,26 +213,59 @@ void OverlayWindow::Resize(int width, int height) {
       thicknessOuter + thicknessInner * 0.5f,
       static_cast<float>(width) - thicknessOuter - thicknessInner * 0.5f,
       static_cast<float>(height) - thicknessOuter - thicknessInner * 0.5f);
+}
 
-    Render();
+static bool SameColor(const D2D1_COLOR_F& a, const D2D1_COLOR_F& b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
 }
 
 void OverlayWindow::SetColor(const D2D1_COLOR_F& color) {
+    const bool sameBrushes = (software || (brush && fadeBrush)) && SameColor(color, solidColor);
+    if (!gradient && sameBrushes)
+        return;
     gradient = false;
+    ++styleGen;
+    if (sameBrushes) // back from a gradient, the solid brushes are still valid
+        return;
+    solidColor = color;
+    if (software)
+        return;
+
     SafeRelease(&brush);
     SafeRelease(&fadeBrush);
 
     renderTarget->CreateSolidColorBrush(color, &brush);
     renderTarget->CreateSolidColorBrush(D2D1::ColorF(color.r, color.g, color.b, 0.5f), &fadeBrush);
+    utils::render::Count(utils::render::g_counters.brushCreates, 2);
 }
 
+// Brushes are rebuilt only when the colors change, angle and rotation just move the endpoints
 void OverlayWindow::SetGradient(const D2D1_COLOR_F& start, const D2D1_COLOR_F& end, float angleDeg, bool r, float rotatingSpeed) {
+    const bool brushesMissing = !software && (!gradientBrushOuter || !gradientBrushInner);
+    const bool styleChanged = brushesMissing || !SameColor(start, gradientStart) || !SameColor(end, gradientEnd);
+    if (styleChanged || !gradient || r != rotating)
+        ++styleGen;
     gradient = true;
     gradientStart = start;
     gradientEnd = end;
     gradientAngleDeg = angleDeg;
     rotating = r;
     rotationSpeed = rotatingSpeed;
+
+    if (styleChanged)
+        CreateGradientBrushes();
+    UpdateGradientEndpoints();
+}
+
+void OverlayWindow::UpdateGradientEndpoints() {
+    if (!gradientBrushOuter || !gradientBrushInner)
+        return;
+
+    const auto e = utils::gradient::ForAngle(static_cast<float>(lastWidth), static_cast<float>(lastHeight), gradientAngleDeg);
+    gradientBrushOuter->SetStartPoint({e.x1, e.y1});
+    gradientBrushOuter->SetEndPoint({e.x2, e.y2});
+    gradientBrushInner->SetStartPoint({e.x1, e.y1});
+    gradientBrushInner->SetEndPoint({e.x2, e.y2});
 }
 
 void OverlayWindow::CreateGradientBrushes() {
@@ -161,36 +288,94 @@ void OverlayWindow::CreateGradientBrushes() {
     if (FAILED(renderTarget->CreateGradientStopCollection(stopsInner, 2, &gradientStopsInner)))
         return;
 
-    const float angleRad = gradientAngleDeg * (3.14159265f / 180.0f);
-    const float cx = lastWidth * 0.5f;
-    const float cy = lastHeight * 0.5f;
-    const float radius = std::hypot(cx, cy);
-    const float dx = std::cos(angleRad) * radius;
-    const float dy = std::sin(angleRad) * radius;
-
-    D2D1_POINT_2F p1 = {cx - dx, cy - dy};
-    D2D1_POINT_2F p2 = {cx + dx, cy + dy};
-    D2D1_LINEAR_GRADIENT_BRUSH_PROPERTIES props = {p1, p2};
+    const auto e = utils::gradient::ForAngle(static_cast<float>(lastWidth), static_cast<float>(lastHeight), gradientAngleDeg);
+    D2D1_LINEAR_GRADIENT_BRUSH_PROPERTIES props = {{e.x1, e.y1}, {e.x2, e.y2}};
 
     renderTarget->CreateLinearGradientBrush(props, gradientStopsOuter, &gradientBrushOuter);
     renderTarget->CreateLinearGradientBrush(props, gradientStopsInner, &gradientBrushInner);
+    utils::render::Count(utils::render::g_counters.brushCreates, 4);
 }
 
-void OverlayWindow::Render() {
-    if (!renderTarget || !brush || !fadeBrush)
+// -------- software backend --------
+bool OverlayWindow::CreateSurface(int width, int height) {
+    ReleaseSurface();
+    if (!memDC || width <= 0 || height <= 0)
+        return false;
+
+    BITMAPINFO bi{};
+    bi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bi.bmiHeader.biWidth = width;
+    bi.bmiHeader.biHeight = -height; // top-down
+    bi.bmiHeader.biPlanes = 1;
+    bi.bmiHeader.biBitCount = 32;
+    bi.bmiHeader.biCompression = BI_RGB;
+
+    // DIB sections are zero-filled, the rasterizer never writes the interior so it stays transparent
+    void* pv = nullptr;
+    dib = CreateDIBSection(memDC, &bi, DIB_RGB_COLORS, &pv, nullptr, 0);
+    if (!dib)
+        return false;
+    bits = static_cast<uint32_t*>(pv);
+    oldBitmap = SelectObject(memDC, dib);
+    return true;
+}
+
+void OverlayWindow::ReleaseSurface() {
+    if (!dib)
         return;
+    SelectObject(memDC, oldBitmap);
+    DeleteObject(dib);
+    dib = nullptr;
+    oldBitmap = nullptr;
+    bits = nullptr;
+}
+
+void OverlayWindow::RenderSoftware() {
+    namespace raster = utils::raster;
+    const D2D1_COLOR_F c0 = gradient ? gradientStart : solidColor;
+    const D2D1_COLOR_F c1 = gradient ? gradientEnd : solidColor;
+
+    // same geometry as the D2D strokes: outer at half alpha, inner opaque
+    raster::Border b{};
+    b.strokes[0] = {thicknessOuter * 0.5f, thicknessOuter, outerRounded.radiusX, {c0.r, c0.g, c0.b, 0.5f}, {c1.r, c1.g, c1.b, 0.5f}};
+    b.strokes[1] = {thicknessOuter + thicknessInner * 0.5f, thicknessInner, innerRounded.radiusX, {c0.r, c0.g, c0.b, 1.0f}, {c1.r, c1.g, c1.b, 1.0f}};
+    if (gradient) {
+        const auto e = utils::gradient::ForAngle(static_cast<float>(lastWidth), static_cast<float>(lastHeight), gradientAngleDeg);
+        b.gx1 = e.x1;
+        b.gy1 = e.y1;
+        b.gx2 = e.x2;
+        b.gy2 = e.y2;
+    }
+
+    const size_t px = raster::Draw({bits, lastWidth, lastHeight, lastWidth}, b);
+    utils::render::Count(utils::render::g_counters.rasterPixels, px);
+
+    SIZE size{lastWidth, lastHeight};
+    POINT src{0, 0};
+    BLENDFUNCTION blend{AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+    UpdateLayeredWindow(hwnd, nullptr, nullptr, &size, memDC, &src, 0, &blend, ULW_ALPHA);
+}
+
+bool OverlayWindow::Render() {
+    if (software ? !bits : (!renderTarget || !brush || !fadeBrush))
+        return false;
 
-    static auto lastTime = std::chrono::steady_clock::now();
     if (gradient && rotating) {
         auto now = std::chrono::steady_clock::now();
-        float deltaTime = std::chrono::duration<float>(now - lastTime).count();
-        lastTime = now;
+        float deltaTime = lastRotate == decltype(lastRotate){} ? 0.f : std::chrono::duration<float>(now - lastRotate).count();
+        lastRotate = now;
 
-        gradientAngleDeg += rotationSpeed * deltaTime;
-        if (gradientAngleDeg > 360.0f)
-            gradientAngleDeg -= 360.0f;
+        gradientAngleDeg = utils::gradient::Advance(gradientAngleDeg, rotationSpeed, deltaTime);
+        UpdateGradientEndpoints();
+    }
 
-        CreateGradientBrushes();
+    const utils::render::FrameKey key{lastWidth, lastHeight, dpi, styleGen, gradient ? gradientAngleDeg : 0.f};
+    if (!damage.Commit(key))
+        return false;
+
+    if (software) {
+        RenderSoftware();
+        return true;
     }
 
     renderTarget->BeginDraw();
@@ -207,12 +392,13 @@ void OverlayWindow::Render() {
         renderTarget->DrawRoundedRectangle(innerRounded, brush, thicknessInner);
 
     renderTarget->EndDraw();
+    return true;
 }
 
-void OverlayWindow::PreRender(const std::function<bool()>& condition, const std::function<void()>& onFrame) {
+void OverlayWindow::PreRender(const std::function<bool()>& condition, const std::function<bool()>& onFrame, const std::function<void()>& waitInput) {
     Show();
 
-    const UINT dpi = GetDpiForWindow(hwnd);
+    dpi = GetDpiForWindow(hwnd);
     m_radius = default_radius * (dpi / 96.0f);
     outerRounded.radiusX = m_radius;
     outerRounded.radiusY = m_radius;
@@ -222,10 +408,20 @@ void OverlayWindow::PreRender(const std::function<bool()>& condition, const std:
     innerRounded.radiusX = innerR;
     innerRounded.radiusY = innerR;
 
+    const int hz = utils::mon::GetRefreshRate(MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST));
+    utils::pacing::PacerConfig pc;
+    pc.periodNs = 1'000'000'000ull / static_cast<uint64_t>(hz);
+    pc.idlePeriodNs = kIdleFrameNs > pc.periodNs ? kIdleFrameNs : pc.periodNs;
+    pc.idleAfterNs = kIdleAfterNs;
+
+    TimerClock clock;
+    utils::pacing::FramePacer pacer(clock, pc, &utils::render::g_counters.frameTimes);
+
     while (condition()) {
-        if (onFrame)
-            onFrame();
-        Render();
+        const bool moved = onFrame && onFrame();
+        const bool drawn = Render();
+        // UpdateLayeredWindow never waits for vblank
+        utils::render::PaceFrame(pacer, utils::render::g_counters, moved, drawn, vsync && !software, waitInput);
     }
 
     Hide();
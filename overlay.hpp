@@ -2,9 +2,15 @@
 
 #include <Windows.h>
 #include <d2d1.h>
+#include <chrono>
 #include <functional>
+#include <optional>
 #include <concepts>
 
+#include "utils/frame_damage.hpp"
+#include "utils/geometry_commit.hpp"
+#include <cstdint>
+
 template <typename T>
 concept com_obj = std::is_base_of<IUnknown, T>::value;
 
@@ -23,14 +29,18 @@ class OverlayWindow {
     OverlayWindow();
     ~OverlayWindow();
 
-    bool Init(HINSTANCE hInstance);
+    // software: rasterize on the CPU into a DIB and present with UpdateLayeredWindow instead of D2D
+    // topmost: false for borders stacked with their target window
+    bool Init(HINSTANCE hInstance, bool software = false, bool topmost = true);
     void Destroy();
     void Show();
     void Hide();
-    void Move(int x, int y);
-    void Resize(int width, int height);
-    void Render();
-    void PreRender(const std::function<bool()>& condition, const std::function<void()>& onFrame);
+    void SetGeometry(const RECT& r, std::optional<HWND> insertAfter = std::nullopt); // screen rect, one window-manager commit
+    bool Render(); // false if nothing changed since the last drawn frame
+    // Runs onFrame + Render until condition() is false, paced to the monitor refresh.
+    // onFrame returns true when the cursor moved; frames drop to an idle cap otherwise.
+    // A frame with no movement and no damage blocks in waitInput until the next cursor sample.
+    void PreRender(const std::function<bool()>& condition, const std::function<bool()>& onFrame, const std::function<void()>& waitInput);
     void SetColor(const D2D1_COLOR_F& color);
     void SetGradient(const D2D1_COLOR_F& start, const D2D1_COLOR_F& end, float angleDeg = 0.f, bool rotating = false, float rotationSpeed = 90.f);
     HWND GetHwnd() const {
@@ -38,6 +48,8 @@ class OverlayWindow {
     }
 
     inline void SetBorderThickness(float bt) {
+        if (bt != borderThickness)
+            ++styleGen;
         borderThickness = bt;
         thicknessOuter = std::floor(bt / 2.0f);
         thicknessInner = bt - thicknessOuter;
@@ -45,6 +57,11 @@ class OverlayWindow {
 
   private:
     void CreateGradientBrushes();
+    void UpdateGradientEndpoints();
+    void ResizeSurface(int width, int height);
+    bool CreateSurface(int width, int height);
+    void ReleaseSurface();
+    void RenderSoftware();
 
     HWND hwnd = nullptr;
     ID2D1Factory* d2dFactory = nullptr;
@@ -61,6 +78,7 @@ class OverlayWindow {
     bool rotating = false;
     float rotationSpeed = 120.f;
     float gradientAngleDeg = 0.0f;
+    std::chrono::steady_clock::time_point lastRotate{}; // this overlay's last gradient step, reset on Show
 
     D2D1_RECT_F outerRect{};
     D2D1_RECT_F innerRect{};
@@ -74,11 +92,23 @@ class OverlayWindow {
     float thicknessOuter = std::floor(borderThickness / 2.0f);
     float thicknessInner = borderThickness - thicknessOuter;
 
+    D2D1_COLOR_F solidColor{};
     D2D1_COLOR_F gradientStart{};
     D2D1_COLOR_F gradientEnd{};
 
-    int lastWidth = 0;
+    utils::render::GeometryState geometry; // last committed screen rect
+    int lastWidth = 0; // surface size
     int lastHeight = 0;
+    UINT dpi = 96;
+    uint32_t styleGen = 0;
+    utils::render::DamageTracker damage;
+    bool software = false;
+    HDC memDC = nullptr;
+    HBITMAP dib = nullptr;
+    HGDIOBJ oldBitmap = nullptr;
+    uint32_t* bits = nullptr; // premultiplied BGRA, top-down, lastWidth x lastHeight
+
     bool visible = false;
-    bool vsync = true;
+    bool topmost = true;
+    bool vsync = true; // EndDraw blocks on vblank; false presents immediately and paces with a timer
 };
\ No newline at end of file
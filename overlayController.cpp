@@ -1,41 +1,143 @@
 #include "pch.hpp"
 #include "overlayController.hpp"
 
+#include "inputEvent.hpp"
 #include "tinylog.hpp"
+#include "utils/live_throttle.hpp"
+#include "utils/mon.hpp"
+#include "utils/render_stats.hpp"
 #include "utils/utils.hpp"
 
-OverlayController::OverlayController(HINSTANCE hi, Config* cfg, std::atomic<POINT>* mousePos) : hInstance(hi), config(cfg), latestMousePos(mousePos) {
+namespace geom = utils::geom;
+
+OverlayController::OverlayController(HINSTANCE hi, Config* cfg, std::atomic<POINT>* mousePos, const utils::motion::CursorRing* samples)
+    : hInstance(hi), config(cfg), latestMousePos(mousePos), motionSamples(samples) {
     overlayThread = std::jthread([this](std::stop_token st) { OverlayLoop(st); });
+    liveThread = std::jthread([this](std::stop_token st) { LiveLoop(st); });
 }
 
 OverlayController::~OverlayController() {
     if (overlayThread.joinable()) {
         overlayThread.request_stop();
-        overlayCv.notify_one();
+        inputWake.Notify();
+        overlayThread.join(); // before inputWake and the buffers go away
+    }
+    if (liveThread.joinable()) {
+        liveThread.request_stop();
+        liveWake.Notify();
+        liveThread.join();
     }
 }
 
 void OverlayController::UpdateState(const OverlayState& state) {
-    {
-        std::scoped_lock lock(overlayCvMutex);
-        overlayState = state;
-        currentAction.store(state.action, std::memory_order_release);
-        overlayBounds.store(state.windowBounds, std::memory_order_relaxed);
-    }
-    overlayCv.notify_one();
+    ++generation;
+    requested = state;
+    stateBuffer.Write({state, generation});
+    currentAction.store(state.action, std::memory_order_release);
+    inputWake.Notify();
 }
 
 void OverlayController::ClearState() {
     currentAction.store(OverlayAction::None, std::memory_order_release);
-    overlayCv.notify_one();
+    inputWake.Notify();
+}
+
+RECT OverlayController::GetLatestBounds() {
+    // the overlay thread may not have drawn a frame for this drag yet
+    const BoundsSlot& b = boundsBuffer.Read();
+    return b.generation == generation ? b.bounds : requested.windowBounds;
+}
+
+void OverlayController::CommitBounds(HWND target) {
+    const RECT r = GetLatestBounds();
+    if (!requested.live) {
+        SetWindowPos(target, nullptr, r.left, r.top, r.right - r.left, r.bottom - r.top, SWP_NOZORDER | SWP_NOACTIVATE);
+        return;
+    }
+    // single applier: the final bounds can't be overtaken by a late per-frame update
+    finalBuffer.Write({target, requested.appKey, r, generation});
+    liveWake.Notify();
+}
+
+void OverlayController::LiveLoop(std::stop_token st) {
+    SET_THREAD_NAME("Live Resize");
+
+    utils::live::ThrottleTable apps;
+    utils::live::ThrottleConfig cfg;
+    const int hz = utils::mon::GetRefreshRate(MonitorFromPoint({0, 0}, MONITOR_DEFAULTTOPRIMARY));
+    cfg.minIntervalNs = 1'000'000'000ull / static_cast<uint64_t>(hz);
+
+    // SetWindowPos on another thread's window returns once that thread handled the resize
+    const auto apply = [&](const LiveSlot& s, utils::live::AppThrottle& app) {
+        const uint64_t start = input::NowNs();
+        SetWindowPos(s.target, nullptr, s.bounds.left, s.bounds.top, s.bounds.right - s.bounds.left, s.bounds.bottom - s.bounds.top, SWP_NOZORDER | SWP_NOACTIVATE);
+        const uint64_t turnaround = input::NowNs() - start;
+        app.Applied(start, turnaround, cfg);
+        utils::render::Count(utils::render::g_counters.liveApplies);
+        utils::render::g_counters.liveTurnaround.Record(turnaround);
+    };
+
+    LiveSlot pending{};
+    bool hasPending = false;
+    uint32_t activeGeneration = 0;
+    uint32_t finishedGeneration = 0;
+
+    while (!st.stop_requested()) {
+        const uint32_t seen = liveWake.Epoch();
+
+        if (finalBuffer.Fresh()) {
+            const LiveSlot f = finalBuffer.Read();
+            apply(f, apps.For(f.appKey));
+            finishedGeneration = f.generation;
+            hasPending = false;
+            continue;
+        }
+
+        if (liveBuffer.Fresh()) {
+            pending = liveBuffer.Read(); // newer bounds replace unapplied ones
+            hasPending = pending.generation != finishedGeneration;
+        }
+        if (!hasPending) {
+            liveWake.Wait(seen);
+            continue;
+        }
+
+        utils::live::AppThrottle& app = apps.For(pending.appKey);
+        if (pending.generation != activeGeneration) {
+            app.BeginDrag();
+            activeGeneration = pending.generation;
+        }
+
+        const uint64_t now = input::NowNs();
+        if (!app.Due(now, cfg)) {
+            // short naps so a release is still applied promptly
+            const uint64_t wait = app.DueAt(cfg) - now;
+            std::this_thread::sleep_for(std::chrono::nanoseconds(wait < 4'000'000 ? wait : 4'000'000));
+            continue;
+        }
+
+        apply(pending, app);
+        hasPending = false;
+    }
+}
+
+// SHIFT keeps the aspect ratio, CTRL resizes around the centre, ALT snaps to RESIZE_GRID
+static uint8_t ResizeModifiers() {
+    uint8_t mode = utils::geom::Free;
+    if (GetAsyncKeyState(VK_SHIFT) & 0x8000)
+        mode |= utils::geom::AspectLock;
+    if (GetAsyncKeyState(VK_CONTROL) & 0x8000)
+        mode |= utils::geom::Centered;
+    if (GetAsyncKeyState(VK_MENU) & 0x8000)
+        mode |= utils::geom::Snap;
+    return mode;
 }
 
 void OverlayController::OverlayLoop(std::stop_token st) {
     OverlayWindow overlay;
-    overlay.Init(hInstance);
+    overlay.Init(hInstance, config->m_settings.softwareRenderer);
     SET_THREAD_NAME("Overlay");
 
-    std::unique_lock lock(overlayCvMutex);
     while (!st.stop_requested()) {
         MSG msg;
         while (PeekMessageW(&msg, overlay.GetHwnd(), 0, 0, PM_REMOVE)) {
@@ -43,13 +145,15 @@ void OverlayController::OverlayLoop(std::stop_token st) {
             DispatchMessageW(&msg);
         }
 
-        overlayCv.wait(lock, [&] { return st.stop_requested() || currentAction.load(std::memory_order_acquire) != OverlayAction::None; });
-
-        if (st.stop_requested())
-            break;
+        const uint32_t seen = inputWake.Epoch();
+        if (currentAction.load(std::memory_order_acquire) == OverlayAction::None) {
+            inputWake.Wait(seen);
+            continue;
+        }
 
-        OverlayState state = overlayState;
-        lock.unlock();
+        const StateSlot& slot = stateBuffer.Read();
+        const OverlayState state = slot.state;
+        const uint32_t stateGeneration = slot.generation;
 
         static HCURSOR g_curSizeAll = LoadCursor(nullptr, IDC_SIZEALL);
         static HCURSOR g_curNWSE = LoadCursor(nullptr, IDC_SIZENWSE);
@@ -86,93 +190,73 @@ void OverlayController::OverlayLoop(std::stop_token st) {
 
         overlay.SetBorderThickness(config->m_settings.borderThickness);
 
-        overlay.PreRender([&] { return !st.stop_requested() && currentAction.load(std::memory_order_acquire) != OverlayAction::None; },
+        geom::ResizeParams resize{};
+        resize.start = geom::FromRECT(state.resizeStartRect);
+        resize.startCursor = {state.resizeStartCursor.x, state.resizeStartCursor.y};
+        resize.corner = geom::FromResizeCorner(state.resizeCorner);
+        resize.minSize = {state.minSize.cx, state.minSize.cy};
+        resize.maxSize = {state.maxSize.cx, state.maxSize.cy};
+        resize.grid = config->m_settings.resizeGrid;
+        const geom::Rect moveStart = geom::FromRECT(state.windowBounds);
+
+        // PREDICT_CURSOR: draw where the cursor will be when the frame is presented (about one refresh ahead)
+        const bool predict = config->m_settings.predictCursor && motionSamples;
+        const uint64_t leadNs = 1'000'000'000ull / static_cast<uint64_t>(utils::mon::GetRefreshRate(MonitorFromRect(&state.windowBounds, MONITOR_DEFAULTTONEAREST)));
+        utils::motion::Predictor predictor;
+        uint64_t samplePos = motionSamples ? motionSamples->Head() : 0;
+        const auto boundsFor = [&](geom::Point cursor) {
+            if (state.action == OverlayAction::Move)
+                return geom::ToRECT(geom::MoveTo(moveStart, {state.dragOffset.x, state.dragOffset.y}, cursor));
+            if (state.action == OverlayAction::Resize)
+                return geom::ToRECT(geom::Resize(resize, cursor));
+            return RECT{};
+        };
+
+        POINT lastPt{LONG_MIN, LONG_MIN};
+        uint8_t lastMode = geom::Free;
+        uint32_t inputEpoch = 0;
+        // a fresh state (new drag started before this one was seen to end) restarts the setup above
+        overlay.PreRender([&] { return !st.stop_requested() && currentAction.load(std::memory_order_acquire) != OverlayAction::None && !stateBuffer.Fresh(); },
           [&] {
+              // taken before reading the cursor so a sample that lands mid-frame still wakes waitInput
+              inputEpoch = inputWake.Epoch();
               if (!latestMousePos)
-                  return;
+                  return false;
 
               POINT pt = latestMousePos->load(std::memory_order_relaxed);
-
-              RECT newBounds{};
-              if (state.action == OverlayAction::Move) {
-                  RECT r = state.windowBounds;
-                  int w = r.right - r.left;
-                  int h = r.bottom - r.top;
-                  newBounds = {pt.x - state.dragOffset.x, pt.y - state.dragOffset.y, pt.x - state.dragOffset.x + w, pt.y - state.dragOffset.y + h};
-              } else if (state.action == OverlayAction::Resize) {
-                  int dx = pt.x - state.resizeStartCursor.x;
-                  int dy = pt.y - state.resizeStartCursor.y;
-
-                  RECT r = state.resizeStartRect;
-                  RECT nb = r;
-
-                  switch (state.resizeCorner) {
-                      case ResizeCorner::TopLeft:
-                          nb.left += dx;
-                          nb.top += dy;
-                          break;
-                      case ResizeCorner::TopRight:
-                          nb.right += dx;
-                          nb.top += dy;
-                          break;
-                      case ResizeCorner::BottomLeft:
-                          nb.left += dx;
-                          nb.bottom += dy;
-                          break;
-                      case ResizeCorner::BottomRight:
-                          nb.right += dx;
-                          nb.bottom += dy;
-                          break;
-                      default:
-                          break;
-                  }
-
-                  // Clamp width/height
-                  int newW = nb.right - nb.left;
-                  int newH = nb.bottom - nb.top;
-
-                  if (newW < state.minSize.cx) {
-                      if (state.resizeCorner == ResizeCorner::TopLeft || state.resizeCorner == ResizeCorner::BottomLeft)
-                          nb.left = nb.right - state.minSize.cx;
-                      else
-                          nb.right = nb.left + state.minSize.cx;
-                  }
-                  if (newH < state.minSize.cy) {
-                      if (state.resizeCorner == ResizeCorner::TopLeft || state.resizeCorner == ResizeCorner::TopRight)
-                          nb.top = nb.bottom - state.minSize.cy;
-                      else
-                          nb.bottom = nb.top + state.minSize.cy;
-                  }
-
-                  if (state.maxSize.cx > 0 && (nb.right - nb.left) > state.maxSize.cx) {
-                      if (state.resizeCorner == ResizeCorner::TopLeft || state.resizeCorner == ResizeCorner::BottomLeft)
-                          nb.left = nb.right - state.maxSize.cx;
-                      else
-                          nb.right = nb.left + state.maxSize.cx;
-                  }
-
-                  if (state.maxSize.cy > 0 && (nb.bottom - nb.top) > state.maxSize.cy) {
-                      if (state.resizeCorner == ResizeCorner::TopLeft || state.resizeCorner == ResizeCorner::TopRight)
-                          nb.top = nb.bottom - state.maxSize.cy;
-                      else
-                          nb.bottom = nb.top + state.maxSize.cy;
-                  }
-
-                  newBounds = nb;
+              const geom::Point cursor{pt.x, pt.y};
+              geom::Point drawCursor = cursor;
+              if (predict) {
+                  samplePos = motionSamples->ReadSince(samplePos, [&](const utils::motion::Sample& s) { predictor.Update(s); });
+                  const auto q = predictor.Predict(input::NowNs() + leadNs);
+                  drawCursor = {static_cast<int32_t>(std::lround(q.x)), static_cast<int32_t>(std::lround(q.y))};
               }
 
-              overlayBounds.store(newBounds, std::memory_order_relaxed);
-              RECT renderRect = {newBounds.left + state.visualOffset.left,
-                newBounds.top + state.visualOffset.top,
-                newBounds.right + state.visualOffset.right,
-                newBounds.bottom + state.visualOffset.bottom};
+              // modifier variants, picked up with the next cursor sample
+              resize.mode = ResizeModifiers();
+              const bool moved = drawCursor.x != lastPt.x || drawCursor.y != lastPt.y || resize.mode != lastMode;
+              lastPt = {drawCursor.x, drawCursor.y};
+              lastMode = resize.mode;
 
-              overlay.Move(renderRect.left, renderRect.top);
-              overlay.Resize(renderRect.right - renderRect.left, renderRect.bottom - renderRect.top);
-          });
+              // the window itself always goes where the real cursor is, only the outline leads
+              const RECT newBounds = boundsFor(cursor);
+              const RECT drawBounds = predict ? boundsFor(drawCursor) : newBounds;
 
-        overlay.Hide();
+              boundsBuffer.Write({newBounds, stateGeneration});
+              if (state.live && moved) {
+                  liveBuffer.Write({state.target, state.appKey, newBounds, stateGeneration});
+                  liveWake.Notify();
+              }
+              RECT renderRect = {drawBounds.left + state.visualOffset.left,
+                drawBounds.top + state.visualOffset.top,
+                drawBounds.right + state.visualOffset.right,
+                drawBounds.bottom + state.visualOffset.bottom};
 
-        lock.lock();
+              overlay.SetGeometry(renderRect);
+              return moved;
+          },
+          [&] { inputWake.Wait(inputEpoch); });
+
+        overlay.Hide();
     }
 }
\ No newline at end of file
@@ -1,13 +1,15 @@
 #pragma once
 
 #include <atomic>
-#include <condition_variable>
-#include <mutex>
 #include <thread>
 
 #include "overlay.hpp"
+#include "wakeup.hpp"
 #include "settings/config.hpp"
 #include "settings/action_types.hpp"
+#include "tripleBuffer.hpp"
+#include "utils/drag_geometry.hpp"
+#include "utils/motion_predictor.hpp"
 
 enum class OverlayAction { None, Move, Resize };
 
@@ -21,33 +23,85 @@ struct OverlayState {
     ResizeCorner resizeCorner = ResizeCorner::BottomRight;
     SIZE minSize = {1, 1};
     SIZE maxSize = {INT_MAX, INT_MAX};
+    HWND target = nullptr; // window being dragged
+    uint64_t appKey = 0;   // identifies the target's process for live throttling
+    bool live = false;     // LIVE_RESIZE: apply geometry to the target during the drag
 };
 
+// RECT/POINT and ResizeCorner <-> the portable geometry kernel
+namespace utils::geom {
+inline Rect FromRECT(const RECT& r) {
+    return {r.left, r.top, r.right, r.bottom};
+}
+inline RECT ToRECT(const Rect& r) {
+    return {r.left, r.top, r.right, r.bottom};
+}
+inline Corner FromResizeCorner(ResizeCorner c) {
+    return c == ResizeCorner::None ? Corner::BottomRight : static_cast<Corner>(static_cast<int>(c) - 1);
+}
+inline ResizeCorner ToResizeCorner(Corner c) {
+    return static_cast<ResizeCorner>(static_cast<int>(c) + 1);
+}
+} // namespace utils::geom
+
 class OverlayController {
   public:
-    OverlayController(HINSTANCE hi, Config* cfg, std::atomic<POINT>* mousePos);
+    OverlayController(HINSTANCE hi, Config* cfg, std::atomic<POINT>* mousePos, const utils::motion::CursorRing* samples);
     ~OverlayController();
 
+    // Reactor thread only: UpdateState, ClearState, GetLatestBounds, CommitBounds
     void UpdateState(const OverlayState& state);
     void ClearState();
+    // Moves the target to the final drag bounds (through the live applier in live mode)
+    void CommitBounds(HWND target);
+    // Hook thread: a new cursor sample is available, wakes an idle overlay frame loop
+    void NotifyInput() noexcept {
+        if (IsActive())
+            inputWake.Notify();
+    }
 
-    RECT GetLatestBounds() const { return overlayBounds.load(std::memory_order_relaxed); }
+    RECT GetLatestBounds();
     bool IsActive() const { return currentAction.load(std::memory_order_acquire) != OverlayAction::None; }
 
   private:
     void OverlayLoop(std::stop_token st);
+    void LiveLoop(std::stop_token st);
 
     HINSTANCE hInstance;
     Config* config = nullptr;
     std::atomic<POINT>* latestMousePos = nullptr;
+    const utils::motion::CursorRing* motionSamples = nullptr; // written by the mouse hook
 
     std::jthread overlayThread;
 
-    std::condition_variable overlayCv;
-    std::mutex overlayCvMutex;
+    // Generation tags which UpdateState a bounds value belongs to
+    struct StateSlot {
+        OverlayState state;
+        uint32_t generation = 0;
+    };
+    struct BoundsSlot {
+        RECT bounds{};
+        uint32_t generation = 0;
+    };
+    struct LiveSlot {
+        HWND target = nullptr;
+        uint64_t appKey = 0;
+        RECT bounds{};
+        uint32_t generation = 0;
+    };
 
-    OverlayState overlayState{};
+    TripleBuffer<StateSlot> stateBuffer;   // reactor -> overlay
+    TripleBuffer<BoundsSlot> boundsBuffer; // overlay -> reactor
+    uint32_t generation = 0;               // reactor thread
+    OverlayState requested{};              // reactor thread, last UpdateState
     std::atomic<OverlayAction> currentAction{OverlayAction::None};
-    std::atomic<RECT> overlayBounds{};
+
+    Wakeup inputWake; // cursor samples, state changes and stop
+
+    // Live mode: a separate thread applies bounds so slow apps never stall the overlay frames
+    TripleBuffer<LiveSlot> liveBuffer;  // overlay -> live applier, per-frame bounds
+    TripleBuffer<LiveSlot> finalBuffer; // reactor -> live applier, bounds on release
+    Wakeup liveWake;
+    std::jthread liveThread; // last: stopped before the buffers go away
 };
 
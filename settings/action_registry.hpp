@@ -91,10 +91,13 @@ X(SendWinCombo,          SendWinComboParams,   ParseWinCombo)   \
 X(Run,                   RunProcessParams,     ParseRun)        \
 X(SetResolution,         SetResolutionParams,  ParseRes)        \
 X(CycleAudioDevice,      std::monostate,       ParseNone)       \
+X(DumpLatency,           std::monostate,       ParseNone)       \
 X(MoveWindowLeftHalf,    std::monostate,       ParseNone)       \
 X(MoveWindowRightHalf,   std::monostate,       ParseNone)       \
 X(MoveWindowToLeftMon,   std::monostate,       ParseNone)       \
 X(MoveWindowToRightMon,  std::monostate,       ParseNone)       \
+X(MoveWindowToUpMon,     std::monostate,       ParseNone)       \
+X(MoveWindowToDownMon,   std::monostate,       ParseNone)       \
 
 // Row and wrappers
 
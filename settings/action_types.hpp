@@ -8,6 +8,8 @@
 #include <windows.h>
 #include <d2d1.h>
 
+#include "window_rules.hpp"
+
 // ---------- Common small types ----------
 
 // Modifiers bitmask
@@ -39,6 +41,9 @@ namespace std {
 // Resize hint
 enum class ResizeCorner { None, TopLeft, TopRight, BottomLeft, BottomRight };
 
+// Persistent borders: none, the focused window, or every window
+enum class BorderMode { Off, Active, All };
+
 // ---------- Action parameter structs ----------
 
 struct SendWinComboParams { UINT vk{}; bool shift = false; };
@@ -79,5 +84,14 @@ struct Settings {
     int padding = 20;
 
     UINT SUPER = 0;             // required super key (VK)
+    int sequenceTimeoutMs = 1000; // max gap between keys of a leader sequence
+    bool persistentMouseHook = false; // MOUSE_HOOK = PERSISTENT: keep the hook installed, gate capture on SUPER
+    bool softwareRenderer = false;    // RENDERER = SOFTWARE: CPU rasterizer + UpdateLayeredWindow instead of Direct2D
+    int resizeGrid = 16;              // RESIZE_GRID: snap step while ALT is held during a resize
+    bool liveResize = false;          // LIVE_RESIZE: move/resize the window during the drag, throttled per app
+    bool predictCursor = false;       // PREDICT_CURSOR: draw the drag outline at the extrapolated cursor
+    BorderMode borders = BorderMode::Off; // BORDERS: persistent borders outside of drags
+    D2D1_COLOR_F inactiveColor{0.35f, 0.35f, 0.35f, 1.f}; // INACTIVE_COLOR: unfocused windows with BORDERS = ALL
+    rules::RuleSet windowRules;       // [rules], compiled (built-in defaults without the section)
     ResizeCorner resize_corner = ResizeCorner::None;
 };
\ No newline at end of file
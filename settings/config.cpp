@@ -11,6 +11,7 @@
 #include <fstream>
 #include <sstream>
 #include <algorithm>
+#include <map>
 
 // Default config
 static constexpr const char* default_config = R"(
@@ -27,11 +28,14 @@ static constexpr const char* default_config = R"(
 #	Run
 #	SetResolution
 #	CycleAudioDevice
+#	DumpLatency
 #
 #	MoveWindowLeftHalf
 #	MoveWindowRightHalf
 #	MoveWindowToLeftMon
 #	MoveWindowToRightMon
+#	MoveWindowToUpMon
+#	MoveWindowToDownMon
 #
 #
 #   SendWinCombo		<key> [,shift(1/0)]
@@ -46,6 +50,9 @@ static constexpr const char* default_config = R"(
 #   CycleAudioDevice
 #		- Cycles enabled playback devices
 #
+#   DumpLatency
+#		- Writes input latency percentiles to latency.txt
+#
 #	Modifiers:
 #	SHIFT LSHIFT RSHIFT
 #	CONTROL LCONTROL RCONTROL
@@ -53,11 +60,31 @@ static constexpr const char* default_config = R"(
 #
 #	Format:
 #	[Modifier+] <Key> = <Dispatcher> [,arg1, arg2...]
+#	[Modifier+] <Key> [Modifier+] <Key> ... = <Dispatcher>   # leader sequence, keys pressed one after another
+#	[Modifier+] <Key> = Submap, <name>                     # use the binds of [submap:<name>] until SUPER is released
+#	[Modifier+] <Key> = Submap, reset                      # back to [binds]
 #	HEXCOLOR = 00FF00 -> RED 0: GREEN: 255 BLUE: 0
 #
 #	[settings]
 #	SUPER = VK_KEY required
+#	SEQUENCE_TIMEOUT = <ms> max gap between the keys of a sequence (default 1000)
+#	MOUSE_HOOK = ONDEMAND | PERSISTENT   install the mouse hook per SUPER press, or keep it installed and gate it
+#	RENDERER = D2D | SOFTWARE   draw the border with Direct2D, or rasterize it on the CPU (read at startup)
+#	RESIZE_GRID = <px> size step while ALT is held during a resize (SHIFT keeps aspect, CTRL resizes from the centre)
+#	LIVE_RESIZE = true | false   apply the geometry to the window while dragging (slow apps get fewer updates)
+#	PREDICT_CURSOR = true | false   draw the drag outline where the cursor is expected at present time
+#	BORDERS = OFF | ACTIVE | ALL   keep a border around the focused window, or around every window
+#	INACTIVE_COLOR = <HEXCOLOR> border of unfocused windows with BORDERS = ALL (COLOR is used for the focused one)
 #	COLOR = <HEXCOLOR> [, HEXCOLOR Gradient, GradientAngle:float(ignored if rotating), isRotating:bool, rotationSpeed deg/s:float]
+#
+#	[rules]
+#	<field:pattern> [field:pattern ...] = Ignore | Float | Minimize | Size, <width>, <height>
+#	fields: exe, class, title (glob * ? or /regex/, case-insensitive, "quote" patterns with spaces)
+#	        style:<FLAG> / style:!<FLAG>  (CAPTION THICKFRAME POPUP TOPMOST TOOLWINDOW ...)
+#	Ignore: no drags or window dispatchers   Float: snaps keep the window size
+#	Minimize: KillWindow minimizes instead   Size: snaps use this size, no resize drag or maximize
+#	Every matching rule applies, in file order; the first matching Size wins.
+#	Without a [rules] section the three rules below apply.
 
 [settings]
 SUPER = LWIN # REQUIRED
@@ -66,6 +93,11 @@ BORDER = 3
 RESIZE_CORNER = BOTTOMRIGHT # CLOSEST TOPLEFT TOPRIGHT BOTTOMLEFT BOTTOMRIGH
 PADDING = 16
 
+[rules]
+exe:cs2.exe = Ignore
+exe:obs64.exe = Minimize
+exe:psst.exe = Minimize
+
 [binds]
 Q = KillWindow
 SHIFT+Q = ForceKillWindow
@@ -90,6 +122,10 @@ LSHIFT+LEFT = MoveWindowToLeftMon
 LSHIFT+RIGHT = MoveWindowToRightMon
 LSHIFT+LEFT = FullScreenPadded
 LSHIFT+RIGHT = FullScreenPadded
+LSHIFT+UP = MoveWindowToUpMon
+LSHIFT+DOWN = MoveWindowToDownMon
+LSHIFT+UP = FullScreenPadded
+LSHIFT+DOWN = FullScreenPadded
 
 F7 = CycleAudioDevice
 F1 = MsgBox, Hello World,Wow
@@ -98,6 +134,17 @@ RETURN = Run, wt.exe
 LSHIFT+RETURN = Run, wt.exe, 1
 SHIFT+F6 = SetResolution, 1440x1080@360
 SHIFT+F7 = SetResolution, 1920x1080@240
+
+# Sequences / submaps
+# G W = Run, wt.exe
+# M = Submap, monitors
+#
+# [submap:monitors]
+# LEFT = MoveWindowToLeftMon
+# RIGHT = MoveWindowToRightMon
+# UP = MoveWindowToUpMon
+# DOWN = MoveWindowToDownMon
+# ESCAPE = Submap, reset
 )";
 
 // Utilities
@@ -128,6 +175,29 @@ static std::vector<KeyEvent> ExpandLeftRightModifiers(const KeyEvent& base) {
     return out;
 }
 
+// Cartesian product of the per-key expansions: "SHIFT+G W" -> {LSHIFT+G W, RSHIFT+G W}
+static std::vector<std::vector<KeyEvent>> ExpandSequence(const std::vector<KeyEvent>& seq) {
+    std::vector<std::vector<KeyEvent>> out{{}};
+    for (const KeyEvent& step : seq) {
+        std::vector<std::vector<KeyEvent>> next;
+        for (const KeyEvent& k : ExpandLeftRightModifiers(step)) {
+            for (const auto& prefix : out) {
+                next.push_back(prefix);
+                next.back().push_back(k);
+            }
+        }
+        out = std::move(next);
+    }
+    return out;
+}
+
+// Applied when the config has no [rules] section (these used to be hard-coded)
+static const std::vector<rules::RuleLine> g_defaultRules = {
+  {"exe:cs2.exe", "Ignore"},
+  {"exe:obs64.exe", "Minimize"},
+  {"exe:psst.exe", "Minimize"},
+};
+
 // Settings parsers
 using SettingParser = std::function<void(Settings&, const std::string&)>;
 static const std::unordered_map<std::string, SettingParser> g_settingParsers = {
@@ -152,6 +222,29 @@ static const std::unordered_map<std::string, SettingParser> g_settingParsers = {
     }},
   {"SUPER", [](Settings& s, const std::string& val) { s.SUPER = parse::VK(val); }},
   {"PADDING", [](Settings& s, const std::string& val) { s.padding = parse::Int(val); }},
+  {"SEQUENCE_TIMEOUT", [](Settings& s, const std::string& val) { s.sequenceTimeoutMs = parse::Int(val); }},
+  {"RESIZE_GRID", [](Settings& s, const std::string& val) { s.resizeGrid = parse::Int(val); }},
+  {"LIVE_RESIZE", [](Settings& s, const std::string& val) { s.liveResize = parse::Bool(val); }},
+  {"PREDICT_CURSOR", [](Settings& s, const std::string& val) { s.predictCursor = parse::Bool(val); }},
+  {"MOUSE_HOOK",
+    [](Settings& s, const std::string& val) {
+        std::string v = val;
+        parse::ToUpper(v);
+        s.persistentMouseHook = (v == "PERSISTENT");
+    }},
+  {"BORDERS",
+    [](Settings& s, const std::string& val) {
+        std::string v = val;
+        parse::ToUpper(v);
+        s.borders = v == "ALL" ? BorderMode::All : (v == "ACTIVE" ? BorderMode::Active : BorderMode::Off);
+    }},
+  {"INACTIVE_COLOR", [](Settings& s, const std::string& val) { s.inactiveColor = parse::Color(val); }},
+  {"RENDERER",
+    [](Settings& s, const std::string& val) {
+        std::string v = val;
+        parse::ToUpper(v);
+        s.softwareRenderer = (v == "SOFTWARE");
+    }},
   {"BORDER", [](Settings& s, const std::string& val) { s.borderThickness = parse::Float(val); }},
   {"RESIZE_CORNER",
     [](Settings& s, const std::string& val) {
@@ -175,8 +268,26 @@ bool Config::LoadConfig(const std::string& filename) {
     std::istream* in = nullptr;
 
     m_keybinds.clear();
+    m_submaps.assign(1, "");
     m_settings = {};
 
+    // (submap, packed sequence) -> index into m_keybinds, so repeated lines append actions
+    std::map<std::pair<uint16_t, std::vector<uint16_t>>, size_t> bindIndex;
+    std::vector<std::string> submapTargets; // per bind, resolved once every section is known
+    std::vector<rules::RuleLine> ruleLines;
+    bool hasRules = false;
+    uint16_t currentSubmap = 0;
+
+    auto sequenceName = [this](const std::vector<KeyEvent>& seq) {
+        std::string name;
+        for (const KeyEvent& k : seq) {
+            if (!name.empty())
+                name.push_back(' ');
+            name += ModMaskToString(k.modMask) + parse::VKToString(k.vk);
+        }
+        return name;
+    };
+
     if (file.is_open()) {
         in = &file;
     } else {
@@ -191,7 +302,7 @@ bool Config::LoadConfig(const std::string& filename) {
         in = &fallback;
     }
 
-    enum class Section { None, Binds, Settings } current = Section::None;
+    enum class Section { None, Binds, Settings, Rules } current = Section::None;
     std::string raw;
     while (std::getline(*in, raw)) {
         std::string line = parse::Trim(raw);
@@ -200,14 +311,34 @@ bool Config::LoadConfig(const std::string& filename) {
 
         if (line == "[binds]") {
             current = Section::Binds;
+            currentSubmap = 0;
+            continue;
+        }
+        if (line.starts_with("[submap:") && line.back() == ']') {
+            const std::string name = parse::Trim(line.substr(8, line.size() - 9));
+            auto it = std::find(m_submaps.begin() + 1, m_submaps.end(), name);
+            if (it == m_submaps.end()) {
+                m_submaps.push_back(name);
+                it = m_submaps.end() - 1;
+            }
+            current = Section::Binds;
+            currentSubmap = static_cast<uint16_t>(it - m_submaps.begin());
             continue;
         }
         if (line == "[settings]") {
             current = Section::Settings;
             continue;
         }
+        if (line == "[rules]") {
+            current = Section::Rules;
+            hasRules = true;
+            continue;
+        }
+        if (current == Section::Rules && line.starts_with('#'))
+            continue;
 
-        size_t eq = line.find('=');
+        // rule patterns may contain '=', actions never do
+        size_t eq = current == Section::Rules ? line.rfind('=') : line.find('=');
         if (eq == std::string::npos)
             continue;
 
@@ -216,8 +347,8 @@ bool Config::LoadConfig(const std::string& filename) {
 
         switch (current) {
             case Section::Binds: {
-                KeyEvent keyEvent{};
-                if (!ParseKeyWithModifiers(keyStr, keyEvent))
+                std::vector<KeyEvent> sequence;
+                if (!ParseKeySequence(keyStr, sequence))
                     break;
 
                 auto parts = parse::SplitAndTrimParts(valueStr);
@@ -227,21 +358,44 @@ bool Config::LoadConfig(const std::string& filename) {
                 // Do NOT uppercase action name; table is case-sensitive: "FullScreen", "Run", etc.
                 // parse::ToUpper(parts[0]); // removed
 
-                std::string info;
-                auto act = ParseActionFromParts(parts, info);
-                if (!act)
+                // Submap is handled here rather than in the registry: it changes keymap state, not the system
+                const bool isSubmap = parts[0] == "Submap";
+                if (isSubmap && parts.size() < 2)
                     break;
 
-                for (const KeyEvent& k : ExpandLeftRightModifiers(keyEvent)) {
-                    auto& vec = m_keybinds[k];
-                    const std::string keyName = parse::VKToString(k.vk);
-                    const std::string modMaskStr = ModMaskToString(k.modMask);
-                    if (vec.full()) {
-                        LOG_W("Key Combo: {}{} Already Has 4 Dispatchers", modMaskStr, keyName);
+                std::string info;
+                std::optional<Action> act;
+                if (!isSubmap) {
+                    act = ParseActionFromParts(parts, info);
+                    if (!act)
+                        break;
+                }
+
+                for (const auto& seq : ExpandSequence(sequence)) {
+                    std::vector<uint16_t> packed;
+                    for (const KeyEvent& k : seq)
+                        packed.push_back(KeyTrie::KeyCode(k.vk, k.modMask));
+
+                    auto [it, inserted] = bindIndex.try_emplace({currentSubmap, std::move(packed)}, m_keybinds.size());
+                    if (inserted) {
+                        m_keybinds.push_back(KeyBind{currentSubmap, seq, {}, -1});
+                        submapTargets.emplace_back();
+                    }
+                    KeyBind& bind = m_keybinds[it->second];
+                    std::string& target = submapTargets[it->second];
+                    const std::string name = sequenceName(seq);
+
+                    if (isSubmap ? !bind.actions.empty() : !target.empty()) {
+                        LOG_W("Key Combo: {} Mixes Submap And Dispatchers", name);
+                    } else if (isSubmap) {
+                        target = parts[1];
+                        LOG_CONFIG("Bind: {} -> Submap {}", name, target);
+                    } else if (bind.actions.full()) {
+                        LOG_W("Key Combo: {} Already Has 4 Dispatchers", name);
                     } else {
-                        vec.push_back(*act); // returns false if >4;
+                        bind.actions.push_back(*act); // returns false if >4;
 
-                        LOG_CONFIG("Bind: {}{} -> {} {}", modMaskStr, keyName, parts[0], (info.empty() ? "" : info));
+                        LOG_CONFIG("Bind: {} -> {} {}", name, parts[0], (info.empty() ? "" : info));
                     }
                 }
             } break;
@@ -253,10 +407,36 @@ bool Config::LoadConfig(const std::string& filename) {
                 }
             } break;
 
+            case Section::Rules:
+                ruleLines.push_back({keyStr, valueStr});
+                break;
+
             default:
                 break;
         }
     }
+    const std::vector<rules::RuleLine>& activeRules = hasRules ? ruleLines : g_defaultRules;
+    for (const auto& [i, why] : m_settings.windowRules.Build(activeRules))
+        LOG_W("Rule: {} = {} Skipped, {}", activeRules[i].matchers, activeRules[i].action, why);
+    LOG_CONFIG("Compiled {} window rules", m_settings.windowRules.size());
+
+    for (size_t i = 0; i < m_keybinds.size(); ++i) {
+        const std::string& target = submapTargets[i];
+        if (target.empty())
+            continue;
+        if (target == "reset") {
+            m_keybinds[i].enterSubmap = 0;
+        } else if (auto it = std::find(m_submaps.begin() + 1, m_submaps.end(), target); it != m_submaps.end()) {
+            m_keybinds[i].enterSubmap = static_cast<int32_t>(it - m_submaps.begin());
+        } else {
+            LOG_W("Key Combo: {} Unknown Submap: {}", sequenceName(m_keybinds[i].sequence), target);
+        }
+    }
+
+    for (size_t i : m_bindTable.Build(m_keybinds, m_submaps.size()))
+        LOG_W("Key Combo: {} Conflicts With A Shorter Or Longer Bind", sequenceName(m_keybinds[i].sequence));
+    LOG_CONFIG("Compiled {} binds, {} submaps into keybind table", m_bindTable.size(), m_submaps.size() - 1);
+
     // replace: return m_settings.SUPER != 0;
 
     if (m_settings.SUPER == 0) {
@@ -285,6 +465,19 @@ bool Config::LoadConfig(const std::string& filename) {
 }
 
 // Helpers
+bool Config::ParseKeySequence(const std::string& s, std::vector<KeyEvent>& out) {
+    out.clear();
+    std::istringstream ss(s);
+    std::string step;
+    while (ss >> step) {
+        KeyEvent k{};
+        if (!ParseKeyWithModifiers(step, k))
+            return false;
+        out.push_back(k);
+    }
+    return !out.empty();
+}
+
 bool Config::ParseKeyWithModifiers(const std::string& s, KeyEvent& out) {
     out.modMask = 0;
     std::string keyStr = s;
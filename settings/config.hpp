@@ -1,20 +1,27 @@
 #pragma once
 #include "action_types.hpp"
 #include "action_vec.hpp"
+#include "keybind_table.hpp"
 #include <unordered_map>
 #include <string>
+#include <vector>
 
 using Actions4 = FixedActions<Action, 4>;
+using KeyBind = BasicKeyBind<KeyEvent, Actions4>;
+using KeybindTable = BasicKeybindTable<KeyEvent, Actions4>;
 
 class Config {
 public:
-    std::unordered_map<KeyEvent, Actions4> m_keybinds;
+    std::vector<KeyBind> m_keybinds;
+    std::vector<std::string> m_submaps{""}; // [submap:name] sections, 0 = [binds]
+    KeybindTable m_bindTable;               // compiled from m_keybinds, used on the input path
     Settings m_settings;
 
     bool LoadConfig(const std::string& filename = "config.ini");
 
 private:
     static bool ParseKeyWithModifiers(const std::string& s, KeyEvent& out);
+    static bool ParseKeySequence(const std::string& s, std::vector<KeyEvent>& out);
 
     inline std::string ModMaskToString(uint8_t m) {
         std::string out;
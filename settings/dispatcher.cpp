@@ -8,20 +8,26 @@
 
 #include "../utils/dwm.hpp"
 #include "../utils/mon.hpp"
+#include "../utils/latency.hpp"
+#include "../utils/render_stats.hpp"
 
+#include <atomic>
+#include <fstream>
 #include <thread>
 #include <Windows.h>
 #include <userenv.h>
 #pragma comment(lib, "Userenv.lib")
 
 namespace dispatcher {
-void KillWindow() {
+void KillWindow(const Settings* st) {
     HWND hwnd = utils::GetFilteredWindow();
     if (!hwnd)
         return;
 
-    std::wstring name = utils::GetProcessName(hwnd);
-    if (!_wcsicmp(name.c_str(), L"obs64.exe") || !_wcsicmp(name.c_str(), L"psst.exe")) {
+    const rules::Result rule = utils::MatchRules(st->windowRules, hwnd);
+    if (rule.Has(rules::Ignore))
+        return;
+    if (rule.Has(rules::Minimize)) {
         PostMessageW(hwnd, WM_SYSCOMMAND, SC_MINIMIZE, 0);
     } else {
         PostMessageW(hwnd, WM_CLOSE, 0, 0);
@@ -43,17 +49,23 @@ void ForceKillWindow() {
     }
 }
 
-void FullScreen() {
+// Ignore and fixed-size windows are never maximized or stretched
+static bool Resizable(const Settings* st, HWND hwnd) {
+    const rules::Result rule = utils::MatchRules(st->windowRules, hwnd);
+    return !rule.Has(rules::Ignore) && !rule.Has(rules::FixedSize);
+}
+
+void FullScreen(const Settings* st) {
     HWND hwnd = utils::GetFilteredWindow();
-    if (!hwnd)
+    if (!hwnd || !Resizable(st, hwnd))
         return;
 
     ShowWindow(hwnd, SW_MAXIMIZE);
 }
 
-void FullScreenToggle() {
+void FullScreenToggle(const Settings* st) {
     HWND hwnd = utils::GetFilteredWindow();
-    if (!hwnd)
+    if (!hwnd || !Resizable(st, hwnd))
         return;
 
     WINDOWPLACEMENT wp{sizeof(WINDOWPLACEMENT)};
@@ -64,7 +76,7 @@ void FullScreenToggle() {
 
 void FullScreenPadded(const Settings* st) {
     HWND hwnd = utils::GetFilteredWindow();
-    if (!hwnd)
+    if (!hwnd || !Resizable(st, hwnd))
         return;
 
     utils::SetBorderedWindow(hwnd, st->padding);
@@ -203,15 +215,72 @@ void MsgBox(const RunProcessParams& p) {
     std::thread([&] { MessageBoxW(nullptr, p.args.c_str(), p.path.c_str(), MB_OK); }).detach();
 }
 
+bool WriteLatencyReport() {
+    const std::string report = utils::latency::Report() + utils::render::Report();
+    std::ofstream out("latency.txt", std::ios::trunc);
+    if (!out.is_open()) {
+        LOG_E("Failed to write latency.txt");
+        return false;
+    }
+    out << report;
+    LOG_I("Latency stats written to latency.txt\n{}", report);
+    return true;
+}
+
+// Bound as an action this runs on the reactor: formatting and file I/O go to a short-lived worker
+// (the histograms are relaxed atomics, readable from any thread). Presses while a dump is still
+// being written are dropped.
+void DumpLatency() {
+    static std::atomic<bool> writing{false};
+    if (writing.exchange(true, std::memory_order_acq_rel))
+        return;
+    std::thread([] {
+        SET_THREAD_NAME("Latency Dump");
+        WriteLatencyReport();
+        writing.store(false, std::memory_order_release);
+    }).detach();
+}
+
 void CycleAudioDevice() {
     AudioDeviceManager::Instance().cycleToNextDevice();
 }
 
-void MoveWindow(MoveDir dir, bool toMonitor, int padding) {
+// Float keeps the current size, FixedSize uses the rule's; either is centred in the snap target
+static RECT FitToRule(const rules::Result& rule, const RECT& target, const RECT& current, const RECT& work) {
+    LONG w, h;
+    if (rule.Has(rules::FixedSize)) {
+        w = rule.width;
+        h = rule.height;
+    } else if (rule.Has(rules::Float)) {
+        w = current.right - current.left;
+        h = current.bottom - current.top;
+    } else {
+        return target;
+    }
+    const POINT c = utils::Center(target);
+    const RECT r{c.x - w / 2, c.y - h / 2, c.x - w / 2 + w, c.y - h / 2 + h};
+    return utils::ClampRectToWork(r, work);
+}
+
+static utils::spatial::Dir ToDir(MoveDir dir) {
+    switch (dir) {
+        case MoveDir::Left: return utils::spatial::Dir::Left;
+        case MoveDir::Right: return utils::spatial::Dir::Right;
+        case MoveDir::Up: return utils::spatial::Dir::Up;
+        default: return utils::spatial::Dir::Down;
+    }
+}
+
+void MoveWindow(MoveDir dir, bool toMonitor, const Settings* st) {
     HWND hwnd = utils::GetFilteredWindow();
     if (!hwnd)
         return;
 
+    const rules::Result rule = utils::MatchRules(st->windowRules, hwnd);
+    if (rule.Has(rules::Ignore))
+        return;
+    const int padding = st->padding;
+
     RECT wr{}, vrCur{};
     if (!utils::dwm::GetVisual(hwnd, wr, vrCur))
         return;
@@ -224,9 +293,9 @@ void MoveWindow(MoveDir dir, bool toMonitor, int padding) {
 
     // Explicit monitor move
     if (toMonitor) {
-        const HMONITOR dest = utils::mon::FindAdjacentMonitorX(hwnd, dir == MoveDir::Right);
+        const HMONITOR dest = utils::mon::FindAdjacentMonitor(hwnd, ToDir(dir));
         if (!dest)
-            return; // no monitor further in that direction
+            return; // no monitor sharing that edge
 
         const RECT dstWork = utils::mon::GetWorkArea(dest);
 
@@ -237,6 +306,8 @@ void MoveWindow(MoveDir dir, bool toMonitor, int padding) {
 
         RECT vrNew{dstWork.left + dx, dstWork.top + dy, dstWork.left + dx + vw, dstWork.top + dy + vh};
         vrNew = utils::ClampRectToWork(vrNew, dstWork);
+        if (rule.Has(rules::FixedSize))
+            vrNew = FitToRule(rule, vrNew, vrCur, dstWork);
 
         if (wasMax)
             ShowWindow(hwnd, SW_RESTORE);
@@ -248,6 +319,9 @@ void MoveWindow(MoveDir dir, bool toMonitor, int padding) {
         return;
     }
 
+    if (dir != MoveDir::Left && dir != MoveDir::Right)
+        return; // no top/bottom halves
+
     // Half-snap on current monitor (with padding)
     const LONG mid = (curWork.left + curWork.right) / 2;
     const LONG edgePad = padding;
@@ -257,8 +331,11 @@ void MoveWindow(MoveDir dir, bool toMonitor, int padding) {
     RECT rightHalf{mid + centerPad, curWork.top + edgePad, curWork.right - edgePad, curWork.bottom - edgePad};
 
     // Already snapped to requested side -> try adjacent monitor on closest half, else do nothing
-    if ((dir == MoveDir::Left && utils::mon::RectApproxEq(vrCur, leftHalf)) || (dir == MoveDir::Right && utils::mon::RectApproxEq(vrCur, rightHalf))) {
-        const HMONITOR dest = utils::mon::FindAdjacentMonitorX(hwnd, dir == MoveDir::Right);
+    // (floating and fixed-size windows compare against where the snap would have put them)
+    const RECT leftSnap = FitToRule(rule, leftHalf, vrCur, curWork);
+    const RECT rightSnap = FitToRule(rule, rightHalf, vrCur, curWork);
+    if ((dir == MoveDir::Left && utils::mon::RectApproxEq(vrCur, leftSnap)) || (dir == MoveDir::Right && utils::mon::RectApproxEq(vrCur, rightSnap))) {
+        const HMONITOR dest = utils::mon::FindAdjacentMonitor(hwnd, ToDir(dir));
         if (!dest)
             return; // no monitor in that direction
 
@@ -280,7 +357,7 @@ void MoveWindow(MoveDir dir, bool toMonitor, int padding) {
             target.right = dstMid - centerPad;
         }
 
-        utils::dwm::SetWindowVisualRect(hwnd, utils::ClampRectToWork(target, dstWork));
+        utils::dwm::SetWindowVisualRect(hwnd, FitToRule(rule, utils::ClampRectToWork(target, dstWork), vrCur, dstWork));
         utils::dwm::CenterCursorInVisual(hwnd);
         return;
     }
@@ -292,6 +369,7 @@ void MoveWindow(MoveDir dir, bool toMonitor, int padding) {
         vrTarget.right = vrTarget.left;
     if (vrTarget.bottom < vrTarget.top)
         vrTarget.bottom = vrTarget.top;
+    vrTarget = FitToRule(rule, vrTarget, vrCur, curWork);
 
     if (wasMax)
         ShowWindow(hwnd, SW_RESTORE);
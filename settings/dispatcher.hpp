@@ -4,10 +4,10 @@
 #include "action_types.hpp"
 
 namespace dispatcher {
-    void KillWindow();
+    void KillWindow(const Settings* st);
     void ForceKillWindow();
-    void FullScreen();
-    void FullScreenToggle();
+    void FullScreen(const Settings* st);
+    void FullScreenToggle(const Settings* st);
     void FullScreenPadded(const Settings* st);
     void SendWinCombo(const SendWinComboParams& p);
 
@@ -21,14 +21,21 @@ namespace dispatcher {
     void IPCMessage(const IPCMessageParams& p);
     void MsgBox(const RunProcessParams& p);
 
-    enum class MoveDir : uint8_t { Left, Right };
+    // writes utils::latency::Report() to latency.txt in the working directory, on the calling thread
+    bool WriteLatencyReport();
+    // same, posted to a worker so the reactor never formats or touches the disk
+    void DumpLatency();
+
+    enum class MoveDir : uint8_t { Left, Right, Up, Down }; // Up/Down: monitor moves only
 
     // core
-    void MoveWindow(MoveDir dir, bool toMonitor, int padding = 0);
+    void MoveWindow(MoveDir dir, bool toMonitor, const Settings* st);
 
     // wrappers for binds
-    inline void MoveWindowLeftHalf(const Settings* st) { MoveWindow(MoveDir::Left, false, st->padding); }
-    inline void MoveWindowRightHalf(const Settings* st) { MoveWindow(MoveDir::Right, false, st->padding); }
-    inline void MoveWindowToLeftMon(const Settings* st) { MoveWindow(MoveDir::Left, true, st->padding); }
-    inline void MoveWindowToRightMon(const Settings* st) { MoveWindow(MoveDir::Right, true, st->padding); }
+    inline void MoveWindowLeftHalf(const Settings* st) { MoveWindow(MoveDir::Left, false, st); }
+    inline void MoveWindowRightHalf(const Settings* st) { MoveWindow(MoveDir::Right, false, st); }
+    inline void MoveWindowToLeftMon(const Settings* st) { MoveWindow(MoveDir::Left, true, st); }
+    inline void MoveWindowToRightMon(const Settings* st) { MoveWindow(MoveDir::Right, true, st); }
+    inline void MoveWindowToUpMon(const Settings* st) { MoveWindow(MoveDir::Up, true, st); }
+    inline void MoveWindowToDownMon(const Settings* st) { MoveWindow(MoveDir::Down, true, st); }
 }
\ No newline at end of file
@@ -0,0 +1,203 @@
+// key_trie.hpp
+#pragma once
+// Keybind DFA: submap roots are dense (vk, modMask) tables, sequence interior nodes
+// live in one open-addressed edge table. Every step is O(1).
+// Portable (no Windows headers) so the state machine can be driven by scripted key streams.
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// 0 = unbound, 0x8000 | node = transition, otherwise action index + 1
+struct KeyTarget {
+    uint16_t raw = 0;
+
+    static constexpr uint16_t kNodeBit = 0x8000;
+    static constexpr uint16_t kMaxIndex = 0x7FFE;
+
+    static constexpr KeyTarget Action(uint16_t index) noexcept {
+        return {static_cast<uint16_t>(index + 1)};
+    }
+    static constexpr KeyTarget Node(uint16_t node) noexcept {
+        return {static_cast<uint16_t>(kNodeBit | node)};
+    }
+
+    constexpr bool IsNone() const noexcept {
+        return raw == 0;
+    }
+    constexpr bool IsNode() const noexcept {
+        return (raw & kNodeBit) != 0;
+    }
+    constexpr bool IsAction() const noexcept {
+        return raw != 0 && !IsNode();
+    }
+    constexpr uint16_t Index() const noexcept {
+        return IsNode() ? static_cast<uint16_t>(raw & ~kNodeBit) : static_cast<uint16_t>(raw - 1);
+    }
+    constexpr bool operator==(const KeyTarget&) const = default;
+};
+
+class KeyTrie {
+  public:
+    static constexpr size_t kModCombos = 64;
+    static constexpr size_t kRootSlots = 256 * kModCombos;
+
+    static constexpr uint16_t KeyCode(uint32_t vk, uint8_t modMask) noexcept {
+        return static_cast<uint16_t>(((vk & 0xFF) << 6) | (modMask & (kModCombos - 1)));
+    }
+
+    void Clear() {
+        isRoot.clear();
+        rootTable.clear();
+        rootSlots.clear();
+        building.clear();
+        edges.clear();
+        edgeMask = 0;
+    }
+
+    // Submap roots get a dense table. Node 0 is the default map.
+    uint16_t AddRoot() {
+        const uint16_t n = static_cast<uint16_t>(isRoot.size());
+        isRoot.push_back(true);
+        rootTable.push_back(static_cast<uint32_t>(rootSlots.size() / kRootSlots));
+        rootSlots.resize(rootSlots.size() + kRootSlots, 0);
+        return n;
+    }
+
+    uint16_t AddNode() {
+        const uint16_t n = static_cast<uint16_t>(isRoot.size());
+        isRoot.push_back(false);
+        rootTable.push_back(0);
+        return n;
+    }
+
+    size_t NodeCount() const noexcept {
+        return isRoot.size();
+    }
+
+    bool IsRoot(uint16_t node) const noexcept {
+        return node < isRoot.size() && isRoot[node];
+    }
+
+    void SetEdge(uint16_t node, uint16_t key, KeyTarget t) {
+        if (isRoot[node])
+            rootSlots[rootTable[node] * kRootSlots + key] = t.raw;
+        else
+            building[EdgeKey(node, key)] = t;
+    }
+
+    KeyTarget Step(uint16_t node, uint16_t key) const noexcept {
+        if (node >= isRoot.size())
+            return {};
+        if (isRoot[node])
+            return {rootSlots[rootTable[node] * kRootSlots + key]};
+
+        if (!edgeMask) {
+            // still building
+            auto it = building.find(EdgeKey(node, key));
+            return it == building.end() ? KeyTarget{} : it->second;
+        }
+        const uint32_t k = EdgeKey(node, key);
+        for (size_t i = Hash(k) & edgeMask;; i = (i + 1) & edgeMask) {
+            const Edge& e = edges[i];
+            if (e.target.IsNone())
+                return {};
+            if (e.key == k)
+                return e.target;
+        }
+    }
+
+    // Flatten interior edges into the open-addressed table (load factor <= 0.5)
+    void Finalize() {
+        size_t cap = 16;
+        while (cap < building.size() * 2)
+            cap <<= 1;
+        edges.assign(cap, Edge{});
+        edgeMask = cap - 1;
+        for (const auto& [k, t] : building) {
+            size_t i = Hash(k) & edgeMask;
+            while (!edges[i].target.IsNone())
+                i = (i + 1) & edgeMask;
+            edges[i] = {k, t};
+        }
+        building.clear();
+    }
+
+  private:
+    struct Edge {
+        uint32_t key = 0;
+        KeyTarget target{};
+    };
+
+    static constexpr uint32_t EdgeKey(uint16_t node, uint16_t key) noexcept {
+        return (static_cast<uint32_t>(node) << 14) | key;
+    }
+    static constexpr size_t Hash(uint32_t k) noexcept {
+        return static_cast<size_t>((k * 0x9E3779B1u) >> 7);
+    }
+
+    std::vector<bool> isRoot;
+    std::vector<uint32_t> rootTable; // root node -> table number
+    std::vector<uint16_t> rootSlots; // kRootSlots per root
+    std::unordered_map<uint32_t, KeyTarget> building;
+    std::vector<Edge> edges;
+    size_t edgeMask = 0;
+};
+
+// Walks the trie one key at a time. Timeouts are checked lazily against the next key's
+// capture time, so the input thread never needs a timer while a sequence is pending.
+class KeySequencer {
+  public:
+    enum class Result : uint8_t { None, Pending, Submap, Action };
+
+    struct Step {
+        Result result = Result::None;
+        uint16_t index = 0; // action index for Action, root node for Submap
+    };
+
+    Step Feed(const KeyTrie& trie, uint16_t key, uint64_t nowNs, uint64_t timeoutNs) noexcept {
+        if (node != root && nowNs > deadlineNs)
+            node = root;
+
+        KeyTarget t = trie.Step(node, key);
+        if (t.IsNone() && node != root) {
+            // unmatched key aborts the sequence and is evaluated from the submap root
+            node = root;
+            t = trie.Step(node, key);
+        }
+
+        if (t.IsNone())
+            return {};
+
+        if (t.IsAction()) {
+            node = root;
+            return {Result::Action, t.Index()};
+        }
+
+        if (trie.IsRoot(t.Index())) {
+            root = node = t.Index();
+            return {Result::Submap, root};
+        }
+
+        node = t.Index();
+        deadlineNs = nowNs + timeoutNs;
+        return {Result::Pending, node};
+    }
+
+    void Reset() noexcept {
+        root = node = 0;
+        deadlineNs = 0;
+    }
+
+    uint16_t Submap() const noexcept {
+        return root;
+    }
+    bool InSequence() const noexcept {
+        return node != root;
+    }
+
+  private:
+    uint16_t root = 0;
+    uint16_t node = 0;
+    uint64_t deadlineNs = 0;
+};
@@ -0,0 +1,108 @@
+// keybind_table.hpp
+#pragma once
+// Generic over the key ({vk, modMask}) and action list types; config.hpp instantiates it with
+// KeyEvent and Actions4. Portable (no Windows headers) so the compiled table can be checked and
+// benchmarked against the old unordered_map off-target.
+#include <cstdint>
+#include <vector>
+#include "key_trie.hpp"
+
+// One parsed bind line (after L/R modifier expansion)
+template <typename Key, typename Actions>
+struct BasicKeyBind {
+    uint16_t submap = 0;       // 0 = [binds], otherwise index into Config::m_submaps
+    std::vector<Key> sequence; // one key, or a leader sequence like "G W"
+    Actions actions;
+    int32_t enterSubmap = -1;  // >= 0: bind switches submap instead of dispatching (0 = reset)
+};
+
+// Loaded binds compiled into a KeyTrie. Each submap root is a direct-indexed table of
+// 256 VKs x 64 modifier masks, so single-key binds stay one 2-byte load; sequences add
+// one open-addressed probe per extra key.
+template <typename Key, typename Actions>
+class BasicKeybindTable {
+  public:
+    using KeyBind = BasicKeyBind<Key, Actions>;
+
+    // Returns indices of binds that were skipped because they conflict with an earlier one
+    // (a prefix that is already a complete bind, or a bind that is a prefix of a longer one).
+    std::vector<size_t> Build(const std::vector<KeyBind>& binds, size_t submapCount) {
+        std::vector<size_t> skipped;
+        trie.Clear();
+        pool.clear();
+        pool.reserve(binds.size());
+
+        for (size_t i = 0; i < submapCount; ++i)
+            trie.AddRoot();
+
+        for (size_t i = 0; i < binds.size(); ++i) {
+            if (binds[i].actions.empty() && binds[i].enterSubmap < 0)
+                continue; // nothing to do (e.g. unknown submap, already reported)
+            if (!Insert(binds[i]))
+                skipped.push_back(i);
+        }
+        trie.Finalize();
+        return skipped;
+    }
+
+    const KeyTrie& Trie() const noexcept {
+        return trie;
+    }
+
+    const Actions& ActionsAt(uint16_t index) const noexcept {
+        return pool[index];
+    }
+
+    size_t size() const noexcept {
+        return pool.size();
+    }
+
+  private:
+    bool Insert(const KeyBind& b) {
+        if (b.sequence.empty() || b.submap >= trie.NodeCount())
+            return false;
+        for (const Key& k : b.sequence) {
+            if (k.vk > 0xFF)
+                return false;
+        }
+
+        uint16_t node = b.submap;
+        for (size_t i = 0; i + 1 < b.sequence.size(); ++i) {
+            const uint16_t key = KeyTrie::KeyCode(b.sequence[i].vk, b.sequence[i].modMask);
+            const KeyTarget t = trie.Step(node, key);
+            if (t.IsNone()) {
+                if (trie.NodeCount() > KeyTarget::kMaxIndex)
+                    return false;
+                const uint16_t next = trie.AddNode();
+                trie.SetEdge(node, key, KeyTarget::Node(next));
+                node = next;
+            } else if (t.IsNode() && !trie.IsRoot(t.Index())) {
+                node = t.Index();
+            } else {
+                return false; // prefix already dispatches or switches submap
+            }
+        }
+
+        const Key& last = b.sequence.back();
+        const uint16_t key = KeyTrie::KeyCode(last.vk, last.modMask);
+        const KeyTarget existing = trie.Step(node, key);
+        if (existing.IsNode() && !trie.IsRoot(existing.Index()))
+            return false; // would shadow a longer sequence
+
+        if (b.enterSubmap >= 0) {
+            if (static_cast<size_t>(b.enterSubmap) >= trie.NodeCount() || !trie.IsRoot(static_cast<uint16_t>(b.enterSubmap)))
+                return false;
+            trie.SetEdge(node, key, KeyTarget::Node(static_cast<uint16_t>(b.enterSubmap)));
+            return true;
+        }
+
+        if (pool.size() > KeyTarget::kMaxIndex)
+            return false;
+        pool.push_back(b.actions);
+        trie.SetEdge(node, key, KeyTarget::Action(static_cast<uint16_t>(pool.size() - 1)));
+        return true;
+    }
+
+    KeyTrie trie;
+    std::vector<Actions> pool;
+};
@@ -0,0 +1,434 @@
+// window_rules.hpp
+#pragma once
+// [rules]: per-window overrides, one rule per line, every matcher on the left must hold.
+//   exe:obs64.exe = Minimize                                 KillWindow minimizes instead of closing
+//   exe:cs2.exe = Ignore                                     no drags, no window dispatchers
+//   class:Chrome_WidgetWin_1 title:"*Picture in Picture*" = Float   snaps move it, keeping its size
+//   title:/^Steam( - .*)?$/ = Size, 1280, 800                snaps use this size, no resize drags
+//   style:!THICKFRAME exe:game*.exe = Ignore                 style:<FLAG> / style:!<FLAG>
+// exe/class/title take a glob (* ?) or /regex/, case-insensitive; quote patterns with spaces.
+// Every matching rule applies, in file order; the first matching Size wins.
+//
+// Compiled into a bit-parallel matcher: one bit per rule, per field the rules without a matcher
+// on it are preset, literal patterns are one hash probe for all rules at once, wildcards and
+// regexes each set their rule's bit; the window's rules are the AND over the fields.
+// Portable (no Windows headers): style flags are the WinUser.h values.
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rules {
+enum Action : uint8_t {
+    Ignore = 1 << 0,    // SUPER drags and window dispatchers leave the window alone
+    Float = 1 << 1,     // half/monitor snaps move the window at its current size
+    Minimize = 1 << 2,  // KillWindow minimizes instead of closing
+    FixedSize = 1 << 3, // snaps use width x height, resize drags and maximize are refused
+};
+
+struct Result {
+    uint8_t actions = 0;
+    int32_t width = 0; // FixedSize
+    int32_t height = 0;
+
+    bool Has(Action a) const noexcept { return (actions & a) != 0; }
+};
+
+// What a window is matched on
+struct Window {
+    std::wstring_view exe;   // image name, e.g. L"obs64.exe"
+    std::wstring_view cls;   // window class
+    std::wstring_view title;
+    uint32_t style = 0;
+    uint32_t exStyle = 0;
+};
+
+// One [rules] line
+struct RuleLine {
+    std::string matchers; // left of '='
+    std::string action;   // right of '='
+};
+
+namespace detail {
+constexpr wchar_t Fold(wchar_t c) noexcept {
+    return (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c - L'A' + L'a') : c;
+}
+
+// Case-insensitive (ASCII) glob, * and ?
+inline bool Glob(std::wstring_view pat, std::wstring_view s) noexcept {
+    size_t p = 0, i = 0, star = std::wstring_view::npos, mark = 0;
+    while (i < s.size()) {
+        if (p < pat.size() && (pat[p] == L'?' || Fold(pat[p]) == Fold(s[i]))) {
+            ++p;
+            ++i;
+        } else if (p < pat.size() && pat[p] == L'*') {
+            star = p++;
+            mark = i;
+        } else if (star != std::wstring_view::npos) {
+            p = star + 1;
+            i = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (p < pat.size() && pat[p] == L'*')
+        ++p;
+    return p == pat.size();
+}
+
+// UTF-8 config text -> UTF-16/32 (whatever wchar_t is); invalid bytes become U+FFFD
+inline std::wstring Widen(std::string_view s) {
+    std::wstring out;
+    out.reserve(s.size());
+    for (size_t i = 0; i < s.size();) {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        const int extra = c < 0x80 ? 0 : (c >> 5) == 0x6 ? 1 : (c >> 4) == 0xE ? 2 : (c >> 3) == 0x1E ? 3 : -1;
+        if (extra < 0 || i + static_cast<size_t>(extra) >= s.size()) {
+            out.push_back(L'\xFFFD');
+            ++i;
+            continue;
+        }
+        char32_t cp = extra == 0 ? c : (c & (0x3F >> extra));
+        bool ok = true;
+        for (int k = 1; k <= extra; ++k) {
+            const unsigned char cc = static_cast<unsigned char>(s[i + k]);
+            ok = ok && (cc & 0xC0) == 0x80;
+            cp = (cp << 6) | (cc & 0x3F);
+        }
+        i += ok ? extra + 1 : 1;
+        if (!ok) {
+            out.push_back(L'\xFFFD');
+        } else if (sizeof(wchar_t) == 2 && cp > 0xFFFF) {
+            cp -= 0x10000;
+            out.push_back(static_cast<wchar_t>(0xD800 + (cp >> 10)));
+            out.push_back(static_cast<wchar_t>(0xDC00 + (cp & 0x3FF)));
+        } else {
+            out.push_back(static_cast<wchar_t>(cp));
+        }
+    }
+    return out;
+}
+
+struct StyleName {
+    std::string_view name;
+    uint32_t bits;
+    bool ex;
+};
+
+inline constexpr StyleName kStyles[] = {
+  {"POPUP", 0x80000000u, false},
+  {"CHILD", 0x40000000u, false},
+  {"DISABLED", 0x08000000u, false},
+  {"MAXIMIZE", 0x01000000u, false},
+  {"CAPTION", 0x00C00000u, false},
+  {"BORDER", 0x00800000u, false},
+  {"SYSMENU", 0x00080000u, false},
+  {"THICKFRAME", 0x00040000u, false},
+  {"MINIMIZEBOX", 0x00020000u, false},
+  {"MAXIMIZEBOX", 0x00010000u, false},
+  {"TOPMOST", 0x00000008u, true},
+  {"TRANSPARENT", 0x00000020u, true},
+  {"TOOLWINDOW", 0x00000080u, true},
+  {"APPWINDOW", 0x00040000u, true},
+  {"LAYERED", 0x00080000u, true},
+  {"NOACTIVATE", 0x08000000u, true},
+};
+
+inline std::string Upper(std::string_view s) {
+    std::string out(s);
+    for (char& c : out)
+        if (c >= 'a' && c <= 'z')
+            c = static_cast<char>(c - 'a' + 'A');
+    return out;
+}
+
+inline std::string_view Trim(std::string_view s) {
+    const size_t b = s.find_first_not_of(" \t");
+    if (b == std::string_view::npos)
+        return {};
+    return s.substr(b, s.find_last_not_of(" \t") - b + 1);
+}
+} // namespace detail
+
+class RuleSet {
+  public:
+    static constexpr size_t kMaxRules = 1024;
+    using Mask = std::bitset<kMaxRules>;
+
+    // Compiles the lines, returns (line index, reason) for each rule that was skipped
+    std::vector<std::pair<size_t, std::string>> Build(const std::vector<RuleLine>& lines) {
+        *this = RuleSet{};
+        id = NextId();
+        std::vector<std::pair<size_t, std::string>> errors;
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (rules.size() == kMaxRules) {
+                errors.emplace_back(i, "too many rules");
+                continue;
+            }
+            std::string err;
+            if (!Add(lines[i], err))
+                errors.emplace_back(i, std::move(err));
+        }
+        return errors;
+    }
+
+    // Every rule matching w, merged in file order: actions add up, the first matching Size wins
+    Result Evaluate(const Window& w) const {
+        Result r{};
+        if (rules.empty())
+            return r;
+
+        // cheapest field first; wildcards/regexes only run for rules still alive
+        Mask m = used;
+        m &= fields[Exe].Match(w.exe, m);
+        m &= fields[Class].Match(w.cls, m);
+        m &= fields[Title].Match(w.title, m);
+        for (const StyleCheck& c : styleChecks) {
+            const uint32_t v = c.ex ? w.exStyle : w.style;
+            if ((v & c.set) != c.set || (v & c.clear) != 0)
+                m.reset(c.rule);
+        }
+        if (m.none())
+            return r;
+
+        for (size_t i = 0; i < rules.size(); ++i) {
+            if (!m.test(i))
+                continue;
+            if ((rules[i].actions & FixedSize) && !(r.actions & FixedSize)) {
+                r.width = rules[i].width;
+                r.height = rules[i].height;
+            }
+            r.actions |= rules[i].actions;
+        }
+        return r;
+    }
+
+    size_t size() const noexcept { return rules.size(); }
+    // Changes on every Build, for memoised results
+    uint64_t Id() const noexcept { return id; }
+
+  private:
+    enum FieldIndex { Exe, Class, Title, kFieldCount };
+
+    // lookups by wstring_view without building a key
+    struct LiteralHash {
+        using is_transparent = void;
+        size_t operator()(std::wstring_view s) const noexcept { return std::hash<std::wstring_view>{}(s); }
+    };
+
+    struct Field {
+        Mask dontCare; // rules without a matcher on this field
+        std::unordered_map<std::wstring, Mask, LiteralHash, std::equal_to<>> literals; // folded
+        std::vector<std::pair<std::wstring, size_t>> globs;
+        std::vector<std::pair<std::wregex, size_t>> regexes;
+
+        Mask Match(std::wstring_view v, const Mask& alive) const {
+            Mask m = dontCare;
+            if (!literals.empty()) {
+                // fold on the stack; longer values (long titles) fold into a heap string
+                std::array<wchar_t, 512> buf;
+                std::wstring heap;
+                wchar_t* folded = buf.data();
+                if (v.size() > buf.size()) {
+                    heap.resize(v.size());
+                    folded = heap.data();
+                }
+                for (size_t i = 0; i < v.size(); ++i)
+                    folded[i] = detail::Fold(v[i]);
+                if (auto it = literals.find(std::wstring_view{folded, v.size()}); it != literals.end())
+                    m |= it->second;
+            }
+            for (const auto& [pat, rule] : globs)
+                if (alive.test(rule) && detail::Glob(pat, v))
+                    m.set(rule);
+            for (const auto& [re, rule] : regexes)
+                if (alive.test(rule) && std::regex_search(v.begin(), v.end(), re))
+                    m.set(rule);
+            return m;
+        }
+    };
+
+    struct Rule {
+        uint8_t actions = 0;
+        int32_t width = 0;
+        int32_t height = 0;
+    };
+
+    struct StyleCheck {
+        size_t rule;
+        bool ex;
+        uint32_t set = 0;
+        uint32_t clear = 0;
+    };
+
+    static uint64_t NextId() {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // field:pattern tokens; a pattern is "quoted", /regex/ or runs to the next space
+    static bool Tokenize(std::string_view s, std::vector<std::pair<std::string, std::string>>& out, std::string& err) {
+        size_t i = 0;
+        while (true) {
+            while (i < s.size() && (s[i] == ' ' || s[i] == '\t'))
+                ++i;
+            if (i >= s.size())
+                return true;
+            const size_t colon = s.find(':', i);
+            if (colon == std::string_view::npos) {
+                err = "expected field:pattern";
+                return false;
+            }
+            std::string field = detail::Upper(s.substr(i, colon - i));
+            i = colon + 1;
+            std::string pat;
+            if (i < s.size() && (s[i] == '"' || s[i] == '/')) {
+                const char q = s[i];
+                const size_t end = s.find(q, i + 1);
+                if (end == std::string_view::npos) {
+                    err = std::string("unterminated ") + q;
+                    return false;
+                }
+                pat = std::string(s.substr(q == '/' ? i : i + 1, q == '/' ? end - i + 1 : end - i - 1));
+                i = end + 1;
+            } else {
+                const size_t end = s.find_first_of(" \t", i);
+                pat = std::string(s.substr(i, end == std::string_view::npos ? std::string_view::npos : end - i));
+                i = end == std::string_view::npos ? s.size() : end;
+            }
+            out.emplace_back(std::move(field), std::move(pat));
+        }
+    }
+
+    static bool ParseAction(std::string_view text, Rule& r, std::string& err) {
+        if (const size_t hash = text.find(" #"); hash != std::string_view::npos)
+            text = text.substr(0, hash);
+        std::vector<std::string> parts;
+        for (size_t b = 0; b <= text.size();) {
+            const size_t e = text.find(',', b);
+            parts.emplace_back(detail::Trim(text.substr(b, e == std::string_view::npos ? std::string_view::npos : e - b)));
+            if (e == std::string_view::npos)
+                break;
+            b = e + 1;
+        }
+        const std::string name = detail::Upper(parts[0]);
+        if (name == "IGNORE") {
+            r.actions = Ignore;
+        } else if (name == "FLOAT") {
+            r.actions = Float;
+        } else if (name == "MINIMIZE") {
+            r.actions = Minimize;
+        } else if (name == "SIZE" && parts.size() == 3) {
+            r.actions = FixedSize;
+            r.width = std::atoi(parts[1].c_str());
+            r.height = std::atoi(parts[2].c_str());
+            if (r.width <= 0 || r.height <= 0) {
+                err = "size needs width, height > 0";
+                return false;
+            }
+        } else {
+            err = "unknown action (Ignore, Float, Minimize, Size, w, h)";
+            return false;
+        }
+        return true;
+    }
+
+    bool Add(const RuleLine& line, std::string& err) {
+        Rule rule;
+        std::vector<std::pair<std::string, std::string>> tokens;
+        if (!ParseAction(line.action, rule, err) || !Tokenize(line.matchers, tokens, err))
+            return false;
+        if (tokens.empty()) {
+            err = "no matchers";
+            return false;
+        }
+
+        const size_t index = rules.size();
+        bool seen[kFieldCount]{};
+        StyleCheck styles[2]{{index, false}, {index, true}};
+        std::vector<std::pair<FieldIndex, std::wstring>> text;
+
+        for (auto& [name, pat] : tokens) {
+            if (name == "STYLE") {
+                const bool negate = !pat.empty() && pat[0] == '!';
+                const std::string flag = detail::Upper(negate ? std::string_view(pat).substr(1) : std::string_view(pat));
+                const detail::StyleName* found = nullptr;
+                for (const auto& s : detail::kStyles)
+                    if (s.name == flag)
+                        found = &s;
+                if (!found) {
+                    err = "unknown style " + flag;
+                    return false;
+                }
+                (negate ? styles[found->ex].clear : styles[found->ex].set) |= found->bits;
+                continue;
+            }
+
+            const FieldIndex f = name == "EXE" ? Exe : name == "CLASS" ? Class : name == "TITLE" ? Title : kFieldCount;
+            if (f == kFieldCount) {
+                err = "unknown field " + name;
+                return false;
+            }
+            if (seen[f] || pat.empty()) {
+                err = seen[f] ? "one matcher per field" : "empty pattern";
+                return false;
+            }
+            seen[f] = true;
+            text.emplace_back(f, detail::Widen(pat));
+        }
+
+        // validate everything before touching the tables
+        std::vector<std::optional<std::wregex>> compiled(text.size());
+        for (size_t i = 0; i < text.size(); ++i) {
+            const std::wstring& p = text[i].second;
+            if (p.size() >= 2 && p.front() == L'/' && p.back() == L'/') {
+                try {
+                    compiled[i].emplace(p.substr(1, p.size() - 2), std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+                } catch (const std::regex_error&) {
+                    err = "invalid regex";
+                    return false;
+                }
+            }
+        }
+
+        for (int f = 0; f < kFieldCount; ++f)
+            if (!seen[f])
+                fields[f].dontCare.set(index);
+        for (size_t i = 0; i < text.size(); ++i) {
+            Field& field = fields[text[i].first];
+            std::wstring& p = text[i].second;
+            if (compiled[i]) {
+                field.regexes.emplace_back(std::move(*compiled[i]), index);
+            } else if (p.find_first_of(L"*?") != std::wstring::npos) {
+                field.globs.emplace_back(std::move(p), index);
+            } else {
+                for (wchar_t& c : p)
+                    c = detail::Fold(c);
+                field.literals[std::move(p)].set(index);
+            }
+        }
+        for (const StyleCheck& s : styles)
+            if (s.set || s.clear)
+                styleChecks.push_back(s);
+
+        rules.push_back(rule);
+        used.set(index);
+        return true;
+    }
+
+    std::vector<Rule> rules;
+    Field fields[kFieldCount];
+    std::vector<StyleCheck> styleChecks;
+    Mask used;
+    uint64_t id = 0;
+};
+} // namespace rules
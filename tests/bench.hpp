@@ -0,0 +1,34 @@
+// tests/bench.hpp
+#pragma once
+// Shared bits for the benchmarks: a steady clock, ns-per-op from two time points, a sink that
+// keeps results alive, and the optional [rounds] argument every bench takes. Benchmarks print
+// numbers and assert nothing; they depend on the machine.
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+namespace bench {
+using Clock = std::chrono::steady_clock;
+
+inline double NsPer(Clock::time_point a, Clock::time_point b, size_t ops) {
+    return std::chrono::duration<double, std::nano>(b - a).count() / static_cast<double>(ops);
+}
+
+inline double Seconds(Clock::time_point a, Clock::time_point b) {
+    return std::chrono::duration<double>(b - a).count();
+}
+
+// argv[1] if given, else the default
+inline int Rounds(int argc, char** argv, int fallback) {
+    return argc > 1 ? std::max(1, std::atoi(argv[1])) : fallback;
+}
+
+// Results folded in here cannot be optimized away
+inline void Keep(uint64_t v) {
+    static std::atomic<uint64_t> sink{0};
+    sink.fetch_add(v, std::memory_order_relaxed);
+}
+} // namespace bench
@@ -0,0 +1,224 @@
+// tests/border_raster_test.cpp
+// Border rasterizer against golden images: a small hand-checked buffer, then larger borders
+// (rounded, two strokes, gradients, odd sizes) against a per-pixel double-precision reference of
+// the same rounded-rect distance field. The compiled kernel (see KernelName()) must stay within
+// one step per channel of the reference and of the scalar lanes.
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/border_raster.hpp"
+
+using namespace utils::raster;
+
+namespace {
+constexpr Rgba kWhite{1.f, 1.f, 1.f, 1.f};
+constexpr Rgba kRed{1.f, 0.f, 0.f, 1.f};
+constexpr Rgba kBlue{0.f, 0.f, 1.f, 0.5f};
+constexpr Rgba kClear{0.f, 0.f, 0.f, 0.f};
+
+struct Image {
+    int width, height;
+    std::vector<uint32_t> pixels;
+
+    Image(int w, int h, uint32_t fill = 0) : width(w), height(h), pixels(static_cast<size_t>(w) * h, fill) {}
+    Target AsTarget() {
+        return {pixels.data(), width, height, width};
+    }
+    uint32_t At(int x, int y) const {
+        return pixels[static_cast<size_t>(y) * width + x];
+    }
+};
+
+Border Solid(float inset, float width, float radius, Rgba c) {
+    Border b{};
+    b.strokes[0] = {inset, width, radius, c, c};
+    b.strokes[1] = {inset, 0.f, radius, kClear, kClear}; // no coverage
+    return b;
+}
+
+int Channel(uint32_t px, int shift) {
+    return static_cast<int>((px >> shift) & 0xFF);
+}
+
+// Straightforward per-pixel evaluation of the same model in double precision
+uint32_t ReferencePixel(const Border& b, int width, int height, int x, int y) {
+    const double px = x + 0.5, py = y + 0.5;
+    const double dx = b.gx2 - b.gx1, dy = b.gy2 - b.gy1, len2 = dx * dx + dy * dy;
+    const double t = len2 > 0 ? std::clamp(((px - b.gx1) * dx + (py - b.gy1) * dy) / len2, 0.0, 1.0) : 0.0;
+
+    double r = 0, g = 0, bl = 0, a = 0;
+    for (const Stroke& s : b.strokes) {
+        const double cx = width * 0.5, cy = height * 0.5;
+        const double radius = std::max(0.0, static_cast<double>(s.radius));
+        const double hx = std::max(0.0, cx - s.inset - radius), hy = std::max(0.0, cy - s.inset - radius);
+        const double qx = std::fabs(px - cx) - hx, qy = std::fabs(py - cy) - hy;
+        const double outside = std::hypot(std::max(qx, 0.0), std::max(qy, 0.0));
+        const double d = outside + std::min(std::max(qx, qy), 0.0) - radius;
+        const double cov = std::clamp(s.width * 0.5 + 0.5 - std::fabs(d), 0.0, 1.0);
+
+        const double sa = (s.start.a + (s.end.a - s.start.a) * t) * cov;
+        r = (s.start.r + (s.end.r - s.start.r) * t) * sa + r * (1 - sa);
+        g = (s.start.g + (s.end.g - s.start.g) * t) * sa + g * (1 - sa);
+        bl = (s.start.b + (s.end.b - s.start.b) * t) * sa + bl * (1 - sa);
+        a = sa + a * (1 - sa);
+    }
+    auto q = [](double v) { return static_cast<uint32_t>(v * 255.0 + 0.5); };
+    return q(bl) | q(g) << 8 | q(r) << 16 | q(a) << 24;
+}
+
+// Largest per-channel difference between two buffers (both zero outside the band)
+int MaxDiff(const Image& got, const Image& want) {
+    int worst = 0;
+    for (size_t i = 0; i < got.pixels.size(); ++i)
+        for (int shift = 0; shift < 32; shift += 8)
+            worst = std::max(worst, std::abs(Channel(got.pixels[i], shift) - Channel(want.pixels[i], shift)));
+    return worst;
+}
+
+Image Reference(const Border& b, int width, int height) {
+    Image img(width, height);
+    const int band = detail::BandWidth(b);
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x) {
+            const bool inBand = y < band || y >= height - band || x < band || x >= width - band || 2 * band >= width;
+            if (inBand)
+                img.pixels[static_cast<size_t>(y) * width + x] = ReferencePixel(b, width, height, x, y);
+        }
+    return img;
+}
+
+// Draw() with every span forced through the scalar lanes
+Image DrawScalar(const Border& b, int width, int height) {
+    Image img(width, height);
+    const detail::Prepared p = detail::Prepare(img.AsTarget(), b);
+    const int band = detail::BandWidth(b);
+    for (int y = 0; y < height; ++y) {
+        uint32_t* row = img.pixels.data() + static_cast<size_t>(y) * width;
+        if (y < band || y >= height - band || 2 * band >= width) {
+            detail::ShadeSpan<detail::VScalar>(row, 0, width, y + 0.5f, p);
+        } else {
+            detail::ShadeSpan<detail::VScalar>(row, 0, band, y + 0.5f, p);
+            detail::ShadeSpan<detail::VScalar>(row, width - band, width, y + 0.5f, p);
+        }
+    }
+    return img;
+}
+
+struct Case {
+    const char* name;
+    int width, height;
+    Border border;
+};
+
+std::vector<Case> GoldenCases() {
+    std::vector<Case> cases;
+    cases.push_back({"square", 64, 48, Solid(2.f, 3.f, 0.f, kWhite)});
+    cases.push_back({"rounded", 97, 61, Solid(4.5f, 5.f, 10.f, kRed)});
+    cases.push_back({"hairline", 33, 17, Solid(0.5f, 1.f, 3.f, kWhite)});
+    Border gradient = Solid(3.f, 4.f, 8.f, kRed);
+    gradient.strokes[0].end = kBlue;
+    gradient.gx2 = 120.f;
+    gradient.gy2 = 40.f;
+    cases.push_back({"gradient", 120, 80, gradient});
+    Border twoStrokes{};
+    twoStrokes.strokes[0] = {1.f, 2.f, 6.f, kWhite, kWhite};
+    twoStrokes.strokes[1] = {3.5f, 3.f, 4.f, kRed, kBlue};
+    twoStrokes.gy2 = 50.f;
+    cases.push_back({"two_strokes", 75, 50, twoStrokes});
+    cases.push_back({"narrow", 9, 200, Solid(1.f, 2.f, 2.f, kRed)}); // band covers whole rows
+    return cases;
+}
+} // namespace
+
+// 6x6, 2 px opaque white ring around a hollow 2x2 centre, every pixel exact. The outer corner
+// pixels sit sqrt(0.5) off the centre line: 1.5 - 0.707 = 0.793 coverage -> 0xCA
+TEST(golden_ring_6x6) {
+    Image img(6, 6);
+    const size_t written = Draw(img.AsTarget(), Solid(1.f, 2.f, 0.f, kWhite));
+    CHECK_EQ(written, 36u);
+    constexpr uint32_t W = 0xFFFFFFFF;
+    constexpr uint32_t C = 0xCACACACA;
+    const uint32_t golden[6][6] = {
+      {C, W, W, W, W, C},
+      {W, W, W, W, W, W},
+      {W, W, 0, 0, W, W},
+      {W, W, 0, 0, W, W},
+      {W, W, W, W, W, W},
+      {C, W, W, W, W, C},
+    };
+    for (int y = 0; y < 6; ++y)
+        for (int x = 0; x < 6; ++x)
+            CHECK_EQ(img.At(x, y), golden[y][x]);
+}
+
+TEST(golden_images_match_reference) {
+    for (const Case& c : GoldenCases()) {
+        Image img(c.width, c.height);
+        Draw(img.AsTarget(), c.border);
+        const int diff = MaxDiff(img, Reference(c.border, c.width, c.height));
+        if (diff > 1)
+            std::fprintf(stderr, "    %s (%s): max channel diff %d\n", c.name, KernelName(), diff);
+        CHECK(diff <= 1);
+    }
+}
+
+TEST(wide_kernel_matches_scalar_lanes) {
+    for (const Case& c : GoldenCases()) {
+        Image wide(c.width, c.height);
+        Draw(wide.AsTarget(), c.border);
+        CHECK(MaxDiff(wide, DrawScalar(c.border, c.width, c.height)) <= 1);
+    }
+}
+
+TEST(premultiplied_output) {
+    for (const Case& c : GoldenCases()) {
+        Image img(c.width, c.height);
+        Draw(img.AsTarget(), c.border);
+        bool ok = true;
+        for (uint32_t px : img.pixels) {
+            const int a = Channel(px, 24);
+            ok &= Channel(px, 0) <= a && Channel(px, 8) <= a && Channel(px, 16) <= a;
+        }
+        CHECK(ok);
+    }
+}
+
+TEST(interior_is_never_written) {
+    constexpr uint32_t kSentinel = 0x12345678;
+    const Border b = Solid(2.f, 3.f, 6.f, kRed);
+    Image img(80, 60, kSentinel);
+    const size_t written = Draw(img.AsTarget(), b);
+    const int band = detail::BandWidth(b);
+    size_t touched = 0;
+    for (int y = 0; y < img.height; ++y)
+        for (int x = 0; x < img.width; ++x) {
+            const bool inBand = y < band || y >= img.height - band || x < band || x >= img.width - band;
+            if (!inBand)
+                CHECK_EQ(img.At(x, y), kSentinel);
+            else
+                ++touched;
+        }
+    CHECK_EQ(written, touched);
+}
+
+TEST(gradient_runs_along_axis) {
+    Border b = Solid(1.f, 2.f, 0.f, kRed);
+    b.strokes[0].end = {0.f, 0.f, 1.f, 1.f};
+    b.gx2 = 100.f;
+    Image img(100, 20);
+    Draw(img.AsTarget(), b);
+    // top edge: red fades out and blue fades in left to right
+    CHECK(Channel(img.At(2, 0), 16) > Channel(img.At(97, 0), 16));
+    CHECK(Channel(img.At(2, 0), 0) < Channel(img.At(97, 0), 0));
+    CHECK_EQ(Channel(img.At(50, 0), 24), 255);
+}
+
+TEST(empty_target_draws_nothing) {
+    CHECK_EQ(Draw(Target{}, Solid(1.f, 2.f, 0.f, kWhite)), 0u);
+    uint32_t px = 0;
+    CHECK_EQ(Draw(Target{&px, 0, 1, 0}, Solid(1.f, 2.f, 0.f, kWhite)), 0u);
+}
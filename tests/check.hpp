@@ -0,0 +1,76 @@
+// tests/check.hpp
+#pragma once
+// Minimal test harness for the portable headers: TEST(name) registers a case, CHECK/CHECK_EQ
+// report a failure and keep going, main() runs every case and returns non-zero on any failure.
+// Each test source is its own executable (include this once, it defines main) so ctest can run
+// and time them out independently.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace check {
+struct Case {
+    const char* name;
+    void (*fn)();
+};
+
+inline std::vector<Case>& Cases() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+inline int& Failures() {
+    static int failures = 0;
+    return failures;
+}
+
+struct Register {
+    Register(const char* name, void (*fn)()) { Cases().push_back({name, fn}); }
+};
+
+inline void Fail(const char* file, int line, const char* expr) {
+    ++Failures();
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expr);
+}
+
+// Stress cases scale their iteration counts by this (HYPRWIN_TEST_SCALE, default 1)
+inline int Scale() {
+    const char* s = std::getenv("HYPRWIN_TEST_SCALE");
+    const int v = s ? std::atoi(s) : 1;
+    return v > 0 ? v : 1;
+}
+} // namespace check
+
+#define TEST(name)                                                    \
+    static void name();                                               \
+    static const check::Register name##_registered{#name, &name};     \
+    static void name()
+
+#define CHECK(cond)                                      \
+    do {                                                 \
+        if (!(cond))                                     \
+            check::Fail(__FILE__, __LINE__, #cond);      \
+    } while (0)
+
+#define CHECK_EQ(a, b)                                                                         \
+    do {                                                                                       \
+        const auto va_ = (a);                                                                  \
+        const auto vb_ = (b);                                                                  \
+        if (!(va_ == vb_)) {                                                                   \
+            check::Fail(__FILE__, __LINE__, #a " == " #b);                                     \
+            std::fprintf(stderr, "    %lld vs %lld\n", static_cast<long long>(va_), static_cast<long long>(vb_)); \
+        }                                                                                      \
+    } while (0)
+
+int main(int argc, char** argv) {
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    for (const check::Case& c : check::Cases()) {
+        if (only && std::strcmp(only, c.name) != 0)
+            continue;
+        const int before = check::Failures();
+        c.fn();
+        std::printf("%-40s %s\n", c.name, check::Failures() == before ? "ok" : "FAILED");
+    }
+    return check::Failures() == 0 ? 0 : 1;
+}
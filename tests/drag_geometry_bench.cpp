@@ -0,0 +1,181 @@
+// tests/drag_geometry_bench.cpp
+// The drag kernel per cursor sample against the switch-per-corner code it replaced (the old
+// OverlayLoop lambda and MouseManager's float corner pick, kept here verbatim on plain ints):
+//  - fixed corner: one drag, every sample through the same corner (predictable branches)
+//  - mixed corners: a new drag and corner every few samples (what the selects are for)
+//  - each modifier variant of Resize, and PickCorner against the float version
+// Prints ns per call; nothing is asserted, numbers depend on the machine.
+//   drag_geometry_bench [rounds]
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "utils/drag_geometry.hpp"
+
+using namespace utils::geom;
+
+namespace {
+namespace legacy {
+Rect Resize(const ResizeParams& p, Point pt) {
+    const int32_t dx = pt.x - p.startCursor.x;
+    const int32_t dy = pt.y - p.startCursor.y;
+    Rect nb = p.start;
+    switch (p.corner) {
+        case Corner::TopLeft:
+            nb.left += dx;
+            nb.top += dy;
+            break;
+        case Corner::TopRight:
+            nb.right += dx;
+            nb.top += dy;
+            break;
+        case Corner::BottomLeft:
+            nb.left += dx;
+            nb.bottom += dy;
+            break;
+        case Corner::BottomRight:
+            nb.right += dx;
+            nb.bottom += dy;
+            break;
+    }
+    const bool left = p.corner == Corner::TopLeft || p.corner == Corner::BottomLeft;
+    const bool top = p.corner == Corner::TopLeft || p.corner == Corner::TopRight;
+    if (nb.Width() < p.minSize.cx) {
+        if (left)
+            nb.left = nb.right - p.minSize.cx;
+        else
+            nb.right = nb.left + p.minSize.cx;
+    }
+    if (nb.Height() < p.minSize.cy) {
+        if (top)
+            nb.top = nb.bottom - p.minSize.cy;
+        else
+            nb.bottom = nb.top + p.minSize.cy;
+    }
+    if (p.maxSize.cx > 0 && nb.Width() > p.maxSize.cx) {
+        if (left)
+            nb.left = nb.right - p.maxSize.cx;
+        else
+            nb.right = nb.left + p.maxSize.cx;
+    }
+    if (p.maxSize.cy > 0 && nb.Height() > p.maxSize.cy) {
+        if (top)
+            nb.top = nb.bottom - p.maxSize.cy;
+        else
+            nb.bottom = nb.top + p.maxSize.cy;
+    }
+    return nb;
+}
+
+Corner PickCorner(const Rect& r, Point pt) {
+    const int32_t w = r.Width(), h = r.Height();
+    if (w <= 0 || h <= 0)
+        return Corner::BottomRight;
+    const float xRatio = static_cast<float>(pt.x - r.left) / w;
+    const float yRatio = static_cast<float>(pt.y - r.top) / h;
+    if (xRatio < 0.5f)
+        return yRatio < 0.5f ? Corner::TopLeft : Corner::BottomLeft;
+    return yRatio < 0.5f ? Corner::TopRight : Corner::BottomRight;
+}
+} // namespace legacy
+
+struct Drag {
+    ResizeParams params;
+    Point offset;
+};
+
+uint64_t Fold(const Rect& r) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(r.left ^ r.top) + static_cast<uint32_t>(r.right ^ r.bottom));
+}
+
+// drags.size() drags, samplesPerDrag cursor samples each, walking away from the grab point
+template <typename F>
+double PerSample(const std::vector<Drag>& drags, const std::vector<Point>& walk, uint32_t samplesPerDrag, int rounds, F&& f) {
+    uint64_t sum = 0;
+    size_t calls = 0;
+    const auto t0 = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (size_t d = 0; d < drags.size(); ++d) {
+            const Drag& drag = drags[d];
+            for (uint32_t i = 0; i < samplesPerDrag; ++i) {
+                const Point& step = walk[(d * samplesPerDrag + i) % walk.size()];
+                const Point cursor{drag.params.startCursor.x + step.x, drag.params.startCursor.y + step.y};
+                sum += Fold(f(drag, cursor));
+                ++calls;
+            }
+        }
+    const auto t1 = bench::Clock::now();
+    bench::Keep(sum);
+    return bench::NsPer(t0, t1, calls);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = bench::Rounds(argc, argv, 20);
+    std::mt19937 rng(11);
+    const auto rand = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+
+    // 4096 drags with random windows, grab points, limits and corners
+    std::vector<Drag> drags(4096);
+    for (Drag& d : drags) {
+        const int x = rand(-1920, 3000), y = rand(0, 900), w = rand(200, 1600), h = rand(150, 1000);
+        d.params.start = {x, y, x + w, y + h};
+        d.params.startCursor = {x + rand(0, w - 1), y + rand(0, h - 1)};
+        d.params.corner = PickCorner(d.params.start, d.params.startCursor);
+        d.params.minSize = {rand(100, 300), rand(80, 200)};
+        d.params.maxSize = rand(0, 1) ? Size{rand(1200, 2400), rand(900, 1400)} : Size{};
+        d.offset = {d.params.startCursor.x - x, d.params.startCursor.y - y};
+    }
+    std::vector<Point> walk(1 << 16);
+    for (Point& p : walk)
+        p = {rand(-600, 600), rand(-400, 400)};
+
+    const auto kernel = [](const Drag& d, Point c) { return Resize(d.params, c); };
+    const auto old = [](const Drag& d, Point c) { return legacy::Resize(d.params, c); };
+    const auto move = [](const Drag& d, Point c) { return MoveTo(d.params.start, d.offset, c); };
+
+    std::printf("%-22s %10s %10s\n", "ns/sample", "kernel", "switch");
+    const std::vector<Drag> one(1, drags[0]);
+    constexpr uint32_t kOneLongDrag = 1 << 18, kShortDrags = 8;
+    std::printf("%-22s %10.2f %10.2f\n", "resize fixed corner", PerSample(one, walk, kOneLongDrag, rounds, kernel),
+      PerSample(one, walk, kOneLongDrag, rounds, old));
+    std::printf("%-22s %10.2f %10.2f\n", "resize mixed corners", PerSample(drags, walk, kShortDrags, rounds * 8, kernel),
+      PerSample(drags, walk, kShortDrags, rounds * 8, old));
+    std::printf("%-22s %10.2f\n", "move", PerSample(drags, walk, kShortDrags, rounds * 8, move));
+
+    std::printf("%-22s %10s\n", "resize mode", "kernel");
+    const struct {
+        const char* name;
+        uint8_t mode;
+    } modes[] = {{"free", Free}, {"aspect", AspectLock}, {"centered", Centered}, {"snap", Snap}, {"aspect+centered+snap", AspectLock | Centered | Snap}};
+    for (const auto& m : modes) {
+        std::vector<Drag> moded = drags;
+        for (Drag& d : moded)
+            d.params.mode = m.mode;
+        std::printf("%-22s %10.2f\n", m.name, PerSample(moded, walk, kShortDrags, rounds * 8, kernel));
+    }
+
+    // corner pick at drag start
+    uint64_t sum = 0;
+    const size_t picks = drags.size() * 64 * static_cast<size_t>(rounds);
+    auto t0 = bench::Clock::now();
+    for (size_t i = 0; i < picks; ++i) {
+        const Drag& d = drags[i % drags.size()];
+        const Point& s = walk[i % walk.size()];
+        sum += static_cast<uint64_t>(PickCorner(d.params.start, {d.params.startCursor.x + s.x / 4, d.params.startCursor.y + s.y / 4}));
+    }
+    auto t1 = bench::Clock::now();
+    const double pickKernel = bench::NsPer(t0, t1, picks);
+    t0 = bench::Clock::now();
+    for (size_t i = 0; i < picks; ++i) {
+        const Drag& d = drags[i % drags.size()];
+        const Point& s = walk[i % walk.size()];
+        sum += static_cast<uint64_t>(legacy::PickCorner(d.params.start, {d.params.startCursor.x + s.x / 4, d.params.startCursor.y + s.y / 4}));
+    }
+    t1 = bench::Clock::now();
+    bench::Keep(sum);
+    std::printf("%-22s %10.2f %10.2f\n", "pick corner", pickKernel, bench::NsPer(t0, t1, picks));
+    return 0;
+}
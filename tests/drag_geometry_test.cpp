@@ -0,0 +1,187 @@
+// tests/drag_geometry_test.cpp
+// Property tests for the drag kernel over random starts, cursors, corners, modes and limits:
+// limits always hold, anchored edges stay put, centred resizes keep their centre, snapped and
+// aspect-locked sizes land where promised, and a drag that has not moved changes nothing.
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+
+#include "check.hpp"
+#include "utils/drag_geometry.hpp"
+
+using namespace utils::geom;
+
+namespace {
+struct Random {
+    std::mt19937 rng{5};
+    int32_t operator()(int32_t lo, int32_t hi) {
+        return std::uniform_int_distribution<int32_t>(lo, hi)(rng);
+    }
+};
+
+ResizeParams RandomParams(Random& r, uint8_t mode) {
+    ResizeParams p;
+    const int32_t x = r(-4000, 4000), y = r(-2000, 2000);
+    p.start = {x, y, x + r(1, 3000), y + r(1, 2000)};
+    p.startCursor = {r(p.start.left, p.start.right), r(p.start.top, p.start.bottom)};
+    p.corner = PickCorner(p.start, p.startCursor);
+    p.mode = mode;
+    p.grid = r(2, 64);
+    if (r(0, 1)) {
+        p.minSize = {r(1, 400), r(1, 300)};
+        p.maxSize = {r(0, 1) ? r(p.minSize.cx, 5000) : 0, r(0, 1) ? r(p.minSize.cy, 4000) : 0};
+    }
+    return p;
+}
+
+Point RandomCursor(Random& r, const ResizeParams& p) {
+    return {p.startCursor.x + r(-5000, 5000), p.startCursor.y + r(-5000, 5000)};
+}
+
+constexpr int kSamples = 20000;
+} // namespace
+
+TEST(limits_always_hold) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        const ResizeParams p = RandomParams(r, static_cast<uint8_t>(r(0, 7)));
+        const Rect out = Resize(p, RandomCursor(r, p));
+        const int32_t minW = std::max(1, p.minSize.cx), minH = std::max(1, p.minSize.cy);
+        ok &= out.Width() >= minW && out.Height() >= minH;
+        if (p.maxSize.cx > 0)
+            ok &= out.Width() <= p.maxSize.cx;
+        if (p.maxSize.cy > 0)
+            ok &= out.Height() <= p.maxSize.cy;
+    }
+    CHECK(ok);
+}
+
+TEST(anchored_edges_stay_put) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        const ResizeParams p = RandomParams(r, static_cast<uint8_t>(r(0, 1) ? Free : AspectLock | Snap));
+        const Rect out = Resize(p, RandomCursor(r, p));
+        ok &= MovesRight(p.corner) ? out.left == p.start.left : out.right == p.start.right;
+        ok &= MovesBottom(p.corner) ? out.top == p.start.top : out.bottom == p.start.bottom;
+    }
+    CHECK(ok);
+}
+
+TEST(free_edges_follow_the_cursor) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        ResizeParams p = RandomParams(r, Free);
+        p.minSize = {1, 1};
+        p.maxSize = {};
+        const Point c = RandomCursor(r, p);
+        const Rect out = Resize(p, c);
+        const int32_t dx = c.x - p.startCursor.x, dy = c.y - p.startCursor.y;
+        // wherever the size did not hit the 1 px floor, the moving edge moved exactly with the cursor
+        if (out.Width() > 1)
+            ok &= MovesRight(p.corner) ? out.right == p.start.right + dx : out.left == p.start.left + dx;
+        if (out.Height() > 1)
+            ok &= MovesBottom(p.corner) ? out.bottom == p.start.bottom + dy : out.top == p.start.top + dy;
+    }
+    CHECK(ok);
+}
+
+TEST(centered_keeps_the_centre) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        const ResizeParams p = RandomParams(r, static_cast<uint8_t>(Centered | (r(0, 1) ? Snap : 0) | (r(0, 1) ? AspectLock : 0)));
+        const Rect out = Resize(p, RandomCursor(r, p));
+        // doubled centres, so the half pixel of an odd size difference is visible
+        ok &= std::abs((out.left + out.right) - (p.start.left + p.start.right)) <= 1;
+        ok &= std::abs((out.top + out.bottom) - (p.start.top + p.start.bottom)) <= 1;
+    }
+    CHECK(ok);
+}
+
+TEST(snap_lands_on_the_grid) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        const ResizeParams p = RandomParams(r, Snap);
+        const Rect out = Resize(p, RandomCursor(r, p));
+        const int32_t minW = std::max(1, p.minSize.cx), minH = std::max(1, p.minSize.cy);
+        // a snapped size only leaves the grid when a limit overrides it
+        ok &= out.Width() % p.grid == 0 || out.Width() == minW || out.Width() == p.maxSize.cx;
+        ok &= out.Height() % p.grid == 0 || out.Height() == minH || out.Height() == p.maxSize.cy;
+    }
+    CHECK(ok);
+}
+
+TEST(aspect_lock_keeps_the_ratio) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        ResizeParams p = RandomParams(r, AspectLock);
+        p.minSize = {1, 1};
+        p.maxSize = {};
+        const Rect out = Resize(p, RandomCursor(r, p));
+        const int64_t w0 = p.start.Width(), h0 = p.start.Height();
+        if (out.Width() == 1 || out.Height() == 1)
+            continue; // floored: no ratio left to keep
+        // truncated to whole pixels on the derived axis
+        const int64_t err = std::llabs(static_cast<int64_t>(out.Width()) * h0 - static_cast<int64_t>(out.Height()) * w0);
+        ok &= err < std::max(w0, h0);
+    }
+    CHECK(ok);
+}
+
+TEST(unmoved_drag_is_identity) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        ResizeParams p = RandomParams(r, static_cast<uint8_t>(r(0, 1) ? Free : Centered | AspectLock));
+        p.minSize = {1, 1};
+        p.maxSize = {};
+        ok &= Resize(p, p.startCursor) == p.start;
+    }
+    CHECK(ok);
+}
+
+TEST(width_grows_monotonically_with_the_cursor) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        const ResizeParams p = RandomParams(r, static_cast<uint8_t>(r(0, 1) ? Free : Snap));
+        const Point c = RandomCursor(r, p);
+        const int32_t step = MovesRight(p.corner) ? r(1, 200) : -r(1, 200);
+        ok &= Resize(p, {c.x + step, c.y}).Width() >= Resize(p, c).Width();
+    }
+    CHECK(ok);
+}
+
+TEST(move_keeps_size_and_grab_offset) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        const ResizeParams p = RandomParams(r, Free);
+        const Point grab{p.startCursor.x - p.start.left, p.startCursor.y - p.start.top};
+        const Point c = RandomCursor(r, p);
+        const Rect out = MoveTo(p.start, grab, c);
+        ok &= out.Width() == p.start.Width() && out.Height() == p.start.Height();
+        ok &= out.left + grab.x == c.x && out.top + grab.y == c.y;
+        ok &= MoveTo(p.start, grab, p.startCursor) == p.start;
+    }
+    CHECK(ok);
+}
+
+TEST(pick_corner_is_the_cursor_quadrant) {
+    Random r;
+    bool ok = true;
+    for (int i = 0; i < kSamples * check::Scale(); ++i) {
+        const ResizeParams p = RandomParams(r, Free);
+        const Corner c = PickCorner(p.start, p.startCursor);
+        ok &= MovesRight(c) == (2 * (p.startCursor.x - p.start.left) >= p.start.Width());
+        ok &= MovesBottom(c) == (2 * (p.startCursor.y - p.start.top) >= p.start.Height());
+    }
+    CHECK(ok);
+    CHECK(PickCorner({0, 0, 0, 10}, {0, 0}) == Corner::BottomRight);
+}
@@ -0,0 +1,132 @@
+// tests/frame_pacer_test.cpp
+// The overlay loop policy driven headless by a fake clock: a drag that only moves the window
+// (nothing to redraw) must still be paced at the refresh period, idle frames drop to the idle cap
+// and a still cursor parks on input.
+#include <cstdint>
+
+#include "check.hpp"
+#include "utils/frame_pacer.hpp"
+
+using namespace utils::pacing;
+
+namespace {
+struct FakeClock {
+    uint64_t now = 1'000'000'000;
+    uint64_t sleeps = 0;
+    uint64_t Now() const { return now; }
+    void SleepUntil(uint64_t ns) {
+        ++sleeps;
+        if (ns > now)
+            now = ns;
+    }
+};
+
+constexpr uint64_t kPeriod = 1'000'000'000ull / 144;
+
+PacerConfig Config() {
+    PacerConfig c;
+    c.periodNs = kPeriod;
+    c.idlePeriodNs = 33'333'333;
+    c.idleAfterNs = 250'000'000;
+    return c;
+}
+
+struct Counts {
+    uint64_t drawn = 0, skipped = 0, waited = 0;
+    void Add(Frame f) {
+        (f == Frame::Drawn ? drawn : f == Frame::Skipped ? skipped : waited)++;
+    }
+};
+} // namespace
+
+TEST(move_only_drag_is_paced_at_refresh) {
+    FakeClock clock;
+    FramePacer pacer(clock, Config());
+    Counts n;
+    const uint64_t start = clock.now;
+    // the size never changes during a Move drag, so nothing is drawn; vsync is on
+    for (int i = 0; i < 144; ++i) {
+        clock.now += 200'000; // onFrame + SetWindowPos
+        n.Add(pacer.Step(true, false, true));
+    }
+    CHECK_EQ(n.drawn, 0u);
+    CHECK_EQ(n.skipped, 144u);
+    CHECK_EQ(clock.sleeps, 144u);
+    // 144 frames at 144 Hz: one second, not 144 * 0.2 ms
+    const uint64_t elapsed = clock.now - start;
+    CHECK(elapsed >= 143 * kPeriod && elapsed <= 145 * kPeriod);
+    CHECK_EQ(pacer.GetStats().missed, 0u);
+}
+
+TEST(drawn_frames_rebase_on_vsync_present) {
+    FakeClock clock;
+    FramePacer pacer(clock, Config());
+    Counts n;
+    for (int i = 0; i < 10; ++i) {
+        clock.now += kPeriod; // Present blocked until vblank
+        n.Add(pacer.Step(true, true, true));
+    }
+    CHECK_EQ(n.drawn, 10u);
+    CHECK_EQ(clock.sleeps, 0u); // no double wait on top of the present
+}
+
+TEST(software_present_sleeps_to_slot) {
+    FakeClock clock;
+    FramePacer pacer(clock, Config());
+    const uint64_t start = clock.now;
+    for (int i = 0; i < 10; ++i) {
+        clock.now += 100'000;
+        pacer.Step(true, true, false);
+    }
+    CHECK_EQ(clock.sleeps, 10u);
+    CHECK(clock.now - start >= 10 * kPeriod);
+}
+
+TEST(idle_drag_drops_to_idle_cap) {
+    FakeClock clock;
+    FramePacer pacer(clock, Config());
+    pacer.Step(true, true, false);
+    // gradient rotation keeps drawing but the cursor is still
+    uint64_t before = 0;
+    for (int i = 0; i < 60; ++i) {
+        before = clock.now;
+        clock.now += kPeriod; // Present blocked until vblank
+        pacer.Step(false, true, true);
+    }
+    CHECK(pacer.GetStats().idleFrames > 0);
+    CHECK_EQ(clock.now - before, Config().idlePeriodNs);
+}
+
+TEST(still_cursor_waits_on_input) {
+    FakeClock clock;
+    FramePacer pacer(clock, Config());
+    Counts n;
+    int waits = 0;
+    const auto waitInput = [&] {
+        ++waits;
+        clock.now += 500'000'000; // user rests for half a second
+    };
+    for (int i = 0; i < 5; ++i)
+        n.Add(pacer.Step(false, false, true, waitInput));
+    CHECK_EQ(n.waited, 5u);
+    CHECK_EQ(waits, 5);
+    CHECK_EQ(clock.sleeps, 0u);
+    CHECK_EQ(pacer.GetStats().frames, 0u);
+
+    // the first frame after waking starts a fresh grid instead of counting as missed
+    clock.now += 100'000;
+    n.Add(pacer.Step(true, false, true, waitInput));
+    CHECK_EQ(n.skipped, 1u);
+    CHECK_EQ(pacer.GetStats().missed, 0u);
+}
+
+TEST(overrun_skips_ahead_without_bursting) {
+    FakeClock clock;
+    FramePacer pacer(clock, Config());
+    clock.now += 3 * kPeriod + 1000; // a slow frame
+    pacer.Step(true, true, false);
+    CHECK_EQ(pacer.GetStats().missed, 1u);
+    const uint64_t after = clock.now;
+    pacer.Step(true, true, false);
+    CHECK_EQ(clock.now - after, kPeriod);
+}
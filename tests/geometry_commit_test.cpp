@@ -0,0 +1,128 @@
+// tests/geometry_commit_test.cpp
+// SetGeometry's commit decision against a recording backend: move-only, size-only, both and
+// neither frames get the right SWP_NOMOVE / SWP_NOSIZE split, a frame never commits twice, an
+// unchanged rect is skipped unless a restack is asked for, and Reset() forces a full commit.
+#include <cstddef>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/drag_geometry.hpp"
+#include "utils/geometry_commit.hpp"
+
+using namespace utils;
+using render::GeometryCommit;
+
+namespace {
+struct Recorder final : render::GeometryRecorder {
+    std::vector<GeometryCommit> commits;
+    void Commit(const GeometryCommit& c) override { commits.push_back(c); }
+};
+
+// One frame of an overlay drag: at most one commit, and it carries exactly what changed
+struct Frames {
+    render::GeometryState state;
+    Recorder out;
+    size_t maxPerFrame = 0;
+
+    GeometryCommit Frame(const geom::Rect& r, bool reorder = false) {
+        const size_t before = out.commits.size();
+        const GeometryCommit c = state.Set(r, reorder, out);
+        const size_t n = out.commits.size() - before;
+        if (n > maxPerFrame)
+            maxPerFrame = n;
+        return c;
+    }
+};
+
+bool Is(const GeometryCommit& c, bool move, bool size, bool reorder) {
+    return c.move == move && c.size == size && c.reorder == reorder;
+}
+} // namespace
+
+TEST(first_frame_commits_position_and_size) {
+    Frames f;
+    CHECK(Is(f.Frame({10, 20, 410, 320}), true, true, false));
+    CHECK_EQ(f.out.commits.size(), 1u);
+    CHECK(f.out.commits[0].rect == (geom::Rect{10, 20, 410, 320}));
+}
+
+TEST(move_size_both_and_neither) {
+    Frames f;
+    f.Frame({0, 0, 400, 300});
+
+    CHECK(Is(f.Frame({5, 7, 405, 307}), true, false, false));   // move only
+    CHECK(Is(f.Frame({5, 7, 505, 347}), false, true, false));   // size only, top-left anchored
+    CHECK(Is(f.Frame({0, 0, 600, 400}), true, true, false));    // both
+    CHECK(Is(f.Frame({0, 0, 600, 400}), false, false, false));  // neither: skipped
+    CHECK(Is(f.Frame({-100, 0, 500, 400}), true, false, false)); // same size, shifted left
+    CHECK(Is(f.Frame({-100, 0, 500, 400}, true), false, false, true)); // restack alone still commits
+
+    CHECK_EQ(f.out.commits.size(), 6u);
+    CHECK_EQ(f.maxPerFrame, 1u);
+    CHECK(f.out.commits.back().rect == (geom::Rect{-100, 0, 500, 400}));
+}
+
+TEST(move_drag_commits_moves_only) {
+    Frames f;
+    const geom::Rect start{100, 100, 500, 400};
+    const geom::Point grab{50, 10};
+    f.Frame(start);
+    size_t moves = 0, skipped = 0;
+    // 1 kHz cursor that stalls every fourth sample
+    geom::Point cursor{150, 110};
+    for (int i = 0; i < 400; ++i) {
+        if (i % 4)
+            cursor.x += 3, cursor.y += 1;
+        const GeometryCommit c = f.Frame(geom::MoveTo(start, grab, cursor));
+        CHECK(!c.size);
+        c.move ? ++moves : ++skipped;
+    }
+    CHECK_EQ(moves, 300u);
+    CHECK_EQ(skipped, 100u);
+    CHECK_EQ(f.out.commits.size(), 301u);
+    CHECK_EQ(f.maxPerFrame, 1u);
+}
+
+TEST(resize_drag_splits_by_corner) {
+    const geom::Rect start{100, 100, 500, 400};
+    geom::ResizeParams p;
+    p.start = start;
+    p.minSize = {50, 50};
+
+    // bottom-right: the origin never moves, every changed frame is size only
+    Frames br;
+    p.corner = geom::Corner::BottomRight;
+    p.startCursor = {500, 400};
+    br.Frame(start);
+    for (int i = 1; i <= 100; ++i)
+        CHECK(Is(br.Frame(geom::Resize(p, {500 + i, 400 + i / 2})), false, true, false));
+
+    // top-left: both edges follow the cursor, every changed frame moves and sizes
+    Frames tl;
+    p.corner = geom::Corner::TopLeft;
+    p.startCursor = {100, 100};
+    tl.Frame(start);
+    for (int i = 1; i <= 100; ++i)
+        CHECK(Is(tl.Frame(geom::Resize(p, {100 + i, 100 + i})), true, true, false));
+
+    // pinned at the minimum size: the cursor keeps going but nothing changes
+    Frames pinned;
+    p.corner = geom::Corner::BottomRight;
+    p.startCursor = {500, 400};
+    pinned.Frame(geom::Resize(p, {0, 0}));
+    for (int i = 0; i < 50; ++i)
+        CHECK(Is(pinned.Frame(geom::Resize(p, {-i, -i})), false, false, false));
+    CHECK_EQ(pinned.out.commits.size(), 1u);
+
+    CHECK_EQ(br.maxPerFrame, 1u);
+    CHECK_EQ(tl.maxPerFrame, 1u);
+}
+
+TEST(reset_forces_a_full_commit) {
+    Frames f;
+    f.Frame({0, 0, 400, 300});
+    CHECK(Is(f.Frame({0, 0, 400, 300}), false, false, false));
+    f.state.Reset(); // window destroyed and recreated: its real geometry is unknown
+    CHECK(Is(f.Frame({0, 0, 400, 300}), true, true, false));
+    CHECK_EQ(f.out.commits.size(), 2u);
+}
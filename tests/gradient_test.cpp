@@ -0,0 +1,90 @@
+// tests/gradient_test.cpp
+// Gradient axis endpoints for the rotating border: exact at the axis angles and on a square's
+// diagonal, every corner of the box covered at any angle, and Advance() wrapping into [0, 360)
+// for either direction without float rounding ever producing 360.
+#include <cmath>
+#include <utility>
+
+#include "check.hpp"
+#include "utils/gradient.hpp"
+
+using namespace utils::gradient;
+
+namespace {
+bool Near(float a, float b, float eps = 1e-3f) {
+    return std::fabs(a - b) <= eps;
+}
+
+bool Is(const Endpoints& e, float x1, float y1, float x2, float y2) {
+    return Near(e.x1, x1) && Near(e.y1, y1) && Near(e.x2, x2) && Near(e.y2, y2);
+}
+
+// position of (x, y) along the axis: 0 at the start point, 1 at the end point
+float AxisT(const Endpoints& e, float x, float y) {
+    const float dx = e.x2 - e.x1, dy = e.y2 - e.y1;
+    return ((x - e.x1) * dx + (y - e.y1) * dy) / (dx * dx + dy * dy);
+}
+} // namespace
+
+TEST(axis_angles_and_square_diagonal) {
+    // 400 x 300: centre (200, 150), half-diagonal 250
+    CHECK(Is(ForAngle(400, 300, 0), -50, 150, 450, 150));
+    CHECK(Is(ForAngle(400, 300, 90), 200, -100, 200, 400));
+    CHECK(Is(ForAngle(400, 300, 180), 450, 150, -50, 150));
+    CHECK(Is(ForAngle(400, 300, 270), 200, 400, 200, -100));
+    // on a square the 45 degree axis runs exactly corner to corner
+    CHECK(Is(ForAngle(200, 200, 45), 0, 0, 200, 200));
+    CHECK(Is(ForAngle(200, 200, 225), 200, 200, 0, 0));
+    CHECK(Is(ForAngle(200, 200, 135), 200, 0, 0, 200));
+}
+
+TEST(corners_are_covered_at_any_angle) {
+    bool covered = true, centred = true;
+    for (const auto& [w, h] : {std::pair{400.f, 300.f}, {1920.f, 40.f}, {10.f, 800.f}, {1.f, 1.f}})
+        for (float a = 0; a < 360; a += 0.5f) {
+            const Endpoints e = ForAngle(w, h, a);
+            float lo = 1, hi = 0;
+            for (const auto& [x, y] : {std::pair{0.f, 0.f}, {w, 0.f}, {0.f, h}, {w, h}}) {
+                const float t = AxisT(e, x, y);
+                lo = std::fmin(lo, t);
+                hi = std::fmax(hi, t);
+            }
+            covered &= lo >= -1e-4f && hi <= 1 + 1e-4f;
+            // centred: the extreme corners sit symmetrically inside the axis
+            centred &= Near(lo + hi, 1.0f, 1e-4f);
+        }
+    CHECK(covered);
+    CHECK(centred);
+}
+
+TEST(advance_wraps_both_directions) {
+    CHECK(Near(Advance(350, 120, 1.0f / 6), 10));
+    CHECK(Near(Advance(10, -120, 1.0f / 6), 350));
+    CHECK(Near(Advance(0, 120, 0), 0));
+    CHECK(Near(Advance(359, 720, 1), 359));  // whole turns
+    CHECK(Near(Advance(90, -3600, 1.5f), 90)); // several turns backwards
+    CHECK(Near(Advance(720, 0, 0), 0));
+    CHECK(Near(Advance(-90, 0, 0), 270));
+}
+
+TEST(advance_never_returns_360) {
+    // -tiny wraps to 360 - tiny, which rounds to exactly 360.0f
+    bool inRange = true;
+    for (float tiny = 1e-9f; tiny < 1e-3f; tiny *= 1.7f) {
+        const float a = Advance(0, -tiny, 1);
+        inRange &= a >= 0.0f && a < 360.0f;
+        const float b = Advance(360.0f * 7, -tiny, 1);
+        inRange &= b >= 0.0f && b < 360.0f;
+    }
+    CHECK(inRange);
+    CHECK(Advance(0, -1e-6f, 1) < 360.0f);
+
+    // a long run at display rate stays in range at every step
+    float angle = 0;
+    bool steps = true;
+    for (int i = 0; i < 100000; ++i) {
+        angle = Advance(angle, i % 2 ? -120.0f : 119.0f, 1.0f / 144);
+        steps &= angle >= 0.0f && angle < 360.0f;
+    }
+    CHECK(steps);
+}
@@ -0,0 +1,107 @@
+// tests/input_event_bench.cpp
+// Record size and queue throughput for input::Event: the old message-id-only record (a bare
+// UINT through LockFreeQueue) against the full event through the same SPSC ring, and the
+// two-lane InputQueue with 1..4 synthetic hook producers feeding one consumer.
+//   input_event_bench [rounds]
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "inputQueue.hpp"
+#include "lockfreequeue.hpp"
+
+namespace {
+constexpr size_t kRing = 1024;
+
+// One producer retrying on a full ring, one consumer retrying on an empty one (yielding, so the
+// numbers stay meaningful on machines with fewer cores than threads)
+template <typename T, typename Make>
+double SpscNsPerEvent(size_t events, Make make) {
+    LockFreeQueue<T, kRing> q;
+    uint64_t sum = 0;
+    const auto t0 = bench::Clock::now();
+    std::thread producer([&] {
+        for (size_t i = 0; i < events; ++i)
+            while (!q.push(make(i)))
+                std::this_thread::yield();
+    });
+    T v{};
+    for (size_t got = 0; got < events;) {
+        if (q.pop(v)) {
+            sum += static_cast<uint64_t>(sizeof v);
+            ++got;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    const auto t1 = bench::Clock::now();
+    bench::Keep(sum);
+    return bench::NsPer(t0, t1, events);
+}
+
+struct MpscResult {
+    double nsPerPush = 0;
+    uint64_t popped = 0;
+    InputQueue<kRing>::Stats stats;
+};
+
+// Producers alternate key down/up with a move in between, as a hook thread would during a drag
+MpscResult Mpsc(int producers, size_t perProducer) {
+    InputQueue<kRing> q;
+    std::atomic<int> running{producers};
+    MpscResult r;
+    const auto t0 = bench::Clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+            for (size_t i = 0; i < perProducer; ++i) {
+                const uint64_t now = input::NowNs();
+                if (i % 3 == 2)
+                    q.push(input::MakeMove(static_cast<int32_t>(i), p, 0, now));
+                else
+                    q.push(input::MakeKey(0x41 + p, i % 3 == 0, 0, now));
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+    input::Event ev;
+    for (;;) {
+        const bool done = running.load(std::memory_order_acquire) == 0;
+        while (q.pop(ev))
+            ++r.popped;
+        if (done)
+            break;
+        std::this_thread::yield();
+    }
+    for (std::thread& t : threads)
+        t.join();
+    const auto t1 = bench::Clock::now();
+    r.nsPerPush = bench::NsPer(t0, t1, perProducer * producers);
+    r.stats = q.GetStats();
+    return r;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t events = 100000 * static_cast<size_t>(bench::Rounds(argc, argv, 20));
+
+    std::printf("input::Event: %zu bytes, %zu per 64-byte line (old record: %zu bytes)\n\n", sizeof(input::Event), 64 / sizeof(input::Event), sizeof(uint32_t));
+
+    std::printf("SPSC LockFreeQueue<T, %zu>, %zu events\n", kRing, events);
+    const double bare = SpscNsPerEvent<uint32_t>(events, [](size_t i) { return static_cast<uint32_t>(0x100 + (i & 1)); });
+    const double full = SpscNsPerEvent<input::Event>(events, [](size_t i) { return input::MakeKey(0x41, i & 1, 0, input::NowNs()); });
+    std::printf("  %-14s %8.1f ns/event %8.1f M/s\n", "uint32_t", bare, 1000.0 / bare);
+    std::printf("  %-14s %8.1f ns/event %8.1f M/s  (includes NowNs)\n\n", "input::Event", full, 1000.0 / full);
+
+    std::printf("InputQueue<%zu>, keys and moves\n", kRing);
+    std::printf("  %9s %12s %10s %10s %12s %12s\n", "producers", "ns/push", "M/s", "popped", "overflowed", "coalesced");
+    for (int producers : {1, 2, 4}) {
+        const MpscResult r = Mpsc(producers, events / producers);
+        std::printf("  %9d %9.1f ns %10.1f %10llu %12llu %12llu\n", producers, r.nsPerPush, 1000.0 / r.nsPerPush, static_cast<unsigned long long>(r.popped),
+          static_cast<unsigned long long>(r.stats.overflowed), static_cast<unsigned long long>(r.stats.coalesced));
+    }
+    return 0;
+}
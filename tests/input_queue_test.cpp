@@ -0,0 +1,207 @@
+// tests/input_queue_test.cpp
+// InputQueue ordering, coalescing and spill behaviour, plus a multi-producer stress run
+// (build with -DHYPRWIN_TSAN=ON to run it under ThreadSanitizer).
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "inputQueue.hpp"
+
+using input::Event;
+
+namespace {
+Event Key(uint16_t vk, bool down, uint64_t ns) {
+    return input::MakeKey(vk, down, 0, ns);
+}
+
+std::vector<Event> Drain(auto& q) {
+    std::vector<Event> out;
+    Event ev;
+    while (q.pop(ev))
+        out.push_back(ev);
+    return out;
+}
+} // namespace
+
+TEST(critical_events_keep_push_order) {
+    InputQueue<16> q;
+    for (uint16_t i = 0; i < 10; ++i)
+        q.push(Key(0x41 + i, i % 2 == 0, i + 1));
+    const std::vector<Event> out = Drain(q);
+    CHECK_EQ(out.size(), 10u);
+    for (size_t i = 0; i < out.size(); ++i) {
+        CHECK_EQ(out[i].code, 0x41 + i);
+        CHECK_EQ(out[i].IsDown(), i % 2 == 0);
+    }
+}
+
+TEST(moves_coalesce_to_latest) {
+    InputQueue<16> q;
+    for (int i = 0; i < 100; ++i)
+        q.push(input::MakeMove(i, -i, 0, 1000 + i));
+    const std::vector<Event> out = Drain(q);
+    CHECK_EQ(out.size(), 1u);
+    CHECK_EQ(out[0].x, 99);
+    CHECK_EQ(out[0].y, -99);
+    CHECK_EQ(out[0].captureNs, 1099u);
+    CHECK_EQ(q.GetStats().coalesced, 99u);
+}
+
+TEST(older_move_does_not_replace_newer) {
+    InputQueue<16> q;
+    q.push(input::MakeMove(5, 5, 0, 200));
+    q.push(input::MakeMove(1, 1, 0, 100)); // lost a race with the first producer
+    const std::vector<Event> out = Drain(q);
+    CHECK_EQ(out.size(), 1u);
+    CHECK_EQ(out[0].x, 5);
+    CHECK_EQ(out[0].captureNs, 200u);
+}
+
+TEST(move_flags_survive_coalescing) {
+    InputQueue<16> q;
+    q.push(input::MakeMove(1, 2, 0, 10, input::Replayed));
+    Event ev;
+    CHECK(q.pop(ev));
+    CHECK(ev.kind == input::Kind::Move);
+    CHECK((ev.flags & input::Replayed) != 0);
+}
+
+TEST(earlier_move_precedes_button_up) {
+    InputQueue<16> q;
+    q.push(input::MakeButton(input::Button::Left, true, 0, 0, 0, 10));
+    q.push(input::MakeMove(40, 50, 0, 20));
+    q.push(input::MakeButton(input::Button::Left, false, 40, 50, 0, 30));
+    const std::vector<Event> out = Drain(q);
+    CHECK_EQ(out.size(), 3u);
+    CHECK(out[0].kind == input::Kind::Button && out[0].IsDown());
+    CHECK(out[1].kind == input::Kind::Move && out[1].x == 40);
+    CHECK(out[2].kind == input::Kind::Button && !out[2].IsDown());
+}
+
+TEST(later_move_follows_critical_events) {
+    InputQueue<16> q;
+    q.push(input::MakeMove(7, 7, 0, 50));
+    q.push(Key(0x41, true, 10));
+    q.push(Key(0x41, false, 20));
+    const std::vector<Event> out = Drain(q);
+    CHECK_EQ(out.size(), 3u);
+    CHECK(out[0].kind == input::Kind::Key && out[0].IsDown());
+    CHECK(out[1].kind == input::Kind::Key && !out[1].IsDown());
+    CHECK(out[2].kind == input::Kind::Move);
+}
+
+TEST(wheel_deltas_sum_and_clamp) {
+    InputQueue<16> q;
+    for (int i = 0; i < 3; ++i)
+        q.push(input::MakeWheel(120, 1, 1, 0, 10 + i));
+    Event ev;
+    CHECK(q.pop(ev));
+    CHECK(ev.kind == input::Kind::Wheel);
+    CHECK_EQ(static_cast<int16_t>(ev.code), 360);
+    CHECK(!q.pop(ev));
+
+    for (int i = 0; i < 400; ++i)
+        q.push(input::MakeWheel(120, 1, 1, 0, 100 + i));
+    CHECK(q.pop(ev));
+    CHECK_EQ(static_cast<int16_t>(ev.code), INT16_MAX);
+}
+
+TEST(full_ring_spills_without_losing_state) {
+    InputQueue<4> q;
+    // 0x41 down/up pairs overflow the ring; the final state of every key must still arrive last
+    for (uint16_t vk = 0x41; vk < 0x41 + 8; ++vk) {
+        q.push(Key(vk, true, vk * 2));
+        q.push(Key(vk, false, vk * 2 + 1));
+    }
+    CHECK(q.GetStats().overflowed > 0);
+    const std::vector<Event> out = Drain(q);
+    bool down[256]{};
+    uint64_t lastNs = 0;
+    for (const Event& ev : out) {
+        CHECK(ev.captureNs >= lastNs);
+        lastNs = ev.captureNs;
+        down[ev.code & 0xFF] = ev.IsDown();
+    }
+    for (uint16_t vk = 0x41; vk < 0x41 + 8; ++vk)
+        CHECK(!down[vk]);
+}
+
+// Per-producer key order and final key state survive any interleaving; delivered moves only ever
+// move forward in time and the newest one is delivered last.
+template <size_t Size>
+static void StressMultiProducer() {
+    constexpr int kProducers = 4;
+    const int perProducer = 20000 * check::Scale();
+    InputQueue<Size> q;
+    std::atomic<uint64_t> clock{1};
+    std::atomic<int> running{kProducers};
+    uint64_t lastPushedMove[kProducers]{};
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+        producers.emplace_back([&, p] {
+            const uint16_t vk = static_cast<uint16_t>(0x41 + p);
+            for (int i = 0; i < perProducer; ++i) {
+                q.push(Key(vk, i % 2 == 0, clock.fetch_add(1, std::memory_order_relaxed)));
+                lastPushedMove[p] = clock.fetch_add(1, std::memory_order_relaxed);
+                q.push(input::MakeMove(p, i, 0, lastPushedMove[p]));
+            }
+            running.fetch_sub(1, std::memory_order_release);
+        });
+
+    uint64_t lastKeyNs[kProducers]{};
+    bool down[kProducers]{};
+    uint64_t keys = 0, lastMoveNs = 0;
+    bool ordered = true, movesMonotonic = true;
+    Event ev;
+    for (;;) {
+        const bool done = running.load(std::memory_order_acquire) == 0;
+        while (q.pop(ev)) {
+            if (ev.kind == input::Kind::Move) {
+                movesMonotonic &= ev.captureNs > lastMoveNs;
+                lastMoveNs = ev.captureNs;
+                continue;
+            }
+            const int p = ev.code - 0x41;
+            ordered &= ev.captureNs > lastKeyNs[p];
+            lastKeyNs[p] = ev.captureNs;
+            down[p] = ev.IsDown();
+            ++keys;
+        }
+        if (done)
+            break;
+        std::this_thread::yield();
+    }
+    for (std::thread& t : producers)
+        t.join();
+
+    CHECK(ordered);
+    CHECK(movesMonotonic);
+    // every key ends released (per-producer pushes alternate, the last one is an up)
+    for (bool d : down)
+        CHECK(!d);
+    // spilled same-edge events may fold, nothing else is lost
+    const typename InputQueue<Size>::Stats st = q.GetStats();
+    CHECK_EQ(st.critical, static_cast<uint64_t>(kProducers) * perProducer);
+    CHECK(keys <= st.critical);
+    if constexpr (Size <= 8)
+        CHECK(st.overflowed > 0);
+    if (st.overflowed == 0)
+        CHECK_EQ(keys, st.critical);
+    // the newest move is the one left for last
+    uint64_t newestMove = 0;
+    for (uint64_t ns : lastPushedMove)
+        newestMove = std::max(newestMove, ns);
+    CHECK_EQ(lastMoveNs, newestMove);
+}
+
+TEST(stress_multi_producer) {
+    StressMultiProducer<256>();
+}
+
+// a ring this small overflows constantly, exercising the spill slots under contention
+TEST(stress_multi_producer_spilling) {
+    StressMultiProducer<4>();
+}
@@ -0,0 +1,115 @@
+// tests/input_reactor_bench.cpp
+// Fake keyboard and mouse hooks feeding InputReactor, against the split design it replaced (one
+// consumer thread per device):
+//  - flood: both sources post as fast as they can; events/sec accepted, and how many reached the
+//    handler after moves coalesced and same-key spills folded
+//  - paced: a 1 kHz mouse (a click every 100 moves) and a typist (a key every 5 ms); consumer
+//    rounds, parks and kernel wakes per posted event, i.e. context switches into the consumers
+//   input_reactor_bench [rounds]
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+#include "bench.hpp"
+#include "inputReactor.hpp"
+
+namespace {
+using Reactor = InputReactor<128>;
+
+struct Totals {
+    uint64_t posted = 0;
+    uint64_t handled = 0;
+    uint64_t rounds = 0;
+    uint64_t parks = 0;
+    uint64_t kernelWakes = 0;
+    double seconds = 0;
+
+    void Add(const Reactor::Stats& s) {
+        handled += s.events;
+        rounds += s.rounds;
+        parks += s.wake.parks;
+        kernelWakes += s.wake.kernelWakes;
+    }
+};
+
+// Each returns how many events it posted
+uint64_t Keyboard(Reactor& r, uint32_t keys, std::chrono::microseconds gap) {
+    for (uint32_t i = 0; i < keys; ++i) {
+        if (gap.count())
+            std::this_thread::sleep_for(gap);
+        r.Post(input::MakeKey(0x41 + i % 26, true, 0, input::NowNs()));
+        r.Post(input::MakeKey(0x41 + i % 26, false, 0, input::NowNs()));
+    }
+    return 2ull * keys;
+}
+
+uint64_t Mouse(Reactor& r, uint32_t moves, std::chrono::microseconds gap) {
+    uint64_t posted = 0;
+    for (uint32_t i = 0; i < moves; ++i) {
+        if (gap.count())
+            std::this_thread::sleep_for(gap);
+        const int32_t x = static_cast<int32_t>(i % 1920);
+        r.Post(input::MakeMove(x, 500, 0, input::NowNs()));
+        ++posted;
+        if (i % 100 == 50 || i % 100 == 99) {
+            r.Post(input::MakeButton(input::Button::Left, i % 100 == 50, x, 500, 0, input::NowNs()));
+            ++posted;
+        }
+    }
+    return posted;
+}
+
+// merged: both sources into one reactor; split: each into its own
+Totals Run(bool merged, uint32_t keys, std::chrono::microseconds keyGap, uint32_t moves, std::chrono::microseconds moveGap) {
+    Reactor a(false), b(false);
+    Reactor& kb = a;
+    Reactor& mouse = merged ? a : b;
+    std::atomic<uint64_t> sink{0};
+    const auto handler = [&](const input::Event& ev) { sink.fetch_add(ev.code, std::memory_order_relaxed); };
+
+    Totals t;
+    const auto t0 = bench::Clock::now();
+    {
+        std::jthread consumerA([&](std::stop_token st) { a.Run(st, handler); });
+        std::jthread consumerB;
+        if (!merged)
+            consumerB = std::jthread([&](std::stop_token st) { b.Run(st, handler); });
+        uint64_t kbPosted = 0, mousePosted = 0;
+        std::thread kbHook([&] { kbPosted = Keyboard(kb, keys, keyGap); });
+        std::thread mouseHook([&] { mousePosted = Mouse(mouse, moves, moveGap); });
+        kbHook.join();
+        mouseHook.join();
+        t.posted = kbPosted + mousePosted;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5)); // let the consumers drain
+    }
+    t.seconds = bench::Seconds(t0, bench::Clock::now());
+    t.Add(a.GetStats());
+    if (!merged)
+        t.Add(b.GetStats());
+    bench::Keep(sink.load());
+    return t;
+}
+
+void Print(const char* name, const Totals& t) {
+    const double per = t.posted ? 1.0 / static_cast<double>(t.posted) : 0.0;
+    std::printf("  %-8s %10.0f %10llu %12.3f %12.3f %12.3f\n", name, t.posted / t.seconds, static_cast<unsigned long long>(t.handled), t.rounds * per,
+      t.parks * per, t.kernelWakes * per);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t rounds = static_cast<uint32_t>(bench::Rounds(argc, argv, 4));
+    std::printf("  %-8s %10s %10s %12s %12s %12s\n", "", "posted/s", "handled", "rounds/post", "parks/post", "wakes/post");
+
+    std::printf("flood\n");
+    Print("merged", Run(true, 50000 * rounds, {}, 100000 * rounds, {}));
+    Print("split", Run(false, 50000 * rounds, {}, 100000 * rounds, {}));
+
+    const uint32_t seconds = rounds / 4 + 1;
+    std::printf("paced (%u s)\n", seconds);
+    Print("merged", Run(true, 200 * seconds, std::chrono::microseconds(5000), 1000 * seconds, std::chrono::microseconds(1000)));
+    Print("split", Run(false, 200 * seconds, std::chrono::microseconds(5000), 1000 * seconds, std::chrono::microseconds(1000)));
+    return 0;
+}
@@ -0,0 +1,209 @@
+// tests/input_replay_test.cpp
+// Trace replay sessions: binds resolve through a session's own decoder, clicks hit-test a
+// synthetic window registry, and nothing a trace leaves behind (SUPER held, a half-typed
+// sequence, latency samples) reaches another session or the global stages.
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "inputReplay.hpp"
+#include "utils/window_registry.hpp"
+
+using input::Event;
+using input::replay::Session;
+
+namespace {
+constexpr uint32_t kSuper = 0x5B;
+constexpr uint32_t kLShift = 0xA0;
+
+// default map: SUPER+Q -> 0, SUPER+SHIFT+W -> 1, SUPER+S enters a submap where X -> 2;
+// SUPER+G, H is a two-key sequence -> 3
+KeyTrie MakeTrie() {
+    KeyTrie trie;
+    const uint16_t root = trie.AddRoot();
+    const uint16_t submap = trie.AddRoot();
+    const uint16_t seq = trie.AddNode();
+    trie.SetEdge(root, KeyTrie::KeyCode('Q', 0), KeyTarget::Action(0));
+    trie.SetEdge(root, KeyTrie::KeyCode('W', 1), KeyTarget::Action(1));
+    trie.SetEdge(root, KeyTrie::KeyCode('S', 0), KeyTarget::Node(submap));
+    trie.SetEdge(submap, KeyTrie::KeyCode('X', 0), KeyTarget::Action(2));
+    trie.SetEdge(root, KeyTrie::KeyCode('G', 0), KeyTarget::Node(seq));
+    trie.SetEdge(seq, KeyTrie::KeyCode('H', 0), KeyTarget::Action(3));
+    trie.Finalize();
+    return trie;
+}
+
+struct Trace {
+    std::vector<Event> events;
+    uint64_t ns = 1000;
+
+    Trace& Key(uint32_t vk, bool down) {
+        events.push_back(input::MakeKey(vk, down, 0, ns += 1000));
+        return *this;
+    }
+    Trace& Tap(uint32_t vk) {
+        return Key(vk, true).Key(vk, false);
+    }
+    Trace& Click(int32_t x, int32_t y) {
+        events.push_back(input::MakeButton(input::Button::Left, true, x, y, 0, ns += 1000));
+        events.push_back(input::MakeMove(x + 5, y + 5, 0, ns += 1000));
+        events.push_back(input::MakeButton(input::Button::Left, false, x + 5, y + 5, 0, ns += 1000));
+        return *this;
+    }
+};
+
+std::vector<utils::wnd::WindowInfo> MakeWindows() {
+    using namespace utils::wnd;
+    const uint8_t visible = Usable | Filtered;
+    return {
+      {.key = 1, .window = {0, 0, 100, 100}, .visual = {0, 0, 100, 100}, .flags = visible},
+      {.key = 2, .window = {200, 0, 300, 100}, .visual = {200, 0, 300, 100}, .flags = visible},
+    };
+}
+
+input::replay::HitTest HitOver(const std::vector<utils::wnd::WindowInfo>& z) {
+    return [&z](int32_t x, int32_t y) {
+        const utils::wnd::WindowInfo* w = utils::wnd::HitFiltered(z, {x, y});
+        return w ? w->key : 0;
+    };
+}
+
+uint64_t StageCount(utils::latency::Stage s) {
+    return utils::latency::g_stages[static_cast<size_t>(s)].Snap().count;
+}
+} // namespace
+
+TEST(binds_resolve_in_the_session) {
+    const KeyTrie trie = MakeTrie();
+    Trace t;
+    t.Key(kSuper, true).Tap('Q').Tap('Q');           // two actions, auto-repeat free
+    t.Key(kLShift, true).Tap('W').Key(kLShift, false); // shifted bind
+    t.Tap('W');                                        // no bind without shift
+    t.Tap('S').Tap('X');                               // submap, then its action
+    t.Key(kSuper, false);
+
+    Session session({&trie, kSuper, 1'000'000'000}, {});
+    const input::replay::Stats st = session.Run(t.events, false);
+    CHECK_EQ(st.feed.events, t.events.size());
+    CHECK_EQ(st.handled, t.events.size());
+    CHECK_EQ(st.keys, 6u);
+    CHECK_EQ(st.actions, 4u);
+    CHECK_EQ(st.submaps, 1u);
+    CHECK(!st.superHeldAtEnd);
+    CHECK_EQ(st.keyLatency.count, 6u);
+}
+
+TEST(auto_repeat_is_not_a_new_key) {
+    const KeyTrie trie = MakeTrie();
+    Trace t;
+    t.Key(kSuper, true).Key('Q', true).Key('Q', true).Key('Q', true).Key('Q', false).Key(kSuper, false);
+    Session session({&trie, kSuper, 1'000'000'000}, {});
+    const input::replay::Stats st = session.Run(t.events, false);
+    CHECK_EQ(st.keys, 1u);
+    CHECK_EQ(st.actions, 1u);
+}
+
+TEST(sequences_time_out_on_capture_clock) {
+    const KeyTrie trie = MakeTrie();
+    Trace t;
+    t.Key(kSuper, true).Tap('G').Tap('H').Key(kSuper, false);
+    // restamped capture times are back to back, far inside any timeout
+    Session session({&trie, kSuper, 1'000'000'000}, {});
+    CHECK_EQ(session.Run(t.events, false).actions, 1u);
+    // a zero timeout expires the pending G before H arrives
+    Session strict({&trie, kSuper, 0}, {});
+    CHECK_EQ(strict.Run(t.events, false).actions, 0u);
+}
+
+TEST(clicks_hit_test_the_stub_backend) {
+    const std::vector<utils::wnd::WindowInfo> z = MakeWindows();
+    Trace t;
+    t.Key(kSuper, true).Click(50, 50).Click(150, 50).Click(250, 10).Key(kSuper, false);
+    Session session({nullptr, kSuper, 0}, HitOver(z));
+    const input::replay::Stats st = session.Run(t.events, false);
+    CHECK_EQ(st.clicks, 3u);
+    CHECK_EQ(st.targets, 2u);
+    CHECK_EQ(st.clickLatency.count, 3u);
+}
+
+// a trace cut off mid-gesture only ever affects the session that replayed it
+TEST(stuck_trace_stays_in_its_session) {
+    const KeyTrie trie = MakeTrie();
+    const std::vector<utils::wnd::WindowInfo> z = MakeWindows();
+    Trace stuck;
+    stuck.Key(kSuper, true).Key('G', true); // SUPER held, G sequence pending, no releases
+    stuck.events.push_back(input::MakeButton(input::Button::Left, true, 10, 10, 0, stuck.ns += 1000));
+
+    const uint64_t keyQueue = StageCount(utils::latency::Stage::KeyQueue);
+    const uint64_t mouseQueue = StageCount(utils::latency::Stage::MouseQueue);
+
+    Session session({&trie, kSuper, 1'000'000'000}, HitOver(z));
+    const input::replay::Stats first = session.Run(stuck.events, false);
+    CHECK(first.superHeldAtEnd);
+    CHECK_EQ(first.targets, 1u);
+
+    // the same session starts over from released keys and an empty sequence: H alone does not
+    // complete the abandoned G, H
+    Trace next;
+    next.Key(kSuper, true).Tap('H').Tap('Q').Key(kSuper, false);
+    const input::replay::Stats second = session.Run(next.events, false);
+    CHECK(!second.superHeldAtEnd);
+    CHECK_EQ(second.keys, 2u);
+    CHECK_EQ(second.actions, 1u);
+
+    // a second session never saw the first trace
+    Session other({&trie, kSuper, 1'000'000'000}, HitOver(z));
+    CHECK(!other.Run(next.events, false).superHeldAtEnd);
+
+    // replay latency stays in the session stats
+    CHECK_EQ(StageCount(utils::latency::Stage::KeyQueue), keyQueue);
+    CHECK_EQ(StageCount(utils::latency::Stage::MouseQueue), mouseQueue);
+}
+
+// the end marker is only handled after every event fed before it, so Run sees the final key state
+// even when the burst overflows the session queue
+TEST(run_drains_everything_fed) {
+    Trace t;
+    for (int i = 0; i < 200 * check::Scale(); ++i) {
+        t.Tap(0x41 + i % 20);
+        t.events.push_back(input::MakeMove(i, i, 0, t.ns += 1000));
+    }
+    Session session({nullptr, kSuper, 0}, {});
+    for (int round = 0; round < 20; ++round) {
+        t.Key(kSuper, round % 2 == 0);
+        const input::replay::Stats st = session.Run(t.events, false);
+        CHECK_EQ(st.feed.events, t.events.size());
+        CHECK(st.handled > 0 && st.handled <= t.events.size());
+        CHECK_EQ(st.superHeldAtEnd, round % 2 == 0);
+        t.events.pop_back();
+    }
+}
+
+TEST(recorded_trace_round_trips) {
+    Trace t;
+    t.Key(kSuper, true).Tap('Q').Click(50, 50).Key(kSuper, false);
+    const std::string path = "input_replay_test.trace";
+    {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        CHECK(f != nullptr);
+        const input::trace::TraceHeader hdr{};
+        std::fwrite(&hdr, sizeof(hdr), 1, f);
+        std::fwrite(t.events.data(), sizeof(Event), t.events.size(), f);
+        std::fclose(f);
+    }
+    std::vector<Event> loaded;
+    std::string error;
+    CHECK(input::trace::Load(path, loaded, error));
+    std::remove(path.c_str());
+    CHECK_EQ(loaded.size(), t.events.size());
+
+    const KeyTrie trie = MakeTrie();
+    const std::vector<utils::wnd::WindowInfo> z = MakeWindows();
+    Session session({&trie, kSuper, 1'000'000'000}, HitOver(z));
+    const input::replay::Stats st = session.Run(loaded, true);
+    CHECK_EQ(st.actions, 1u);
+    CHECK_EQ(st.targets, 1u);
+
+    CHECK(!input::trace::Load("missing.trace", loaded, error));
+}
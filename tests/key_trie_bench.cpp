@@ -0,0 +1,114 @@
+// tests/key_trie_bench.cpp
+// Per-key transition cost of the keybind DFA:
+//  - dense root: single-key binds, every step is one root-table load
+//  - deep submap: 8-key sequences inside a submap, every step after the first probes the edge table
+//  - decoder: KeyDecoder::Track + Lookup per key event, modifiers held, as ProcessKey runs it
+//   key_trie_bench [rounds]
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "keyDecoder.hpp"
+#include "settings/key_trie.hpp"
+
+namespace {
+constexpr uint64_t kTimeout = 1'000'000'000;
+constexpr int kDepth = 8;
+constexpr int kSequences = 200;
+
+// root: every letter and digit with and without LSHIFT; submap 1: kSequences sequences of
+// kDepth letters, entered from the root with F1
+struct Binds {
+    KeyTrie trie;
+    std::vector<std::vector<uint16_t>> sequences; // key codes, in submap 1
+
+    Binds() {
+        const uint16_t root = trie.AddRoot();
+        const uint16_t sub = trie.AddRoot();
+        uint16_t action = 0;
+        for (uint32_t vk = 0x30; vk <= 0x5A; ++vk) {
+            trie.SetEdge(root, KeyTrie::KeyCode(vk, 0), KeyTarget::Action(action++));
+            trie.SetEdge(root, KeyTrie::KeyCode(vk, 1), KeyTarget::Action(action++));
+        }
+        trie.SetEdge(root, KeyTrie::KeyCode(0x70, 0), KeyTarget::Node(sub));
+
+        std::mt19937 rng(9);
+        for (int s = 0; s < kSequences; ++s) {
+            std::vector<uint16_t> seq;
+            uint16_t node = sub;
+            for (int d = 0; d < kDepth; ++d) {
+                const uint16_t key = KeyTrie::KeyCode(0x41 + rng() % 26, 0);
+                seq.push_back(key);
+                const KeyTarget t = trie.Step(node, key);
+                if (d + 1 == kDepth) {
+                    if (t.IsNone())
+                        trie.SetEdge(node, key, KeyTarget::Action(action++));
+                } else if (t.IsNode()) {
+                    node = t.Index();
+                } else {
+                    const uint16_t next = trie.AddNode();
+                    trie.SetEdge(node, key, KeyTarget::Node(next));
+                    node = next;
+                }
+            }
+            sequences.push_back(seq);
+        }
+        trie.Finalize();
+    }
+};
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = bench::Rounds(argc, argv, 200);
+    const Binds b;
+    std::mt19937 rng(3);
+    uint64_t sum = 0, now = 0;
+
+    std::vector<uint16_t> rootKeys(4096);
+    for (uint16_t& k : rootKeys)
+        k = KeyTrie::KeyCode(0x30 + rng() % 43, rng() & 1);
+    KeySequencer seq;
+    auto t0 = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (uint16_t k : rootKeys)
+            sum += static_cast<uint64_t>(seq.Feed(b.trie, k, ++now, kTimeout).result);
+    auto t1 = bench::Clock::now();
+    std::printf("%-22s %8.2f ns/key\n", "dense root", bench::NsPer(t0, t1, rootKeys.size() * rounds));
+
+    seq.Feed(b.trie, KeyTrie::KeyCode(0x70, 0), ++now, kTimeout); // into the submap
+    size_t steps = 0;
+    t0 = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (const std::vector<uint16_t>& s : b.sequences)
+            for (uint16_t k : s) {
+                sum += static_cast<uint64_t>(seq.Feed(b.trie, k, ++now, kTimeout).result);
+                ++steps;
+            }
+    t1 = bench::Clock::now();
+    std::printf("%-22s %8.2f ns/key (depth %d, %zu interior nodes)\n", "deep submap", bench::NsPer(t0, t1, steps), kDepth, b.trie.NodeCount() - 2);
+
+    // SUPER + LSHIFT held, then root keys as down/up pairs
+    constexpr uint32_t kSuper = 0x5B;
+    KeyDecoder decoder;
+    decoder.Track(input::MakeKey(kSuper, true, 0, 0), kSuper);
+    decoder.Track(input::MakeKey(0xA0, true, 0, 0), kSuper);
+    std::vector<input::Event> events;
+    for (uint16_t k : rootKeys) {
+        events.push_back(input::MakeKey(k >> 6, true, 0, 0));
+        events.push_back(input::MakeKey(k >> 6, false, 0, 0));
+    }
+    t0 = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (input::Event ev : events) {
+            ev.captureNs = ++now;
+            if (decoder.Track(ev, kSuper) == KeyDecoder::Edge::Key)
+                sum += static_cast<uint64_t>(decoder.Lookup(b.trie, ev, kTimeout).result);
+        }
+    t1 = bench::Clock::now();
+    std::printf("%-22s %8.2f ns/event\n", "decoder track+lookup", bench::NsPer(t0, t1, events.size() * rounds));
+
+    bench::Keep(sum);
+    return 0;
+}
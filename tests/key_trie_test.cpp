@@ -0,0 +1,190 @@
+// tests/key_trie_test.cpp
+// Keybind DFA driven by scripted key streams: single binds, modifier masks, leader sequences with
+// aborts and timeouts, submaps, the finalized edge table against the building map, and the
+// KeyDecoder state (modifier mask, auto-repeat, SUPER release) that feeds the sequencer.
+#include <cstdint>
+#include <map>
+#include <random>
+
+#include "check.hpp"
+#include "keyDecoder.hpp"
+#include "settings/key_trie.hpp"
+
+using Result = KeySequencer::Result;
+
+namespace {
+constexpr uint8_t kShift = 1 << 0; // ModMask::LSHIFT
+constexpr uint8_t kCtrl = 1 << 2;  // ModMask::LCTRL
+constexpr uint64_t kTimeout = 1000;
+
+uint16_t K(uint32_t vk, uint8_t mods = 0) {
+    return KeyTrie::KeyCode(vk, mods);
+}
+
+// [binds]   Q -> 0, SHIFT+Q -> 1, G H -> 2, G J K -> 3, M -> submap 1
+// [submap]  X -> 4, G H -> 5, ESC -> reset (root 0)
+struct Fixture {
+    KeyTrie trie;
+    KeySequencer seq;
+    uint64_t now = 0;
+
+    Fixture() {
+        const uint16_t root = trie.AddRoot();
+        const uint16_t sub = trie.AddRoot();
+        trie.SetEdge(root, K('Q'), KeyTarget::Action(0));
+        trie.SetEdge(root, K('Q', kShift), KeyTarget::Action(1));
+        const uint16_t g = trie.AddNode();
+        trie.SetEdge(root, K('G'), KeyTarget::Node(g));
+        trie.SetEdge(g, K('H'), KeyTarget::Action(2));
+        const uint16_t gj = trie.AddNode();
+        trie.SetEdge(g, K('J'), KeyTarget::Node(gj));
+        trie.SetEdge(gj, K('K'), KeyTarget::Action(3));
+        trie.SetEdge(root, K('M'), KeyTarget::Node(sub));
+        trie.SetEdge(sub, K('X'), KeyTarget::Action(4));
+        const uint16_t sg = trie.AddNode();
+        trie.SetEdge(sub, K('G'), KeyTarget::Node(sg));
+        trie.SetEdge(sg, K('H'), KeyTarget::Action(5));
+        trie.SetEdge(sub, K(0x1B), KeyTarget::Node(root));
+        trie.Finalize();
+    }
+
+    KeySequencer::Step Press(uint32_t vk, uint8_t mods = 0, uint64_t after = 10) {
+        now += after;
+        return seq.Feed(trie, K(vk, mods), now, kTimeout);
+    }
+};
+
+bool IsAction(KeySequencer::Step s, uint16_t index) {
+    return s.result == Result::Action && s.index == index;
+}
+} // namespace
+
+TEST(single_key_binds_and_modifiers) {
+    Fixture f;
+    CHECK(IsAction(f.Press('Q'), 0));
+    CHECK(IsAction(f.Press('Q', kShift), 1));
+    CHECK(f.Press('Q', kCtrl).result == Result::None);
+    CHECK(f.Press('Z').result == Result::None);
+    CHECK(!f.seq.InSequence());
+}
+
+TEST(leader_sequences) {
+    Fixture f;
+    CHECK(f.Press('G').result == Result::Pending);
+    CHECK(f.seq.InSequence());
+    CHECK(IsAction(f.Press('H'), 2));
+    CHECK(!f.seq.InSequence());
+
+    CHECK(f.Press('G').result == Result::Pending);
+    CHECK(f.Press('J').result == Result::Pending);
+    CHECK(IsAction(f.Press('K'), 3));
+}
+
+TEST(unmatched_key_aborts_and_counts_from_root) {
+    Fixture f;
+    CHECK(f.Press('G').result == Result::Pending);
+    CHECK(IsAction(f.Press('Q'), 0)); // not G Q: plain Q
+    CHECK(f.Press('G').result == Result::Pending);
+    CHECK(f.Press('Z').result == Result::None);
+    CHECK(!f.seq.InSequence());
+    CHECK(f.Press('H').result == Result::None); // the G is gone
+}
+
+TEST(sequence_times_out_on_next_key) {
+    Fixture f;
+    CHECK(f.Press('G').result == Result::Pending);
+    CHECK(IsAction(f.Press('H', 0, kTimeout), 2)); // exactly at the deadline still counts
+    CHECK(f.Press('G').result == Result::Pending);
+    CHECK(f.Press('H', 0, kTimeout + 1).result == Result::None);
+    // a timed-out prefix restarts cleanly
+    CHECK(f.Press('G', 0, kTimeout + 1).result == Result::Pending);
+    CHECK(f.Press('J', 0, kTimeout + 1).result == Result::None);
+}
+
+TEST(submaps_switch_roots_until_reset) {
+    Fixture f;
+    const KeySequencer::Step enter = f.Press('M');
+    CHECK(enter.result == Result::Submap);
+    CHECK_EQ(enter.index, 1u);
+    CHECK_EQ(f.seq.Submap(), 1u);
+    CHECK(IsAction(f.Press('X'), 4));
+    CHECK(IsAction(f.Press('X'), 4)); // stays in the submap
+    CHECK(f.Press('Q').result == Result::None);
+    CHECK(f.Press('G').result == Result::Pending);
+    CHECK(IsAction(f.Press('H'), 5)); // the submap's own G H
+    CHECK(f.Press('G', 0, 10).result == Result::Pending);
+    CHECK(f.Press('H', 0, kTimeout + 1).result == Result::None); // timeout back to the submap root
+    CHECK_EQ(f.seq.Submap(), 1u);
+
+    const KeySequencer::Step reset = f.Press(0x1B);
+    CHECK(reset.result == Result::Submap);
+    CHECK_EQ(f.seq.Submap(), 0u);
+    CHECK(IsAction(f.Press('Q'), 0));
+
+    CHECK(f.Press('M').result == Result::Submap);
+    f.seq.Reset(); // SUPER released
+    CHECK_EQ(f.seq.Submap(), 0u);
+    CHECK(f.Press('X').result == Result::None);
+}
+
+TEST(finalized_edges_match_building_map) {
+    std::mt19937 rng(11);
+    KeyTrie trie;
+    trie.AddRoot();
+    std::map<std::pair<uint16_t, uint16_t>, uint16_t> want; // (node, key) -> raw target
+    for (int i = 0; i < 3000; ++i) {
+        const uint16_t node = trie.AddNode();
+        for (int e = 0; e < 3; ++e) {
+            const uint16_t key = K(std::uniform_int_distribution<uint32_t>(0, 255)(rng), static_cast<uint8_t>(rng() & 63));
+            const KeyTarget t = KeyTarget::Action(static_cast<uint16_t>(i * 3 + e));
+            trie.SetEdge(node, key, t);
+            want[{node, key}] = t.raw;
+        }
+    }
+    bool building = true;
+    for (const auto& [k, raw] : want)
+        building &= trie.Step(k.first, k.second).raw == raw;
+    CHECK(building);
+
+    trie.Finalize();
+    bool finalized = true, misses = true;
+    for (const auto& [k, raw] : want) {
+        finalized &= trie.Step(k.first, k.second).raw == raw;
+        const uint16_t other = static_cast<uint16_t>(k.second ^ 1);
+        if (!want.count({k.first, other}))
+            misses &= trie.Step(k.first, other).IsNone();
+    }
+    CHECK(finalized);
+    CHECK(misses);
+    CHECK(trie.Step(static_cast<uint16_t>(trie.NodeCount() + 5), K('Q')).IsNone());
+}
+
+TEST(decoder_tracks_modifiers_and_repeats) {
+    constexpr uint32_t kSuper = 0x5B;
+    KeyDecoder d;
+    const auto key = [](uint32_t vk, bool down) { return input::MakeKey(vk, down, 0, 0); };
+    CHECK(d.Track(key(kSuper, true), kSuper) == KeyDecoder::Edge::SuperDown);
+    CHECK(d.Track(key(kSuper, true), kSuper) == KeyDecoder::Edge::Repeat);
+    CHECK(d.Track(key(0xA0, true), kSuper) == KeyDecoder::Edge::Modifier); // LSHIFT
+    CHECK(d.Track(key(0xA3, true), kSuper) == KeyDecoder::Edge::Modifier); // RCTRL
+    CHECK_EQ(d.Mods(), (1u << 0) | (1u << 3));
+    CHECK(d.Track(key('Q', true), kSuper) == KeyDecoder::Edge::Key);
+    CHECK(d.Track(key('Q', true), kSuper) == KeyDecoder::Edge::Repeat);
+    CHECK(d.Track(key('Q', false), kSuper) == KeyDecoder::Edge::Released);
+    CHECK(d.Track(key(0xA0, false), kSuper) == KeyDecoder::Edge::Released);
+    CHECK_EQ(d.Mods(), 1u << 3);
+    CHECK(d.Track(key(0x10, true), kSuper) == KeyDecoder::Edge::Modifier); // VK_SHIFT never binds
+
+    // SUPER up drops every held key and the sequence
+    Fixture f;
+    CHECK(d.Track(key('G', true), kSuper) == KeyDecoder::Edge::Key);
+    CHECK(d.Lookup(f.trie, input::MakeKey('G', true, 0, 10), kTimeout).result == Result::None); // RCTRL+G is unbound
+    CHECK(d.Track(key(0xA3, false), kSuper) == KeyDecoder::Edge::Released);
+    CHECK(d.Lookup(f.trie, input::MakeKey('G', true, 0, 20), kTimeout).result == Result::Pending);
+    CHECK(d.Sequencer().InSequence());
+    CHECK(d.Track(key(kSuper, false), kSuper) == KeyDecoder::Edge::SuperUp);
+    CHECK(!d.Sequencer().InSequence());
+    CHECK_EQ(d.Mods(), 0u);
+    CHECK(!d.IsKeySet('G'));
+    CHECK(!d.IsKeySet(0x10));
+}
@@ -0,0 +1,89 @@
+// tests/keybind_bench.cpp
+// Per-key lookup cost of the compiled keybind table against the unordered_map<KeyEvent, Actions4>
+// with its XOR hash that ProcessKey used before, at 10, 100 and 1000 binds. Half the looked-up
+// keys are bound; every lookup touches the first action so both sides pay for reaching it.
+//   keybind_bench [rounds]
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.hpp"
+#include "settings/action_vec.hpp"
+#include "settings/keybind_table.hpp"
+
+namespace {
+struct Key {
+    uint32_t vk = 0;
+    uint8_t modMask = 0;
+    bool operator==(const Key&) const = default;
+};
+
+// std::hash<KeyEvent> as it was
+struct KeyHash {
+    size_t operator()(const Key& k) const noexcept {
+        return std::hash<uint32_t>{}(k.vk) ^ (std::hash<uint8_t>{}(k.modMask) << 1);
+    }
+};
+
+// roughly the size of an Action (type id + params variant)
+struct FakeAction {
+    uint16_t typeId = 0;
+    uint8_t params[70]{};
+};
+using Actions = FixedActions<FakeAction, 4>;
+using Table = BasicKeybindTable<Key, Actions>;
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = bench::Rounds(argc, argv, 200);
+    std::mt19937 rng(5);
+
+    std::printf("%6s %12s %12s\n", "binds", "map", "table");
+    for (size_t count : {10, 100, 1000}) {
+        std::unordered_map<Key, Actions, KeyHash> map;
+        std::vector<Table::KeyBind> binds;
+        std::vector<Key> bound;
+        while (map.size() < count) {
+            // no modifier or a single one, as configs mostly bind
+            const uint32_t mod = rng() % 7;
+            const Key k{static_cast<uint32_t>(rng() & 0xFF), static_cast<uint8_t>(mod ? 1u << (mod - 1) : 0)};
+            if (map.count(k))
+                continue;
+            Actions a;
+            a.push_back(FakeAction{static_cast<uint16_t>(map.size())});
+            map.emplace(k, a);
+            binds.push_back({0, {k}, a, -1});
+            bound.push_back(k);
+        }
+        Table table;
+        table.Build(binds, 1);
+
+        std::vector<Key> keys(4096);
+        for (size_t i = 0; i < keys.size(); ++i)
+            keys[i] = i % 2 ? bound[rng() % bound.size()] : Key{static_cast<uint32_t>(rng() & 0xFF), static_cast<uint8_t>(rng() & 63)};
+
+        uint64_t sum = 0;
+        const auto t0 = bench::Clock::now();
+        for (int r = 0; r < rounds; ++r)
+            for (const Key& k : keys) {
+                const auto it = map.find(k);
+                if (it != map.end())
+                    sum += it->second[0].typeId;
+            }
+        const auto t1 = bench::Clock::now();
+        for (int r = 0; r < rounds; ++r)
+            for (const Key& k : keys) {
+                const KeyTarget t = table.Trie().Step(0, KeyTrie::KeyCode(k.vk, k.modMask));
+                if (t.IsAction())
+                    sum += table.ActionsAt(t.Index())[0].typeId;
+            }
+        const auto t2 = bench::Clock::now();
+        bench::Keep(sum);
+
+        const size_t ops = keys.size() * rounds;
+        std::printf("%6zu %9.2f ns %9.2f ns\n", count, bench::NsPer(t0, t1, ops), bench::NsPer(t1, t2, ops));
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// tests/keybind_table_test.cpp
+// The compiled (vk << 6 | modMask) root table against the unordered_map<KeyEvent, Actions4> it
+// replaced: same action list for every one of the 256 x 64 keys, bound or not, for random bind
+// sets of several sizes. Plus the conflicts Build() reports.
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "check.hpp"
+#include "settings/action_vec.hpp"
+#include "settings/keybind_table.hpp"
+
+namespace {
+struct Key {
+    uint32_t vk = 0;
+    uint8_t modMask = 0;
+    bool operator==(const Key&) const = default;
+};
+
+struct KeyHash {
+    size_t operator()(const Key& k) const noexcept {
+        return std::hash<uint32_t>{}(k.vk) ^ (std::hash<uint8_t>{}(k.modMask) << 1);
+    }
+};
+
+using Actions = FixedActions<int, 4>;
+using Table = BasicKeybindTable<Key, Actions>;
+using Bind = Table::KeyBind;
+
+Actions Of(int id) {
+    Actions a;
+    a.push_back(id);
+    a.push_back(-id);
+    return a;
+}
+} // namespace
+
+TEST(root_table_matches_map_for_every_key) {
+    std::mt19937 rng(19);
+    for (size_t count : {1, 10, 100, 1000, 5000}) {
+        std::unordered_map<Key, Actions, KeyHash> map;
+        std::vector<Bind> binds;
+        while (map.size() < count) {
+            const Key k{std::uniform_int_distribution<uint32_t>(0, 255)(rng), static_cast<uint8_t>(rng() & 63)};
+            if (map.count(k))
+                continue;
+            const int id = static_cast<int>(map.size()) + 1;
+            map.emplace(k, Of(id));
+            binds.push_back(Bind{0, {k}, Of(id), -1});
+        }
+
+        Table table;
+        CHECK(table.Build(binds, 1).empty());
+        CHECK_EQ(table.size(), count);
+
+        bool agree = true;
+        for (uint32_t vk = 0; vk < 256; ++vk)
+            for (uint8_t mods = 0; mods < 64; ++mods) {
+                const KeyTarget t = table.Trie().Step(0, KeyTrie::KeyCode(vk, mods));
+                const auto it = map.find(Key{vk, mods});
+                if (it == map.end()) {
+                    agree &= t.IsNone();
+                    continue;
+                }
+                agree &= t.IsAction();
+                if (!t.IsAction())
+                    continue;
+                const Actions& got = table.ActionsAt(t.Index());
+                agree &= got.count == it->second.count && got[0] == it->second[0] && got[1] == it->second[1];
+            }
+        CHECK(agree);
+    }
+}
+
+TEST(out_of_range_vk_is_skipped) {
+    Table table;
+    const std::vector<Bind> binds{{0, {Key{0x141, 0}}, Of(1), -1}, {0, {Key{0x41, 0}}, Of(2), -1}};
+    const std::vector<size_t> skipped = table.Build(binds, 1);
+    CHECK_EQ(skipped.size(), 1u);
+    CHECK_EQ(skipped[0], 0u);
+    // 0x141 must not alias 0x41 through the 8-bit vk field
+    const KeyTarget t = table.Trie().Step(0, KeyTrie::KeyCode(0x41, 0));
+    CHECK(t.IsAction() && table.ActionsAt(t.Index())[0] == 2);
+}
+
+TEST(prefix_conflicts_are_reported) {
+    Table table;
+    const Key g{'G', 0}, w{'W', 0}, x{'X', 0};
+    const std::vector<Bind> binds{
+      {0, {g}, Of(1), -1},         // G dispatches...
+      {0, {g, w}, Of(2), -1},      // ...so G W can never be reached
+      {0, {x, w}, Of(3), -1},      // X W
+      {0, {x}, Of(4), -1},         // X would shadow X W
+      {0, {Key{'S', 0}}, {}, 1},   // enter submap 1
+      {1, {Key{'S', 0}}, {}, 0},   // and back
+      {0, {Key{'T', 0}}, {}, 7},   // unknown submap
+    };
+    const std::vector<size_t> skipped = table.Build(binds, 2);
+    CHECK_EQ(skipped.size(), 3u);
+    if (skipped.size() == 3) {
+        CHECK_EQ(skipped[0], 1u);
+        CHECK_EQ(skipped[1], 3u);
+        CHECK_EQ(skipped[2], 6u);
+    }
+    const KeyTarget s = table.Trie().Step(0, KeyTrie::KeyCode('S', 0));
+    CHECK(s.IsNode() && s.Index() == 1);
+    CHECK(table.Trie().Step(1, KeyTrie::KeyCode('S', 0)) == KeyTarget::Node(0));
+}
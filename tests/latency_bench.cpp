@@ -0,0 +1,78 @@
+// tests/latency_bench.cpp
+// Cost of utils::latency::Histogram::Record() as the hooks pay it: one thread on a histogram of
+// its own, several threads sharing one stage, the max update on a rising series, and Snap() for
+// the report side.
+//   latency_bench [rounds]
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+#include "utils/latency.hpp"
+
+using utils::latency::Histogram;
+
+namespace {
+// hook-like latencies: mostly a few us, a tail into the ms
+std::vector<uint64_t> Samples(size_t n) {
+    std::mt19937_64 rng(3);
+    std::lognormal_distribution<double> dist(8.0, 1.2);
+    std::vector<uint64_t> out(n);
+    for (uint64_t& v : out)
+        v = static_cast<uint64_t>(dist(rng));
+    return out;
+}
+
+double RecordNs(Histogram& h, const std::vector<uint64_t>& samples, int rounds) {
+    const auto t0 = bench::Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (uint64_t v : samples)
+            h.Record(v);
+    const auto t1 = bench::Clock::now();
+    return bench::NsPer(t0, t1, samples.size() * rounds);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = bench::Rounds(argc, argv, 100);
+    const std::vector<uint64_t> samples = Samples(1 << 16);
+
+    Histogram own;
+    std::printf("%-28s %8.2f ns\n", "Record, one thread", RecordNs(own, samples, rounds));
+
+    std::vector<uint64_t> rising(samples.size());
+    for (size_t i = 0; i < rising.size(); ++i)
+        rising[i] = i * 10;
+    Histogram maxes;
+    std::printf("%-28s %8.2f ns\n", "Record, new max every call", RecordNs(maxes, rising, rounds));
+
+    for (int threads : {2, 4}) {
+        Histogram shared;
+        std::vector<std::thread> workers;
+        const auto t0 = bench::Clock::now();
+        for (int t = 0; t < threads; ++t)
+            workers.emplace_back([&] { RecordNs(shared, samples, rounds); });
+        for (std::thread& w : workers)
+            w.join();
+        const auto t1 = bench::Clock::now();
+        char label[64];
+        std::snprintf(label, sizeof label, "Record, %d threads shared", threads);
+        std::printf("%-28s %8.2f ns (wall per record)\n", label, bench::NsPer(t0, t1, samples.size() * rounds * threads));
+    }
+
+    const int snaps = 10 * rounds;
+    uint64_t sum = 0;
+    const auto t0 = bench::Clock::now();
+    for (int i = 0; i < snaps; ++i)
+        sum += own.Snap().p99;
+    const auto t1 = bench::Clock::now();
+    bench::Keep(sum);
+    std::printf("%-28s %8.2f us\n", "Snap", bench::NsPer(t0, t1, snaps) / 1000.0);
+
+    const Histogram::Snapshot s = own.Snap();
+    std::printf("\nsamples p50=%llu p99=%llu p999=%llu max=%llu ns\n", static_cast<unsigned long long>(s.p50), static_cast<unsigned long long>(s.p99),
+      static_cast<unsigned long long>(s.p999), static_cast<unsigned long long>(s.max));
+    return 0;
+}
@@ -0,0 +1,149 @@
+// tests/live_throttle_test.cpp
+// Live-drag pacing against a simulated backend: a 144 Hz overlay offers new bounds every frame and
+// each apply blocks the applier for the window's turnaround, the way SetWindowPos on another
+// thread's window does. Fast and slow windows converge to the min/max interval clamps and a
+// middling one to turnaround * headroom; BeginDrag keeps the estimate; ThrottleTable clears at
+// kMaxApps.
+#include <cstdint>
+
+#include "check.hpp"
+#include "utils/live_throttle.hpp"
+
+using namespace utils::live;
+
+namespace {
+constexpr uint64_t kMs = 1'000'000;
+constexpr uint64_t kFrame = 1'000'000'000ull / 144;
+
+// A window whose owning thread takes turnaroundNs to handle each resize
+struct SlowWindow {
+    uint64_t turnaroundNs;
+    uint64_t applies = 0;
+};
+
+// The LiveLoop applier over simulated time: bounds arrive every overlay frame, newer ones replace
+// unapplied ones, an apply happens once the app is due. Returns when the drag has run lengthNs.
+uint64_t Drag(AppThrottle& app, SlowWindow& w, const ThrottleConfig& c, uint64_t startNs, uint64_t lengthNs) {
+    app.BeginDrag();
+    uint64_t now = startNs;
+    bool pending = false;
+    uint64_t nextFrame = startNs;
+    while (now < startNs + lengthNs) {
+        if (now >= nextFrame) {
+            pending = true;
+            nextFrame += kFrame;
+        }
+        if (pending && app.Due(now, c)) {
+            const uint64_t start = now;
+            now += w.turnaroundNs; // blocked in SetWindowPos
+            app.Applied(start, w.turnaroundNs, c);
+            ++w.applies;
+            pending = false;
+            continue;
+        }
+        // sleep to whichever comes first: the next frame or the app being due
+        const uint64_t due = pending ? app.DueAt(c) : nextFrame;
+        now = due < nextFrame ? due : nextFrame;
+    }
+    return now;
+}
+
+bool Within(uint64_t v, uint64_t lo, uint64_t hi) {
+    return v >= lo && v <= hi;
+}
+} // namespace
+
+TEST(fast_window_converges_to_the_min_interval) {
+    const ThrottleConfig c;
+    AppThrottle app;
+    SlowWindow w{1 * kMs};
+    Drag(app, w, c, 0, 1000 * kMs);
+    CHECK_EQ(app.TurnaroundNs(), 1 * kMs);
+    CHECK_EQ(app.IntervalNs(c), c.minIntervalNs);
+    // one apply per min interval, rounded up to the overlay frame that brings new bounds
+    CHECK(Within(w.applies, 1000 / 14, 1000 / 8 + 1));
+}
+
+TEST(slow_window_converges_to_the_max_interval) {
+    const ThrottleConfig c;
+    AppThrottle app;
+    SlowWindow w{180 * kMs}; // 180 ms * 1.5 = 270 ms, over the 200 ms cap
+    Drag(app, w, c, 0, 4000 * kMs);
+    CHECK_EQ(app.TurnaroundNs(), 180 * kMs);
+    CHECK_EQ(app.IntervalNs(c), c.maxIntervalNs);
+    CHECK(Within(w.applies, 4000 / 200 - 1, 4000 / 200 + 1)); // 5 updates/s, no more
+}
+
+TEST(middling_window_gets_turnaround_times_headroom) {
+    const ThrottleConfig c;
+    AppThrottle app;
+    SlowWindow w{40 * kMs};
+    Drag(app, w, c, 0, 3000 * kMs);
+    CHECK_EQ(app.IntervalNs(c), 60 * kMs);
+    CHECK(Within(w.applies, 3000 / 63, 3000 / 60 + 1));
+}
+
+TEST(estimate_follows_a_window_that_slows_down) {
+    const ThrottleConfig c;
+    AppThrottle app;
+    SlowWindow w{2 * kMs};
+    uint64_t now = Drag(app, w, c, 0, 500 * kMs);
+    CHECK_EQ(app.IntervalNs(c), c.minIntervalNs);
+
+    // the app starts repainting heavily: EWMA, so a few samples in it is between the two
+    w.turnaroundNs = 100 * kMs;
+    now = Drag(app, w, c, now, 300 * kMs);
+    CHECK(app.TurnaroundNs() > 2 * kMs && app.TurnaroundNs() < 100 * kMs);
+    Drag(app, w, c, now, 6000 * kMs);
+    CHECK(Within(app.TurnaroundNs(), 99 * kMs, 100 * kMs));
+    CHECK(Within(app.IntervalNs(c), 149 * kMs, 150 * kMs));
+}
+
+TEST(begin_drag_keeps_the_estimate) {
+    const ThrottleConfig c;
+    AppThrottle app;
+    SlowWindow w{120 * kMs};
+    const uint64_t end = Drag(app, w, c, 0, 2000 * kMs);
+    const uint64_t turnaround = app.TurnaroundNs();
+    const uint64_t interval = app.IntervalNs(c);
+    CHECK_EQ(interval, 180 * kMs);
+    CHECK(!app.Due(end, c)); // mid-drag the last apply still holds the next one back
+
+    app.BeginDrag();
+    CHECK(app.Due(end, c)); // a new drag applies its first bounds at once
+    CHECK_EQ(app.DueAt(c), 0u);
+    CHECK_EQ(app.TurnaroundNs(), turnaround);
+    CHECK_EQ(app.IntervalNs(c), interval);
+
+    // and goes straight to the learned rate instead of relearning from the first sample
+    app.Applied(end, 120 * kMs, c);
+    CHECK_EQ(app.DueAt(c), end + interval);
+}
+
+TEST(first_sample_sets_the_estimate) {
+    const ThrottleConfig c;
+    AppThrottle app;
+    CHECK_EQ(app.IntervalNs(c), c.minIntervalNs); // unknown app: display rate
+    CHECK(app.Due(0, c));
+    app.Applied(10 * kMs, 50 * kMs, c);
+    CHECK_EQ(app.TurnaroundNs(), 50 * kMs);
+    CHECK_EQ(app.DueAt(c), 10 * kMs + 75 * kMs);
+}
+
+TEST(table_keeps_apps_apart_and_clears_at_max_apps) {
+    const ThrottleConfig c;
+    ThrottleTable table;
+    for (uint64_t key = 1; key <= ThrottleTable::kMaxApps; ++key)
+        table.For(key).Applied(0, key * kMs, c);
+    CHECK_EQ(table.For(7).TurnaroundNs(), 7 * kMs);
+    CHECK_EQ(table.For(ThrottleTable::kMaxApps).TurnaroundNs(), ThrottleTable::kMaxApps * kMs);
+
+    // full: known apps keep their estimates
+    table.For(1);
+    CHECK_EQ(table.For(200).TurnaroundNs(), 200 * kMs);
+
+    // a new app past kMaxApps clears everything; the estimates are relearned
+    CHECK_EQ(table.For(ThrottleTable::kMaxApps + 1).TurnaroundNs(), 0u);
+    CHECK_EQ(table.For(7).TurnaroundNs(), 0u);
+    CHECK_EQ(table.For(200).TurnaroundNs(), 0u);
+}
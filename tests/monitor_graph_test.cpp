@@ -0,0 +1,120 @@
+// tests/monitor_graph_test.cpp
+// Monitor neighbours for the layouts MoveWindowTo*Mon has to handle: side by side, stacked with an
+// offset, L-shapes (diagonal fallback), touching edges vs nearer centres, mixed-DPI rounding gaps,
+// a split edge, mirrored displays, and regular grids of any size.
+#include <cstdint>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/monitor_graph.hpp"
+
+using namespace utils;
+using namespace utils::mon;
+using spatial::Dir;
+
+namespace {
+Monitor M(uint64_t key, int32_t l, int32_t t, int32_t r, int32_t b, uint32_t dpi = 96) {
+    return {key, {l, t, r, b}, {l, t, r, b - 40}, dpi, 60};
+}
+
+// key of the neighbour, 0 for none
+uint64_t N(const Topology& t, uint64_t key, Dir dir) {
+    const Monitor* m = t.Neighbour(key, dir);
+    return m ? m->key : 0;
+}
+} // namespace
+
+TEST(side_by_side) {
+    const Topology t = BuildTopology({M(1, 0, 0, 1920, 1080), M(2, 1920, 0, 3840, 1080), M(3, -1920, 0, 0, 1080)});
+    CHECK_EQ(N(t, 1, Dir::Right), 2u);
+    CHECK_EQ(N(t, 1, Dir::Left), 3u);
+    CHECK_EQ(N(t, 2, Dir::Left), 1u);
+    CHECK_EQ(N(t, 3, Dir::Right), 1u);
+    CHECK_EQ(N(t, 2, Dir::Right), 0u);
+    CHECK_EQ(N(t, 1, Dir::Up), 0u);
+    CHECK_EQ(N(t, 1, Dir::Down), 0u);
+}
+
+TEST(stacked_with_offset) {
+    // laptop below a wide monitor, right-aligned
+    const Topology t = BuildTopology({M(1, 0, 0, 2560, 1440), M(2, 640, 1440, 2560, 2520)});
+    CHECK_EQ(N(t, 1, Dir::Down), 2u);
+    CHECK_EQ(N(t, 2, Dir::Up), 1u);
+    CHECK_EQ(N(t, 1, Dir::Left), 0u);
+    CHECK_EQ(N(t, 2, Dir::Right), 0u);
+}
+
+TEST(l_shape_uses_diagonal_fallback) {
+    // 1 top-left, 2 below 1, 3 right of 2
+    const Topology t = BuildTopology({M(1, 0, 0, 1920, 1080), M(2, 0, 1080, 1920, 2160), M(3, 1920, 1080, 3840, 2160)});
+    CHECK_EQ(N(t, 1, Dir::Down), 2u);
+    CHECK_EQ(N(t, 2, Dir::Up), 1u);
+    CHECK_EQ(N(t, 2, Dir::Right), 3u);
+    CHECK_EQ(N(t, 3, Dir::Left), 2u);
+    CHECK_EQ(N(t, 1, Dir::Right), 3u); // only across the corner
+    CHECK_EQ(N(t, 3, Dir::Up), 1u);
+}
+
+TEST(shared_edge_beats_nearer_centre) {
+    // 2 touches 1's right edge but is centred far below; 3 is centred level with 1 but further away
+    const Topology t = BuildTopology({M(1, 0, 0, 1920, 1080), M(2, 1920, 900, 3000, 2820), M(3, 2400, 0, 4320, 800)});
+    CHECK_EQ(N(t, 1, Dir::Right), 2u);
+}
+
+TEST(mixed_dpi_rounding_gaps) {
+    // 4K at 150% next to 1080p at 100%: a few px of overlap/gap from scaled coordinates
+    const Topology t = BuildTopology({M(1, 0, 0, 3840, 2160, 144), M(2, 3836, 400, 5756, 1480), M(3, 1000, 2163, 2920, 3243)});
+    CHECK_EQ(N(t, 1, Dir::Right), 2u);
+    CHECK_EQ(N(t, 2, Dir::Left), 1u);
+    CHECK_EQ(N(t, 1, Dir::Down), 3u);
+    CHECK_EQ(N(t, 3, Dir::Up), 1u);
+    CHECK_EQ(N(t, 2, Dir::Down), 3u);
+    CHECK_EQ(t.monitors[t.Find(1)].dpi, 144u);
+}
+
+TEST(split_edge_takes_longest_share) {
+    // two monitors stacked right of a tall one
+    const Topology t = BuildTopology({M(1, 0, 0, 1920, 2160), M(2, 1920, 0, 3840, 500), M(3, 1920, 500, 3840, 2160)});
+    CHECK_EQ(N(t, 1, Dir::Right), 3u);
+    CHECK_EQ(N(t, 2, Dir::Left), 1u);
+    CHECK_EQ(N(t, 3, Dir::Left), 1u);
+    CHECK_EQ(N(t, 2, Dir::Down), 3u);
+    CHECK_EQ(N(t, 3, Dir::Up), 2u);
+}
+
+TEST(mirrored_displays_have_no_neighbours) {
+    const Topology t = BuildTopology({M(1, 0, 0, 1920, 1080), M(2, 0, 0, 1920, 1080)});
+    for (int d = 0; d < 4; ++d) {
+        CHECK_EQ(N(t, 1, static_cast<Dir>(d)), 0u);
+        CHECK_EQ(N(t, 2, static_cast<Dir>(d)), 0u);
+    }
+}
+
+TEST(unknown_monitor) {
+    const Topology t = BuildTopology({M(1, 0, 0, 1920, 1080)});
+    CHECK(t.Neighbour(42, Dir::Left) == nullptr);
+    CHECK_EQ(t.Find(42), kNoMonitor);
+    CHECK(BuildTopology({}).Neighbour(1, Dir::Up) == nullptr);
+}
+
+// cols x rows of equal monitors: neighbours are exactly the adjacent cells, edges have none
+TEST(regular_grids) {
+    for (int cols = 1; cols <= 4; ++cols)
+        for (int rows = 1; rows <= 3; ++rows) {
+            std::vector<Monitor> monitors;
+            for (int r = 0; r < rows; ++r)
+                for (int c = 0; c < cols; ++c)
+                    monitors.push_back(M(static_cast<uint64_t>(r * cols + c + 1), c * 1920 - 1920, r * 1080, c * 1920, (r + 1) * 1080));
+            const Topology t = BuildTopology(monitors);
+            const auto key = [&](int c, int r) -> uint64_t {
+                return c < 0 || c >= cols || r < 0 || r >= rows ? 0 : static_cast<uint64_t>(r * cols + c + 1);
+            };
+            for (int r = 0; r < rows; ++r)
+                for (int c = 0; c < cols; ++c) {
+                    CHECK_EQ(N(t, key(c, r), Dir::Left), key(c - 1, r));
+                    CHECK_EQ(N(t, key(c, r), Dir::Right), key(c + 1, r));
+                    CHECK_EQ(N(t, key(c, r), Dir::Up), key(c, r - 1));
+                    CHECK_EQ(N(t, key(c, r), Dir::Down), key(c, r + 1));
+                }
+        }
+}
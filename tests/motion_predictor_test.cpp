@@ -0,0 +1,214 @@
+// tests/motion_predictor_test.cpp
+// SampleRing reads (oldest first, overwritten samples dropped, and under a writer lapping a
+// small ring no torn sample ever delivered; build with -DHYPRWIN_TSAN=ON for the stress run) and
+// the Predictor's self-scoring: gain 0 until predictions have been checked, close to 1 on steady
+// motion, back to ~0 on jitter, and no lead after a pause.
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/motion_predictor.hpp"
+
+using namespace utils::motion;
+
+namespace {
+constexpr uint64_t kMs = 1'000'000;
+
+// every field derived from the index, so a sample mixed from two pushes is detectable
+Sample Nth(uint64_t i) {
+    return {1000 + i * kMs, static_cast<int32_t>(i), -static_cast<int32_t>(i)};
+}
+
+bool IsNth(const Sample& s, uint64_t i) {
+    const Sample n = Nth(i);
+    return s.tNs == n.tNs && s.x == n.x && s.y == n.y;
+}
+
+struct Drive {
+    Predictor p;
+    uint64_t t = 0;
+
+    // 1 kHz samples, a 144 Hz frame predicting one frame ahead
+    Predictor::Point Run(uint32_t samples, float vx, float vy, float jitter, std::mt19937& rng, float& x, float& y) {
+        std::uniform_real_distribution<float> noise(-jitter, jitter);
+        Predictor::Point q{};
+        for (uint32_t i = 0; i < samples; ++i) {
+            t += kMs;
+            x += vx;
+            y += vy;
+            const float jx = jitter > 0 ? noise(rng) : 0.f, jy = jitter > 0 ? noise(rng) : 0.f;
+            p.Update({t, static_cast<int32_t>(std::lround(x + jx)), static_cast<int32_t>(std::lround(y + jy))});
+            if (i % 7 == 0)
+                q = p.Predict(t + 7 * kMs);
+        }
+        return q;
+    }
+};
+} // namespace
+
+TEST(ring_reads_oldest_first_and_resumes) {
+    SampleRing<8> ring;
+    std::vector<Sample> got;
+    const auto collect = [&](const Sample& s) { got.push_back(s); };
+
+    CHECK_EQ(ring.ReadSince(0, collect), 0u);
+    CHECK(got.empty());
+
+    for (uint64_t i = 0; i < 5; ++i)
+        ring.Push(Nth(i));
+    uint64_t pos = ring.ReadSince(0, collect);
+    CHECK_EQ(pos, 5u);
+    CHECK_EQ(got.size(), 5u);
+    bool inOrder = true;
+    for (uint64_t i = 0; i < got.size(); ++i)
+        inOrder &= IsNth(got[i], i);
+    CHECK(inOrder);
+
+    // only what arrived since the returned position
+    got.clear();
+    CHECK_EQ(ring.ReadSince(pos, collect), 5u);
+    CHECK(got.empty());
+    ring.Push(Nth(5));
+    pos = ring.ReadSince(pos, collect);
+    CHECK_EQ(pos, 6u);
+    CHECK_EQ(got.size(), 1u);
+    CHECK(IsNth(got[0], 5));
+}
+
+TEST(ring_skips_overwritten_samples) {
+    SampleRing<8> ring;
+    std::vector<Sample> got;
+    const auto collect = [&](const Sample& s) { got.push_back(s); };
+
+    // 20 pushes into 8 slots: a reader at 0 gets the newest N - 1, oldest first
+    for (uint64_t i = 0; i < 20; ++i)
+        ring.Push(Nth(i));
+    CHECK_EQ(ring.ReadSince(0, collect), 20u);
+    CHECK_EQ(got.size(), 7u);
+    bool newest = true;
+    for (uint64_t i = 0; i < got.size(); ++i)
+        newest &= IsNth(got[i], 13 + i);
+    CHECK(newest);
+
+    // same for a reader that fell behind part way
+    got.clear();
+    for (uint64_t i = 20; i < 30; ++i)
+        ring.Push(Nth(i));
+    CHECK_EQ(ring.ReadSince(18, collect), 30u);
+    CHECK_EQ(got.size(), 7u);
+    CHECK(IsNth(got.front(), 23));
+    CHECK(IsNth(got.back(), 29));
+}
+
+TEST(ring_never_delivers_a_torn_sample) {
+    // 4 slots: the writer laps the reader constantly, so reads race with overwrites
+    SampleRing<4> ring;
+    constexpr uint64_t kPushes = 400000;
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        for (uint64_t i = 0; i < kPushes; ++i) {
+            ring.Push(Nth(i));
+            if (i % 256 == 0)
+                std::this_thread::yield();
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint64_t pos = 0, delivered = 0;
+    bool consistent = true, ordered = true;
+    int64_t last = -1;
+    while (!done.load(std::memory_order_acquire) || pos < ring.Head()) {
+        pos = ring.ReadSince(pos, [&](const Sample& s) {
+            const int64_t i = s.x;
+            consistent &= i >= 0 && IsNth(s, static_cast<uint64_t>(i));
+            ordered &= i > last;
+            last = i;
+            ++delivered;
+        });
+        std::this_thread::yield();
+    }
+    writer.join();
+
+    CHECK(consistent);
+    CHECK(ordered);
+    CHECK(delivered > 0);
+    CHECK(delivered <= kPushes);
+    CHECK_EQ(last, static_cast<int64_t>(kPushes - 1)); // the final sample is always readable
+}
+
+TEST(gain_starts_at_zero) {
+    Predictor p;
+    CHECK_EQ(p.Gain(), 0.f);
+    const Predictor::Point none = p.Predict(10 * kMs);
+    CHECK_EQ(none.x, 0.f);
+    CHECK_EQ(none.y, 0.f);
+
+    // moving fast, but nothing scored yet: no lead
+    for (uint64_t i = 1; i <= 6; ++i)
+        p.Update({i * kMs, static_cast<int32_t>(i * 5), 100});
+    CHECK_EQ(p.Gain(), 0.f);
+    const Predictor::Point q = p.Predict(14 * kMs);
+    CHECK_EQ(q.x, 30.f);
+    CHECK_EQ(q.y, 100.f);
+}
+
+TEST(steady_motion_earns_lead) {
+    std::mt19937 rng(3);
+    Drive d;
+    float x = 0, y = 0;
+    const Predictor::Point q = d.Run(500, 2.f, 1.f, 0.f, rng, x, y);
+    CHECK(d.p.Gain() > 0.9f);
+    CHECK(d.p.ErrorPredicted() < d.p.ErrorNone() / 5);
+    // predicted ahead of the last sample along the motion, about 7 ms worth
+    CHECK(q.x > x + 8.f && q.x < x + 20.f);
+    CHECK(q.y > y + 4.f && q.y < y + 10.f);
+}
+
+TEST(jitter_falls_back_to_no_prediction) {
+    std::mt19937 rng(5);
+    Drive d;
+    float x = 500, y = 500;
+    d.Run(500, 2.f, 0.f, 0.f, rng, x, y);
+    const float earned = d.p.Gain();
+    CHECK(earned > 0.9f);
+
+    // hand resting on the mouse: +-3 px noise around a fixed point
+    d.Run(3000, 0.f, 0.f, 3.f, rng, x, y);
+    CHECK(d.p.Gain() < 0.2f);
+    CHECK(d.p.Gain() < earned);
+    const Predictor::Point q = d.p.Predict(d.t + 7 * kMs);
+    CHECK(std::hypot(q.x - x, q.y - y) < 6.f); // stays within the noise, no runaway lead
+}
+
+TEST(pause_restarts_the_filter) {
+    std::mt19937 rng(7);
+    Drive d;
+    float x = 0, y = 0;
+    d.Run(300, 3.f, 0.f, 0.f, rng, x, y);
+    CHECK(d.p.Gain() > 0.5f);
+
+    // 150 ms without samples, then one: velocity is forgotten, the prediction is the sample
+    d.t += 150 * kMs;
+    d.p.Update({d.t, 2000, 2000});
+    const Predictor::Point q = d.p.Predict(d.t + 7 * kMs);
+    CHECK_EQ(q.x, 2000.f);
+    CHECK_EQ(q.y, 2000.f);
+}
+
+TEST(evaluate_beats_no_prediction_on_steady_motion) {
+    std::vector<Sample> moves;
+    for (uint64_t i = 0; i < 2000; ++i)
+        moves.push_back({i * kMs, static_cast<int32_t>(i * 2), static_cast<int32_t>(500 + i / 2)});
+    const Evaluation ev = Evaluate(moves.data(), moves.size(), 16 * kMs);
+    CHECK(ev.predictions > 1900);
+    CHECK(ev.meanErrorPx < ev.meanErrorNonePx / 2);
+    CHECK(ev.meanLeadPx > 0.0);
+
+    // nothing to predict across an idle gap
+    std::vector<Sample> idle{{0, 0, 0}, {200 * kMs, 10, 10}};
+    CHECK_EQ(Evaluate(idle.data(), idle.size(), 16 * kMs).predictions, 0u);
+}
@@ -0,0 +1,211 @@
+// tests/overlay_frames_test.cpp
+// The overlay frame loop driven headless: a synthetic 1 kHz cursor path goes through the drag
+// kernel (as OverlayController's onFrame does), the resulting size and gradient phase through
+// DamageTracker (as OverlayWindow::Render does) and the frame through PaceFrame with a fake clock.
+// Checks frames.drawn / frames.skipped for move and resize drags, still stretches that must not
+// draw or tick, and a rotating gradient that keeps drawing while the cursor rests.
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/drag_geometry.hpp"
+#include "utils/frame_damage.hpp"
+#include "utils/frame_loop.hpp"
+#include "utils/gradient.hpp"
+
+using namespace utils;
+
+namespace {
+constexpr uint64_t kMs = 1'000'000;
+constexpr uint64_t kPeriod = 1'000'000'000ull / 144;
+
+bool Same(geom::Point a, geom::Point b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+struct FakeClock {
+    uint64_t now = 0;
+    uint64_t Now() const { return now; }
+    void SleepUntil(uint64_t ns) {
+        if (ns > now)
+            now = ns;
+    }
+};
+
+// Piecewise-linear cursor sampled at 1 kHz: each segment moves (vx, vy) px per ms, or rests
+struct Path {
+    struct Segment {
+        uint64_t lengthNs;
+        int32_t vx, vy;
+    };
+    geom::Point origin;
+    std::vector<Segment> segments;
+
+    geom::Point At(uint64_t t) const {
+        geom::Point p = origin;
+        uint64_t start = 0;
+        for (const Segment& s : segments) {
+            const uint64_t inside = t < start ? 0 : (t - start < s.lengthNs ? t - start : s.lengthNs);
+            const int32_t ms = static_cast<int32_t>(inside / kMs);
+            p.x += s.vx * ms;
+            p.y += s.vy * ms;
+            start += s.lengthNs;
+        }
+        return p;
+    }
+
+    // When the next sample that differs from the one at t arrives (end of a rest), or `until`
+    uint64_t NextChange(uint64_t t, uint64_t until) const {
+        const geom::Point now = At(t);
+        for (uint64_t next = (t / kMs + 1) * kMs; next < until; next += kMs)
+            if (!Same(At(next), now))
+                return next;
+        return until;
+    }
+};
+
+struct Counts {
+    uint64_t drawn, skipped, frames, idle;
+};
+
+// onFrame + Render + PaceFrame, as OverlayController::OverlayLoop and OverlayWindow::PreRender run them
+struct Headless {
+    enum class Action { Move, Resize };
+
+    FakeClock clock;
+    pacing::FramePacer<FakeClock> pacer;
+    render::DamageTracker damage;
+    render::Counters counters;
+    const Path& path;
+    Action action;
+    geom::Rect start{100, 100, 900, 700};
+    geom::ResizeParams resize;
+    float rotationSpeed = 0; // deg/s, 0 = static gradient
+    float phase = 0;
+    uint64_t lastRotate = UINT64_MAX;
+    geom::Point last{INT_MIN, INT_MIN};
+
+    static pacing::PacerConfig Config() {
+        pacing::PacerConfig c;
+        c.periodNs = kPeriod;
+        c.idlePeriodNs = 33'333'333;
+        c.idleAfterNs = 250'000'000;
+        return c;
+    }
+
+    Headless(const Path& p, Action a) : pacer(clock, Config()), path(p), action(a) {
+        resize.start = start;
+        resize.startCursor = p.origin;
+        resize.corner = geom::PickCorner(start, p.origin);
+        resize.minSize = {200, 150};
+    }
+
+    void RunUntil(uint64_t until) {
+        while (clock.now < until) {
+            // onFrame
+            const geom::Point cursor = path.At(clock.now);
+            const bool moved = !Same(cursor, last);
+            last = cursor;
+            const geom::Point grab{path.origin.x - start.left, path.origin.y - start.top};
+            const geom::Rect bounds = action == Action::Move ? geom::MoveTo(start, grab, cursor) : geom::Resize(resize, cursor);
+
+            // Render: only size, style and phase are damage, never the position
+            if (rotationSpeed != 0) {
+                const float dt = lastRotate != UINT64_MAX ? static_cast<float>(clock.now - lastRotate) / 1e9f : 0.f;
+                lastRotate = clock.now;
+                phase = gradient::Advance(phase, rotationSpeed, dt);
+            }
+            const bool drawn = damage.Commit({bounds.Width(), bounds.Height(), 96, 0, phase});
+
+            clock.now += drawn ? kPeriod : 200'000; // a drawn frame's Present blocks until vblank
+            render::PaceFrame(pacer, counters, moved, drawn, true, [&] { clock.now = path.NextChange(clock.now, until); });
+        }
+    }
+
+    Counts Snap() const {
+        return {counters.framesDrawn.load(), counters.framesSkipped.load(), counters.frames.load(), counters.idleFrames.load()};
+    }
+};
+
+// frames at kPeriod in a stretch of ns, give or take the one in flight at either end
+bool AboutFrames(uint64_t frames, uint64_t ns) {
+    const uint64_t want = ns / kPeriod;
+    return frames + 2 >= want && frames <= want + 2;
+}
+} // namespace
+
+TEST(move_drag_draws_once_and_rests_without_ticking) {
+    const Path path{{500, 400}, {{500 * kMs, 2, 1}, {1000 * kMs, 0, 0}, {500 * kMs, -3, 0}}};
+    Headless h(path, Headless::Action::Move);
+
+    h.RunUntil(500 * kMs);
+    const Counts moving = h.Snap();
+    CHECK_EQ(moving.drawn, 1u); // the first frame; moving the window alone is no damage
+    CHECK(AboutFrames(moving.frames, 500 * kMs));
+    CHECK_EQ(moving.skipped, moving.frames - 1);
+
+    h.RunUntil(1500 * kMs);
+    const Counts rested = h.Snap();
+    CHECK_EQ(rested.drawn, 1u);
+    CHECK(rested.frames - moving.frames <= 1); // parked on input, not ticking at the idle cap
+    CHECK(rested.skipped - moving.skipped <= 2);
+
+    h.RunUntil(2000 * kMs);
+    const Counts done = h.Snap();
+    CHECK_EQ(done.drawn, 1u);
+    CHECK(AboutFrames(done.frames - rested.frames, 500 * kMs));
+    CHECK_EQ(done.idle, 0u);
+}
+
+TEST(resize_drag_draws_every_moved_frame) {
+    const Path path{{900, 700}, {{400 * kMs, 1, 1}, {600 * kMs, 0, 0}, {300 * kMs, -1, 0}}};
+    Headless h(path, Headless::Action::Resize);
+
+    h.RunUntil(400 * kMs);
+    const Counts growing = h.Snap();
+    CHECK(AboutFrames(growing.frames, 400 * kMs));
+    CHECK_EQ(growing.drawn, growing.frames); // at 1 kHz input every frame sees a new size
+    CHECK_EQ(growing.skipped, 0u);
+
+    h.RunUntil(1000 * kMs);
+    const Counts rested = h.Snap();
+    CHECK(rested.drawn - growing.drawn <= 1); // the last sample of the drag may land after 400 ms
+    CHECK(rested.frames - growing.frames <= 1);
+
+    h.RunUntil(1300 * kMs);
+    const Counts done = h.Snap();
+    CHECK(AboutFrames(done.drawn - rested.drawn, 300 * kMs));
+}
+
+TEST(resize_pinned_at_min_size_skips) {
+    // dragging the bottom-right corner far up-left: the size pins at minSize while the cursor moves
+    const Path path{{900, 700}, {{300 * kMs, -10, -10}}};
+    Headless h(path, Headless::Action::Resize);
+    h.RunUntil(300 * kMs);
+    const Counts c = h.Snap();
+    CHECK(AboutFrames(c.frames, 300 * kMs));
+    CHECK(c.drawn < c.frames / 3); // 600 px wide -> 200 px min in the first 60 ms
+    CHECK(c.skipped > c.frames / 2);
+    CHECK_EQ(c.drawn + c.skipped, c.frames);
+}
+
+TEST(rotating_gradient_draws_while_the_cursor_rests) {
+    const Path path{{500, 400}, {{100 * kMs, 1, 0}, {1000 * kMs, 0, 0}}};
+    Headless h(path, Headless::Action::Move);
+    h.rotationSpeed = 120;
+
+    h.RunUntil(100 * kMs);
+    const Counts moving = h.Snap();
+    CHECK_EQ(moving.drawn, moving.frames);
+
+    h.RunUntil(1100 * kMs);
+    const Counts rested = h.Snap();
+    const uint64_t frames = rested.frames - moving.frames;
+    CHECK_EQ(rested.drawn - moving.drawn, frames); // the phase is damage every frame
+    CHECK_EQ(rested.skipped, moving.skipped);
+    // 250 ms at refresh rate, then the idle cap for the rest of the second
+    CHECK(rested.idle > 0);
+    CHECK(frames < 1000 * kMs / kPeriod / 2);
+    CHECK(frames > 250 * kMs / kPeriod);
+}
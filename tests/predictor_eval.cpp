@@ -0,0 +1,52 @@
+// tests/predictor_eval.cpp
+// Offline check of the cursor predictor (PREDICT_CURSOR) on the moves of an input.trace recorded
+// by the app (tray > Input Trace): mean error with and without prediction per horizon.
+//   predictor_eval <file.trace> [--horizon MS]...
+// Without --horizon: one, two and four frames at 120 Hz-ish (8, 16.7 and 33.3 ms).
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "inputTrace.hpp"
+#include "utils/motion_predictor.hpp"
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    std::vector<uint64_t> horizons;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--horizon") == 0 && i + 1 < argc)
+            horizons.push_back(static_cast<uint64_t>(std::atof(argv[++i]) * 1e6));
+        else
+            path = argv[i];
+    }
+    if (!path) {
+        std::fprintf(stderr, "usage: %s <file.trace> [--horizon MS]...\n", argv[0]);
+        return 2;
+    }
+    if (horizons.empty())
+        horizons = {8'000'000ull, 16'666'667ull, 33'333'333ull};
+
+    std::vector<input::Event> events;
+    std::string error;
+    if (!input::trace::Load(path, events, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    std::vector<utils::motion::Sample> moves;
+    for (const input::Event& ev : events)
+        if (ev.kind == input::Kind::Move)
+            moves.push_back({ev.captureNs, ev.x, ev.y});
+    std::printf("moves    %zu of %zu events\n", moves.size(), events.size());
+
+    std::printf("%10s %12s %12s %12s %12s\n", "horizon", "predictions", "error px", "none px", "lead px");
+    for (const uint64_t h : horizons) {
+        const utils::motion::Evaluation r = utils::motion::Evaluate(moves.data(), moves.size(), h);
+        std::printf("%7.1f ms %12llu %12.2f %12.2f %12.2f\n", h / 1e6, static_cast<unsigned long long>(r.predictions), r.meanErrorPx, r.meanErrorNonePx,
+          r.meanLeadPx);
+    }
+    return 0;
+}
@@ -0,0 +1,141 @@
+// tests/process_cache_bench.cpp
+// Window -> process name lookups the way GetProcessNameId does them, against the uncached path
+// it replaced (build the image path string, cut the file name, compare case-insensitively):
+// a hot set of processes with a long tail of one-off ones, some pids reused by new processes.
+// Prints ns per lookup and the cache's hit/stale/eviction counts; nothing is asserted.
+//   process_cache_bench [rounds]
+#include <cstdint>
+#include <cstdio>
+#include <cwctype>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench.hpp"
+#include "utils/process_cache.hpp"
+
+using namespace utils::proc;
+
+namespace {
+struct Process {
+    uint32_t pid;
+    uint64_t startTime;
+    std::wstring path; // what QueryFullProcessImageNameW would return
+};
+
+std::wstring PathFor(uint32_t n) {
+    return L"C:\\Program Files\\Vendor " + std::to_wstring(n % 97) + L"\\bin\\App" + std::to_wstring(n) + L".EXE";
+}
+
+std::wstring_view FileName(std::wstring_view path) {
+    const size_t slash = path.rfind(L'\\');
+    return slash == std::wstring_view::npos ? path : path.substr(slash + 1);
+}
+
+bool EqualsNoCase(std::wstring_view a, std::wstring_view b) {
+    if (a.size() != b.size())
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (std::towlower(a[i]) != std::towlower(b[i]))
+            return false;
+    return true;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = bench::Rounds(argc, argv, 20);
+    std::mt19937 rng(17);
+
+    // 48 long-lived processes get 90% of the lookups, 4000 others the rest
+    std::vector<Process> procs;
+    for (uint32_t i = 0; i < 4048; ++i)
+        procs.push_back({4 * (i + 1), 1000 + i, PathFor(i)});
+    const size_t lookups = 200000;
+    std::vector<uint32_t> order(lookups);
+    std::uniform_int_distribution<uint32_t> hot(0, 47), tail(48, 4047), pct(0, 99);
+    for (uint32_t& o : order)
+        o = pct(rng) < 90 ? hot(rng) : tail(rng);
+
+    // 1 in 1000 lookups first sees its pid reused by a new process
+    std::vector<Process> world = procs;
+    const auto reuse = [&](size_t i, Process& p) {
+        if (i % 1000 == 999) {
+            p.startTime += 1'000'000;
+            p.path = PathFor(static_cast<uint32_t>(p.startTime));
+        }
+    };
+
+    std::printf("%-24s %10s\n", "", "ns/lookup");
+
+    // uncached: every lookup copies the path and compares file names (the old IsProcess)
+    {
+        world = procs;
+        uint64_t matches = 0;
+        const auto t0 = bench::Clock::now();
+        for (int r = 0; r < rounds; ++r)
+            for (size_t i = 0; i < lookups; ++i) {
+                Process& p = world[order[i]];
+                reuse(i, p);
+                const std::wstring path = p.path;
+                const std::wstring name(FileName(path));
+                matches += EqualsNoCase(name, L"app7.exe") || EqualsNoCase(name, L"app9.exe");
+            }
+        const auto t1 = bench::Clock::now();
+        bench::Keep(matches);
+        std::printf("%-24s %10.1f\n", "uncached + wcsicmp", bench::NsPer(t0, t1, lookups * rounds));
+    }
+
+    // cached: (pid, start time) -> interned id, the check is an integer compare
+    {
+        world = procs;
+        NameCache<> cache;
+        NameTable table;
+        const NameId app7 = table.Intern(L"app7.exe"), app9 = table.Intern(L"app9.exe");
+        uint64_t matches = 0;
+        const auto t0 = bench::Clock::now();
+        for (int r = 0; r < rounds; ++r)
+            for (size_t i = 0; i < lookups; ++i) {
+                Process& p = world[order[i]];
+                reuse(i, p);
+                NameId id = cache.Lookup(p.pid, p.startTime);
+                if (id == kNoName) {
+                    id = table.Intern(FileName(p.path));
+                    cache.Insert(p.pid, p.startTime, id);
+                }
+                matches += id == app7 || id == app9;
+            }
+        const auto t1 = bench::Clock::now();
+        bench::Keep(matches);
+        const CacheStats& s = cache.Stats();
+        std::printf("%-24s %10.1f   hits %.1f%%  stale %llu  evictions %llu\n", "cache + interned id", bench::NsPer(t0, t1, lookups * rounds),
+          100.0 * s.hits / (s.hits + s.misses), static_cast<unsigned long long>(s.stale), static_cast<unsigned long long>(s.evictions));
+    }
+
+    // the pieces on their own
+    {
+        NameCache<> cache;
+        for (uint32_t i = 0; i < 48; ++i)
+            cache.Insert(procs[i].pid, procs[i].startTime, i + 1);
+        uint64_t sum = 0;
+        const size_t n = lookups * static_cast<size_t>(rounds);
+        auto t0 = bench::Clock::now();
+        for (size_t i = 0; i < n; ++i) {
+            const Process& p = procs[order[i % lookups] % 48];
+            sum += cache.Lookup(p.pid, p.startTime);
+        }
+        auto t1 = bench::Clock::now();
+        std::printf("%-24s %10.1f\n", "hit only", bench::NsPer(t0, t1, n));
+
+        NameTable table;
+        for (const Process& p : procs)
+            table.Intern(FileName(p.path));
+        t0 = bench::Clock::now();
+        for (size_t i = 0; i < n; ++i)
+            sum += table.Find(FileName(procs[order[i % lookups]].path));
+        t1 = bench::Clock::now();
+        bench::Keep(sum);
+        std::printf("%-24s %10.1f\n", "NameTable::Find", bench::NsPer(t0, t1, n));
+    }
+    return 0;
+}
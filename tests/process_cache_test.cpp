@@ -0,0 +1,138 @@
+// tests/process_cache_test.cpp
+// Process name cache and name table: hits, a reused pid with another creation time missing as
+// stale instead of returning the old name, LRU eviction within a 4-way set, and ASCII case
+// folding and interning of image names.
+#include <string>
+#include <string_view>
+
+#include "check.hpp"
+#include "utils/process_cache.hpp"
+
+using namespace utils::proc;
+
+TEST(hit_and_miss) {
+    NameCache<> cache;
+    CHECK_EQ(cache.Lookup(1234, 99), kNoName);
+    cache.Insert(1234, 99, 7);
+    CHECK_EQ(cache.Lookup(1234, 99), 7u);
+    CHECK_EQ(cache.Lookup(1234, 99), 7u);
+    CHECK_EQ(cache.Lookup(1236, 99), kNoName); // another pid
+
+    const CacheStats& s = cache.Stats();
+    CHECK_EQ(s.hits, 2u);
+    CHECK_EQ(s.misses, 2u);
+    CHECK_EQ(s.stale, 0u);
+    CHECK_EQ(s.evictions, 0u);
+}
+
+TEST(reused_pid_is_a_stale_miss) {
+    NameCache<> cache;
+    cache.Insert(4000, 111, 3); // e.g. notepad.exe
+    CHECK_EQ(cache.Lookup(4000, 222), kNoName); // same pid, a newer process
+    CHECK_EQ(cache.Stats().stale, 1u);
+    CHECK_EQ(cache.Stats().misses, 1u);
+
+    // the stale entry is gone, not just skipped
+    CHECK_EQ(cache.Lookup(4000, 111), kNoName);
+    CHECK_EQ(cache.Stats().stale, 1u);
+
+    // the new process takes the freed slot without counting as an eviction
+    cache.Insert(4000, 222, 9);
+    CHECK_EQ(cache.Lookup(4000, 222), 9u);
+    CHECK_EQ(cache.Stats().evictions, 0u);
+}
+
+TEST(reinsert_updates_in_place) {
+    NameCache<1, 4> cache;
+    cache.Insert(4, 1, 10);
+    cache.Insert(4, 1, 11);
+    CHECK_EQ(cache.Lookup(4, 1), 11u);
+    CHECK_EQ(cache.Stats().evictions, 0u);
+    // and takes one way only: three more fit without evicting
+    cache.Insert(8, 1, 12);
+    cache.Insert(12, 1, 13);
+    cache.Insert(16, 1, 14);
+    CHECK_EQ(cache.Stats().evictions, 0u);
+}
+
+TEST(least_recently_used_way_is_evicted) {
+    NameCache<1, 4> cache; // one set: every pid competes for the same 4 ways
+    CHECK_EQ(cache.Capacity(), 4u);
+    cache.Insert(4, 1, 1);
+    cache.Insert(8, 1, 2);
+    cache.Insert(12, 1, 3);
+    cache.Insert(16, 1, 4);
+    CHECK_EQ(cache.Lookup(4, 1), 1u); // 4 is now the most recent, 8 the oldest
+
+    cache.Insert(20, 1, 5);
+    CHECK_EQ(cache.Stats().evictions, 1u);
+    CHECK_EQ(cache.Lookup(8, 1), kNoName);
+    CHECK_EQ(cache.Lookup(4, 1), 1u);
+    CHECK_EQ(cache.Lookup(12, 1), 3u);
+    CHECK_EQ(cache.Lookup(16, 1), 4u);
+    CHECK_EQ(cache.Lookup(20, 1), 5u);
+
+    // lookups refreshed 4, 12, 16, 20 in that order: 4 goes next
+    cache.Insert(24, 1, 6);
+    CHECK_EQ(cache.Stats().evictions, 2u);
+    CHECK_EQ(cache.Lookup(4, 1), kNoName);
+    CHECK_EQ(cache.Lookup(24, 1), 6u);
+}
+
+TEST(full_cache_keeps_a_hot_set) {
+    NameCache<> cache;
+    // 64 hot processes looked up between every one of 4096 one-off ones
+    uint64_t hotHits = 0;
+    for (uint32_t p = 1; p <= 64; ++p)
+        cache.Insert(p * 4, p, p);
+    for (uint32_t i = 0; i < 4096; ++i) {
+        const uint32_t pid = 100000 + i * 4;
+        if (cache.Lookup(pid, 1) == kNoName)
+            cache.Insert(pid, 1, 1000 + i);
+        for (uint32_t p = 1; p <= 64; ++p)
+            hotHits += cache.Lookup(p * 4, p) == p;
+    }
+    CHECK_EQ(hotHits, 64u * 4096u);
+    CHECK(cache.Stats().evictions > 4096u - cache.Capacity());
+}
+
+TEST(names_fold_case_and_intern) {
+    NameTable t;
+    const NameId cs2 = t.Intern(L"CS2.exe");
+    CHECK(cs2 != kNoName);
+    CHECK_EQ(t.Intern(L"cs2.EXE"), cs2);
+    CHECK_EQ(t.Find(L"Cs2.Exe"), cs2);
+    CHECK(t.Name(cs2) == L"cs2.exe"); // stored folded
+
+    const NameId obs = t.Intern(L"obs64.exe");
+    CHECK(obs != cs2);
+    CHECK_EQ(t.Find(L"OBS64.EXE"), obs);
+    CHECK_EQ(t.Find(L"obs32.exe"), kNoName); // Find never interns
+    CHECK_EQ(t.Find(L"obs32.exe"), kNoName);
+
+    CHECK(t.Name(kNoName).empty());
+    CHECK(t.Name(obs + 1).empty());
+
+    // ASCII only: non-ASCII letters keep their case
+    CHECK(t.Intern(L"\u00C9diteur.exe") != t.Intern(L"\u00E9diteur.exe"));
+}
+
+TEST(interned_names_stay_valid) {
+    NameTable t;
+    const NameId first = t.Intern(L"Explorer.EXE");
+    const std::wstring_view view = t.Name(first);
+    for (int i = 0; i < 10000; ++i)
+        t.Intern(L"app" + std::to_wstring(i) + L".exe");
+    CHECK(view == L"explorer.exe");
+    CHECK(t.Name(first).data() == view.data());
+    CHECK_EQ(t.Find(L"APP9999.exe"), first + 10000);
+}
+
+TEST(long_names_compare_on_the_first_max_length_chars) {
+    NameTable t;
+    const std::wstring base(NameTable::kMaxLength, L'a');
+    const NameId id = t.Intern(base + L"1.exe");
+    CHECK_EQ(t.Intern(base + L"2.exe"), id);
+    CHECK_EQ(t.Name(id).size(), NameTable::kMaxLength);
+    CHECK(t.Intern(base.substr(1)) != id);
+}
@@ -0,0 +1,141 @@
+// tests/surface_pool_test.cpp
+// SurfacePool churn with a recording fake surface: focus changes reuse surfaces, only changed
+// placements are placed, restack frames reach every unchanged surface, parking is bounded.
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/surface_pool.hpp"
+
+using utils::pool::Placement;
+
+namespace {
+struct Log {
+    int alive = 0;
+    int places = 0;
+    int restacks = 0;
+    int parks = 0;
+};
+
+struct FakeSurface {
+    explicit FakeSurface(Log& l) : log(l) { ++log.alive; }
+    ~FakeSurface() { --log.alive; }
+    void Place(const Placement& p) {
+        ++log.places;
+        key = p.key;
+        visible = true;
+    }
+    void Restack(const Placement& p) {
+        ++log.restacks;
+        CHECK_EQ(p.key, key);
+    }
+    void Park() {
+        ++log.parks;
+        visible = false;
+    }
+    Log& log;
+    uint64_t key = 0;
+    bool visible = false;
+};
+
+using Pool = utils::pool::SurfacePool<FakeSurface>;
+
+Pool MakePool(Log& log, size_t maxParked = 8) {
+    return Pool([&log] { return std::make_unique<FakeSurface>(log); }, maxParked);
+}
+
+Placement At(uint64_t key, int32_t x, bool active = false) {
+    return {key, {x, 0, x + 100, 100}, active};
+}
+} // namespace
+
+TEST(unchanged_frame_touches_nothing) {
+    Log log;
+    Pool pool = MakePool(log);
+    const std::vector<Placement> set{At(1, 0, true), At(2, 200), At(3, 400)};
+    pool.Apply(set);
+    CHECK_EQ(log.places, 3);
+    pool.Apply(set);
+    pool.Apply(set);
+    CHECK_EQ(log.places, 3);
+    CHECK_EQ(log.restacks, 0);
+    CHECK_EQ(pool.Stats().created, 3u);
+}
+
+TEST(focus_change_replaces_two_surfaces) {
+    Log log;
+    Pool pool = MakePool(log);
+    pool.Apply(std::vector<Placement>{At(1, 0, true), At(2, 200)});
+    pool.Apply(std::vector<Placement>{At(1, 0), At(2, 200, true)});
+    CHECK_EQ(log.places, 4);
+    CHECK_EQ(pool.Stats().created, 2u);
+}
+
+TEST(active_only_focus_change_reuses_surface) {
+    Log log;
+    Pool pool = MakePool(log);
+    pool.Apply(std::vector<Placement>{At(1, 0, true)});
+    for (uint64_t k = 2; k < 50; ++k)
+        pool.Apply(std::vector<Placement>{At(k, 0, true)});
+    CHECK_EQ(pool.Stats().created, 1u);
+    CHECK_EQ(pool.Stats().reused, 48u);
+    CHECK_EQ(log.alive, 1);
+}
+
+TEST(restack_reaches_unchanged_surfaces_only) {
+    Log log;
+    Pool pool = MakePool(log);
+    const std::vector<Placement> set{At(1, 0, true), At(2, 200), At(3, 400)};
+    pool.Apply(set);
+    // window 3 moved in the same frame as the reorder: placed, not restacked on top of that
+    pool.Apply(std::vector<Placement>{At(1, 0, true), At(2, 200), At(3, 500)}, true);
+    CHECK_EQ(log.restacks, 2);
+    CHECK_EQ(log.places, 4);
+    CHECK_EQ(pool.Stats().restacked, 2u);
+    // the flag is per frame
+    pool.Apply(std::vector<Placement>{At(1, 0, true), At(2, 200), At(3, 500)});
+    CHECK_EQ(log.restacks, 2);
+}
+
+TEST(parking_is_bounded) {
+    Log log;
+    Pool pool = MakePool(log, 4);
+    std::vector<Placement> many;
+    for (uint64_t k = 1; k <= 20; ++k)
+        many.push_back(At(k, static_cast<int32_t>(k) * 10));
+    pool.Apply(many);
+    pool.Clear();
+    CHECK_EQ(pool.Bound(), 0u);
+    CHECK_EQ(pool.Parked(), 4u);
+    CHECK_EQ(log.alive, 4);
+    CHECK_EQ(pool.Stats().destroyed, 16u);
+}
+
+TEST(random_churn_keeps_one_surface_per_target) {
+    Log log;
+    Pool pool = MakePool(log, 8);
+    std::mt19937 rng(20);
+    std::vector<bool> present(64);
+    std::vector<int32_t> x(64);
+    for (int frame = 0; frame < 5000 * check::Scale(); ++frame) {
+        std::vector<Placement> set;
+        const uint64_t active = rng() % 64;
+        for (uint64_t k = 0; k < 64; ++k) {
+            if (rng() % 16 == 0)
+                present[k] = !present[k];
+            if (rng() % 8 == 0)
+                x[k] += static_cast<int32_t>(rng() % 21) - 10;
+            if (present[k])
+                set.push_back(At(k + 1, x[k], k == active));
+        }
+        pool.Apply(set, rng() % 4 == 0);
+        CHECK_EQ(pool.Bound(), set.size());
+        CHECK(pool.Parked() <= 8);
+        CHECK_EQ(static_cast<size_t>(log.alive), pool.Bound() + pool.Parked());
+    }
+    const utils::pool::ChurnStats& st = pool.Stats();
+    CHECK_EQ(st.created, st.destroyed + pool.Bound() + pool.Parked());
+    CHECK(st.reused > st.created); // parked surfaces are handed out before new ones are made
+}
@@ -0,0 +1,72 @@
+// tests/trace_replay.cpp
+// Standalone replay driver: feeds an input.trace recorded by the app (tray > Input Trace) through an
+// isolated replay::Session off-target, hit-testing clicks against a synthetic grid of windows.
+//   trace_replay <file.trace> [--realtime] [--windows N]
+// Key state only: binds come from the app config, which needs Windows to load.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "inputReplay.hpp"
+#include "utils/window_registry.hpp"
+
+namespace {
+// n windows tiled over a 3840x2160 desktop, top-left first in the z-order
+std::vector<utils::wnd::WindowInfo> TiledWindows(int n) {
+    std::vector<utils::wnd::WindowInfo> z;
+    int cols = 1;
+    while (cols * cols < n)
+        ++cols;
+    const int rows = (n + cols - 1) / cols;
+    const int w = 3840 / cols, h = 2160 / rows;
+    for (int i = 0; i < n; ++i) {
+        const utils::geom::Rect r{(i % cols) * w, (i / cols) * h, (i % cols + 1) * w, (i / cols + 1) * h};
+        z.push_back({.key = static_cast<uint64_t>(i + 1), .window = r, .visual = r, .flags = utils::wnd::Usable | utils::wnd::Filtered});
+    }
+    return z;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* path = nullptr;
+    bool realTime = false;
+    int windows = 16;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--realtime") == 0)
+            realTime = true;
+        else if (std::strcmp(argv[i], "--windows") == 0 && i + 1 < argc)
+            windows = std::max(1, std::atoi(argv[++i]));
+        else
+            path = argv[i];
+    }
+    if (!path) {
+        std::fprintf(stderr, "usage: %s <file.trace> [--realtime] [--windows N]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<input::Event> events;
+    std::string error;
+    if (!input::trace::Load(path, events, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    const std::vector<utils::wnd::WindowInfo> z = TiledWindows(windows);
+    input::replay::Session session({}, [&z](int32_t x, int32_t y) {
+        const utils::wnd::WindowInfo* w = utils::wnd::HitFiltered(z, {x, y});
+        return w ? w->key : 0;
+    });
+    const input::replay::Stats st = session.Run(events, realTime);
+
+    std::printf("events   %llu in %.2f ms (%.0f events/s), %llu handled\n", static_cast<unsigned long long>(st.feed.events), st.feed.elapsedNs / 1e6,
+      st.feed.EventsPerSec(), static_cast<unsigned long long>(st.handled));
+    std::printf("clicks   %llu, %llu on a window\n", static_cast<unsigned long long>(st.clicks), static_cast<unsigned long long>(st.targets));
+    std::printf("click    p50 %llu ns  p99 %llu ns  max %llu ns\n", static_cast<unsigned long long>(st.clickLatency.p50),
+      static_cast<unsigned long long>(st.clickLatency.p99), static_cast<unsigned long long>(st.clickLatency.max));
+    if (st.superHeldAtEnd)
+        std::printf("note     trace ends with SUPER held\n");
+    return 0;
+}
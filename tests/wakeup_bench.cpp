@@ -0,0 +1,148 @@
+// tests/wakeup_bench.cpp
+// Wakeup against the mutex + condition_variable scheme it replaced (in its lost-wakeup-free form,
+// sequence under the mutex):
+//  - ping-pong: round trip between two threads signalling each other, back to back
+//  - paced: one event every 250 us as a 4 kHz mouse would send them; wake latency from the
+//    producer's timestamp to the consumer seeing it, and process CPU time per event
+//   wakeup_bench [rounds]
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <mutex>
+#include <thread>
+
+#include "bench.hpp"
+#include "inputEvent.hpp"
+#include "utils/latency.hpp"
+#include "wakeup.hpp"
+
+namespace {
+// InputLoop before Wakeup: the sequence lives under the mutex so this baseline never loses a wake
+class CvSignal {
+  public:
+    uint32_t Epoch() {
+        std::lock_guard lock(m_);
+        return seq_;
+    }
+    void Notify() {
+        {
+            std::lock_guard lock(m_);
+            ++seq_;
+        }
+        cv_.notify_one();
+    }
+    void Wait(uint32_t seen) {
+        std::unique_lock lock(m_);
+        cv_.wait(lock, [&] { return seq_ != seen; });
+    }
+
+  private:
+    std::mutex m_;
+    std::condition_variable cv_;
+    uint32_t seq_ = 0;
+};
+
+template <typename Signal>
+double PingPongNs(Signal& toConsumer, Signal& toProducer, uint32_t rounds) {
+    std::atomic<uint32_t> sent{0}, acked{0};
+    const auto t0 = bench::Clock::now();
+    std::thread consumer([&] {
+        for (uint32_t got = 0; got < rounds;) {
+            const uint32_t seen = toConsumer.Epoch();
+            const uint32_t now = sent.load(std::memory_order_acquire);
+            if (now == got) {
+                toConsumer.Wait(seen);
+                continue;
+            }
+            got = now;
+            acked.store(got, std::memory_order_release);
+            toProducer.Notify();
+        }
+    });
+    for (uint32_t i = 1; i <= rounds; ++i) {
+        sent.store(i, std::memory_order_release);
+        toConsumer.Notify();
+        for (;;) {
+            const uint32_t seen = toProducer.Epoch();
+            if (acked.load(std::memory_order_acquire) >= i)
+                break;
+            toProducer.Wait(seen);
+        }
+    }
+    consumer.join();
+    return bench::NsPer(t0, bench::Clock::now(), rounds);
+}
+
+struct Paced {
+    utils::latency::Histogram::Snapshot wake;
+    double cpuUsPerEvent = 0;
+};
+
+template <typename Signal>
+Paced PacedRun(Signal& signal, uint32_t events) {
+    std::atomic<uint64_t> stamp{0};
+    std::atomic<bool> done{false};
+    utils::latency::Histogram wake;
+    // process CPU time (POSIX clock(); on MSVC this is wall time and the column means nothing)
+    const std::clock_t c0 = std::clock();
+    std::thread consumer([&] {
+        uint64_t last = 0;
+        for (;;) {
+            const uint32_t seen = signal.Epoch();
+            const uint64_t s = stamp.load(std::memory_order_acquire);
+            if (s != last) {
+                wake.Record(input::NowNs() - s);
+                last = s;
+                continue;
+            }
+            if (done.load(std::memory_order_acquire))
+                return;
+            signal.Wait(seen);
+        }
+    });
+    for (uint32_t i = 0; i < events; ++i) {
+        std::this_thread::sleep_for(std::chrono::microseconds(250));
+        stamp.store(input::NowNs(), std::memory_order_release);
+        signal.Notify();
+    }
+    done.store(true, std::memory_order_release);
+    signal.Notify();
+    consumer.join();
+    const std::clock_t c1 = std::clock();
+    return {wake.Snap(), 1e6 * static_cast<double>(c1 - c0) / CLOCKS_PER_SEC / events};
+}
+
+template <typename Signal>
+void Row(const char* name, Signal& a, Signal& b, Signal& paced, uint32_t rounds, uint32_t events) {
+    const double rtt = PingPongNs(a, b, rounds);
+    const Paced p = PacedRun(paced, events);
+    std::printf("%-16s %10.0f ns %9.1f us %9.1f us %9.1f us\n", name, rtt, p.wake.p50 / 1000.0, p.wake.p99 / 1000.0, p.cpuUsPerEvent);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = bench::Rounds(argc, argv, 10);
+    const uint32_t pingPongs = 10000u * rounds;
+    const uint32_t events = 400u * rounds;
+
+    std::printf("%-16s %13s %12s %12s %12s\n", "signal", "round trip", "wake p50", "wake p99", "cpu/event");
+    {
+        Wakeup a, b, paced;
+        Row("Wakeup (spin)", a, b, paced, pingPongs, events);
+        const Wakeup::Stats st = paced.GetStats();
+        std::printf("  paced: notifies=%llu kernelWakes=%llu spinHits=%llu parks=%llu\n", static_cast<unsigned long long>(st.notifies),
+          static_cast<unsigned long long>(st.kernelWakes), static_cast<unsigned long long>(st.spinHits), static_cast<unsigned long long>(st.parks));
+    }
+    {
+        Wakeup a(0), b(0), paced(0);
+        Row("Wakeup (park)", a, b, paced, pingPongs, events);
+    }
+    {
+        CvSignal a, b, paced;
+        Row("condition_var", a, b, paced, pingPongs, events);
+    }
+    return 0;
+}
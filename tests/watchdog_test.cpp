@@ -0,0 +1,77 @@
+// tests/watchdog_test.cpp
+// Watchdog verdicts from simulated hook/probe histories: programmatic cursor moves (no callbacks,
+// occasional evidence) must not look like a dead hook, a streak of evidence without callbacks must.
+#include <cstdint>
+
+#include "check.hpp"
+#include "utils/watchdog.hpp"
+
+using namespace utils::watchdog;
+
+namespace {
+constexpr uint64_t kPeriod = 250'000'000;
+
+struct Sim {
+    Watchdog dog;
+    HookStats::Snapshot snap{};
+    uint64_t now = 1'000'000'000;
+
+    Verdict Tick(bool callbacks, bool evidence) {
+        now += kPeriod;
+        if (callbacks)
+            snap.callbacks += 10;
+        return dog.Check(snap, evidence, now);
+    }
+};
+} // namespace
+
+TEST(live_hook_is_never_silent) {
+    Sim sim;
+    for (int i = 0; i < 100; ++i)
+        CHECK(sim.Tick(true, true) == Verdict::Ok);
+}
+
+TEST(dead_hook_is_reported_after_a_streak) {
+    Sim sim;
+    sim.Tick(true, false);
+    CHECK(sim.Tick(false, true) == Verdict::Ok);
+    CHECK(sim.Tick(false, true) == Verdict::Ok);
+    CHECK(sim.Tick(false, true) == Verdict::Silent); // third miss, 500 ms after the first
+    // one incident per streak: the reinstall gets a full streak before the next report
+    CHECK(sim.Tick(false, true) == Verdict::Ok);
+}
+
+TEST(sporadic_programmatic_moves_are_ignored) {
+    // an app recentring the cursor every other check (games, remote desktop) while the user is idle
+    Sim sim;
+    for (int i = 0; i < 200; ++i)
+        CHECK(sim.Tick(false, i % 2 == 0) == Verdict::Ok);
+}
+
+TEST(callback_resets_streak) {
+    Sim sim;
+    for (int round = 0; round < 50; ++round) {
+        CHECK(sim.Tick(false, true) == Verdict::Ok);
+        CHECK(sim.Tick(false, true) == Verdict::Ok);
+        CHECK(sim.Tick(true, true) == Verdict::Ok);
+    }
+}
+
+TEST(over_budget_is_reported_once) {
+    Sim sim;
+    sim.snap.overBudget = 1;
+    CHECK(sim.Tick(true, false) == Verdict::OverBudget);
+    CHECK(sim.Tick(true, false) == Verdict::Ok);
+}
+
+TEST(hook_stats_record_and_take_worst) {
+    HookStats stats;
+    stats.Record(100, 200, 1000);
+    stats.Record(100, 5000, 1000);
+    const HookStats::Snapshot s = stats.Snap();
+    CHECK_EQ(s.callbacks, 2u);
+    CHECK_EQ(s.overBudget, 1u);
+    CHECK_EQ(s.lastNs, 5000u);
+    CHECK_EQ(stats.TakeWorst(), 4900u);
+    CHECK_EQ(stats.TakeWorst(), 0u);
+}
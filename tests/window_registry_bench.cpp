@@ -0,0 +1,100 @@
+// tests/window_registry_bench.cpp
+// Registry costs for a few window counts: point hit-test through the grid vs the linear z-order
+// walk, the Overlapping()/Neighbour() walks, and the writer side (move, publish). Prints ns per
+// operation; nothing is asserted, numbers depend on the machine.
+//   window_registry_bench [rounds]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "utils/window_registry.hpp"
+
+using namespace utils;
+using namespace utils::wnd;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double NsPer(Clock::time_point a, Clock::time_point b, size_t ops) {
+    return std::chrono::duration<double, std::nano>(b - a).count() / static_cast<double>(ops);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50;
+    std::mt19937 rng(7);
+    const auto rand = [&](int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(rng); };
+
+    std::printf("%7s %12s %12s %12s %12s %10s %10s\n", "windows", "hit linear", "hit grid", "overlap", "neighbour", "move", "publish");
+    for (int n : {20, 50, 200, 1000, 5000}) {
+        // three 1920x1080 monitors side by side, windows of typical sizes with DWM shadow insets
+        Registry reg;
+        reg.SetWorld({-1920, 0, 3840, 1080});
+        for (int i = 0; i < n; ++i) {
+            WindowInfo w{static_cast<uint64_t>(i + 1)};
+            const int x = rand(-1920, 3200), y = rand(0, 900), width = rand(200, 1600), height = rand(150, 1000);
+            w.window = {x, y, x + width, y + height};
+            w.visual = {x + 7, y, x + width - 7, y + height - 7};
+            w.flags = Usable | (rand(0, 9) ? Filtered : 0);
+            reg.Upsert(w);
+        }
+        Snapshot s;
+        reg.CopyTo(s);
+        const std::span<const WindowInfo> z(s.z);
+
+        std::vector<geom::Point> points(4096);
+        for (geom::Point& p : points)
+            p = {rand(-1920, 3840), rand(0, 1080)};
+
+        size_t sink = 0;
+        const auto t0 = Clock::now();
+        for (int r = 0; r < rounds; ++r)
+            for (geom::Point p : points)
+                sink += HitFiltered(z, p) != nullptr;
+        const auto t1 = Clock::now();
+        for (int r = 0; r < rounds; ++r)
+            for (geom::Point p : points)
+                sink += HitFiltered(s, p) != nullptr;
+        const auto t2 = Clock::now();
+
+        // 400x300 queries, roughly a snapped window or a drag outline
+        std::vector<const WindowInfo*> out;
+        const size_t overlaps = 200 * static_cast<size_t>(rounds);
+        for (size_t i = 0; i < overlaps; ++i) {
+            const geom::Point p = points[i % points.size()];
+            Overlapping(s, {p.x, p.y, p.x + 400, p.y + 300}, Usable, 0, out);
+            sink += out.size();
+        }
+        const auto t3 = Clock::now();
+        const size_t neighbours = 200 * static_cast<size_t>(rounds);
+        for (size_t i = 0; i < neighbours; ++i)
+            sink += Neighbour(s, s.z[i % n], static_cast<spatial::Dir>(i & 3), Usable) != nullptr;
+        const auto t4 = Clock::now();
+
+        const size_t moves = 400 * static_cast<size_t>(rounds);
+        for (size_t i = 0; i < moves; ++i) {
+            WindowInfo w = s.z[i % n];
+            const int dx = (i / n) % 2 ? -3 : 3;
+            w.window.left += dx;
+            w.window.right += dx;
+            w.visual.left += dx;
+            w.visual.right += dx;
+            reg.Upsert(w);
+        }
+        const auto t5 = Clock::now();
+        const size_t publishes = 4 * static_cast<size_t>(rounds);
+        for (size_t i = 0; i < publishes; ++i)
+            reg.CopyTo(s);
+        const auto t6 = Clock::now();
+
+        const size_t hits = points.size() * rounds;
+        std::printf("%7d %9.0f ns %9.0f ns %9.0f ns %9.0f ns %7.0f ns %7.1f us\n", n, NsPer(t0, t1, hits), NsPer(t1, t2, hits), NsPer(t2, t3, overlaps),
+          NsPer(t3, t4, neighbours), NsPer(t4, t5, moves), NsPer(t5, t6, publishes) / 1000.0);
+        if (sink == 42)
+            std::printf(" ");
+    }
+    return 0;
+}
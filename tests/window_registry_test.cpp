@@ -0,0 +1,175 @@
+// tests/window_registry_test.cpp
+// Grid-backed hit-tests against the linear z-order walk over random upserts, removals, restacks
+// and world changes (same window for every point), plus the overlap and neighbour walks.
+// Timings live in window_registry_bench.cpp.
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+#include "utils/window_registry.hpp"
+
+using namespace utils;
+using namespace utils::wnd;
+
+namespace {
+struct Random {
+    std::mt19937 rng{7};
+    int operator()(int lo, int hi) {
+        return std::uniform_int_distribution<int>(lo, hi)(rng);
+    }
+};
+
+// Anything goes: empty and inverted visual insets, off-world rects, every flag combination
+WindowInfo RandomWindow(Random& r, uint64_t key) {
+    WindowInfo w{key};
+    const int x = r(-2000, 5600), y = r(-300, 2000), width = r(0, 2400), height = r(0, 1400);
+    w.window = {x, y, x + width, y + height};
+    const int border = r(0, 8);
+    w.visual = {x + border, y, std::max(x + border, x + width - border), std::max(y, y + height - border)};
+    w.flags = static_cast<uint8_t>(r(0, 63));
+    return w;
+}
+
+void RandomStep(Random& r, Registry& reg, std::vector<uint64_t>& keys, uint64_t& nextKey) {
+    const int op = r(0, 9);
+    if (op < 5 && !keys.empty()) {
+        reg.Upsert(RandomWindow(r, keys[r(0, static_cast<int>(keys.size()) - 1)])); // move/resize
+    } else if (op < 7 && !keys.empty()) {
+        const int i = r(0, static_cast<int>(keys.size()) - 1);
+        reg.Remove(keys[i]);
+        keys.erase(keys.begin() + i);
+    } else if (op < 8) {
+        reg.Upsert(RandomWindow(r, nextKey));
+        keys.push_back(nextKey++);
+    } else if (op < 9) {
+        // new z-order, a few windows dropped by omission
+        std::vector<uint64_t> order = keys;
+        std::shuffle(order.begin(), order.end(), r.rng);
+        for (int drop = r(0, 3); drop > 0 && !order.empty(); --drop) {
+            keys.erase(std::find(keys.begin(), keys.end(), order.back()));
+            order.pop_back();
+        }
+        reg.Restack(order);
+    } else {
+        reg.SetWorld({r(-3000, 0), r(-500, 0), r(100, 8000), r(100, 3000)});
+    }
+}
+} // namespace
+
+TEST(grid_hit_tests_match_linear_walk) {
+    Random r;
+    const int rounds = 10 * check::Scale();
+    bool hitFiltered = true, hitAny = true;
+    for (int round = 0; round < rounds; ++round) {
+        Registry reg;
+        if (round % 2)
+            reg.SetWorld({-1920, 0, 3840 + 1920, 2160});
+        uint64_t nextKey = 1;
+        std::vector<uint64_t> keys;
+        for (int i = 0; i < 200; ++i) {
+            reg.Upsert(RandomWindow(r, nextKey));
+            keys.push_back(nextKey++);
+        }
+
+        Snapshot s;
+        for (int step = 0; step < 200; ++step) {
+            RandomStep(r, reg, keys, nextKey);
+            reg.CopyTo(s);
+            CHECK_EQ(s.z.size(), keys.size());
+            const std::span<const WindowInfo> z(s.z);
+            for (int q = 0; q < 20; ++q) {
+                const geom::Point p{r(-2500, 8500), r(-600, 3500)};
+                hitFiltered &= HitFiltered(s, p) == HitFiltered(z, p);
+                hitAny &= HitAny(s, p) == HitAny(z, p);
+            }
+
+        }
+    }
+    CHECK(hitFiltered);
+    CHECK(hitAny);
+}
+
+TEST(hit_test_respects_z_order_and_flags) {
+    Registry reg;
+    reg.SetWorld({0, 0, 1920, 1080});
+    WindowInfo below{1, {0, 0, 800, 600}, {0, 0, 800, 600}};
+    below.flags = Usable | Filtered;
+    WindowInfo above{2, {100, 100, 500, 400}, {107, 100, 493, 393}};
+    above.flags = Usable | Filtered;
+    reg.Upsert(below);
+    reg.Upsert(above); // new windows go on top
+
+    Snapshot s;
+    reg.CopyTo(s);
+    CHECK(HitFiltered(s, {200, 200})->key == 2u);
+    CHECK(HitFiltered(s, {50, 50})->key == 1u);
+    // the invisible resize border of the top window falls through to the one below
+    CHECK(HitFiltered(s, {103, 200})->key == 1u);
+    CHECK(HitFiltered(s, {900, 900}) == nullptr);
+
+    const uint64_t order[] = {1, 2};
+    reg.Restack(order);
+    reg.CopyTo(s);
+    CHECK(HitFiltered(s, {200, 200})->key == 1u);
+
+    // a transparent window is not under the cursor at all
+    below.flags |= PointTransparent;
+    reg.Upsert(below);
+    reg.CopyTo(s);
+    CHECK(HitFiltered(s, {200, 200})->key == 2u);
+    CHECK(HitFiltered(s, {50, 50}) == nullptr);
+}
+
+TEST(neighbour_prefers_aligned_windows) {
+    Registry reg;
+    reg.SetWorld({0, 0, 3000, 1000});
+    const auto add = [&](uint64_t key, geom::Rect r) {
+        WindowInfo w{key, r, r};
+        w.flags = Usable | Filtered;
+        reg.Upsert(w);
+    };
+    add(1, {1000, 400, 1400, 600}); // from
+    add(2, {1500, 400, 1900, 600}); // right, aligned
+    add(3, {1450, 0, 1850, 100});   // right, closer but far off the axis
+    add(4, {2500, 400, 2900, 600}); // right, behind 2
+    add(5, {100, 700, 500, 900});   // left and below
+    Snapshot s;
+    reg.CopyTo(s);
+    const WindowInfo& from = *Find(s, 1);
+    CHECK(Neighbour(s, from, spatial::Dir::Right, Usable)->key == 2u);
+    CHECK(Neighbour(s, from, spatial::Dir::Left, Usable)->key == 5u);
+    CHECK(Neighbour(s, from, spatial::Dir::Up, Usable)->key == 3u);
+    CHECK(Neighbour(s, *Find(s, 4), spatial::Dir::Right, Usable) == nullptr);
+}
+
+TEST(overlap_lists_matching_windows_top_first) {
+    Registry reg;
+    reg.SetWorld({0, 0, 1920, 1080});
+    const auto add = [&](uint64_t key, geom::Rect r, uint8_t flags) {
+        WindowInfo w{key, r, r};
+        w.flags = flags;
+        reg.Upsert(w);
+    };
+    add(1, {0, 0, 600, 600}, Usable | Filtered);
+    add(2, {500, 500, 900, 900}, Usable);
+    add(3, {550, 0, 700, 100}, Usable | Filtered | Cloaked);
+    add(4, {1000, 0, 1200, 200}, Usable | Filtered);
+    add(5, {580, 580, 580, 700}, Usable | Filtered); // empty
+    Snapshot s;
+    reg.CopyTo(s);
+
+    std::vector<const WindowInfo*> out;
+    Overlapping(s, {580, 50, 620, 620}, Usable, 0, out);
+    CHECK_EQ(out.size(), 3u);
+    if (out.size() == 3) {
+        CHECK_EQ(out[0]->key, 3u); // last upserted is on top
+        CHECK_EQ(out[1]->key, 2u);
+        CHECK_EQ(out[2]->key, 1u);
+    }
+    Overlapping(s, {580, 50, 620, 620}, Usable | Filtered, Cloaked, out);
+    CHECK_EQ(out.size(), 1u);
+    Overlapping(s, {600, 600, 600, 900}, Usable, 0, out); // empty query
+    CHECK(out.empty());
+}
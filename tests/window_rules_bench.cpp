@@ -0,0 +1,91 @@
+// tests/window_rules_bench.cpp
+// RuleSet::Evaluate with a 300-rule [rules] section, the way a memo miss in MatchRules pays for it:
+// 200 exe literals, 40 class literal + title glob pairs, 30 title regexes, 20 exe globs and 10
+// style rules, against windows that hit a literal, hit a wildcard or match nothing. Also the
+// Build cost of the section. Prints ns per call; nothing is asserted.
+//   window_rules_bench [rounds]
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "settings/window_rules.hpp"
+
+using namespace rules;
+
+namespace {
+std::vector<RuleLine> ThreeHundredRules() {
+    std::vector<RuleLine> lines;
+    const char* actions[] = {"Ignore", "Float", "Minimize", "Size, 1280, 800"};
+    for (int i = 0; i < 200; ++i)
+        lines.push_back({"exe:app" + std::to_string(i) + ".exe", actions[i % 4]});
+    for (int i = 0; i < 40; ++i)
+        lines.push_back({"class:Class_" + std::to_string(i) + " title:\"*Dialog " + std::to_string(i) + "*\"", "Float"});
+    for (int i = 0; i < 30; ++i)
+        lines.push_back({"title:/^Project " + std::to_string(i) + "( - .*)?$/", "Size, 1600, 900"});
+    for (int i = 0; i < 20; ++i)
+        lines.push_back({"exe:tool" + std::to_string(i) + "_*.exe", "Minimize"});
+    for (int i = 0; i < 10; ++i)
+        lines.push_back({"style:!THICKFRAME exe:game" + std::to_string(i) + ".exe", "Ignore"});
+    return lines;
+}
+
+struct Sample {
+    std::wstring exe, cls, title;
+    uint32_t style;
+};
+
+template <typename Make>
+double PerEvaluate(const RuleSet& r, int rounds, Make&& make) {
+    std::vector<Sample> windows;
+    for (int i = 0; i < 1024; ++i)
+        windows.push_back(make(i));
+    uint64_t sum = 0;
+    const auto t0 = bench::Clock::now();
+    for (int k = 0; k < rounds; ++k)
+        for (const Sample& w : windows)
+            sum += r.Evaluate({w.exe, w.cls, w.title, w.style, 0}).actions;
+    const auto t1 = bench::Clock::now();
+    bench::Keep(sum);
+    return bench::NsPer(t0, t1, windows.size() * static_cast<size_t>(rounds));
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rounds = bench::Rounds(argc, argv, 4);
+    std::mt19937 rng(23);
+    const auto rand = [&](int n) { return std::uniform_int_distribution<int>(0, n - 1)(rng); };
+
+    const std::vector<RuleLine> lines = ThreeHundredRules();
+    RuleSet r;
+    const auto b0 = bench::Clock::now();
+    const auto errors = r.Build(lines);
+    const auto b1 = bench::Clock::now();
+    std::printf("%zu rules (%zu rejected), build %.2f ms\n", r.size(), errors.size(), bench::Seconds(b0, b1) * 1e3);
+
+    const std::wstring shortTitle = L"Untitled - Editor";
+    const std::wstring longTitle = std::wstring(400, L'x') + L" - Document";
+    std::printf("%-26s %10s\n", "", "ns/window");
+    std::printf("%-26s %10.1f\n", "exe literal hit", PerEvaluate(r, rounds, [&](int) {
+        return Sample{L"App" + std::to_wstring(rand(200)) + L".EXE", L"Window", shortTitle, 0x00CF0000u};
+    }));
+    std::printf("%-26s %10.1f\n", "class + title glob hit", PerEvaluate(r, rounds, [&](int) {
+        const std::wstring n = std::to_wstring(rand(40));
+        return Sample{L"host.exe", L"Class_" + n, L"Settings Dialog " + n + L" (2)", 0x00CF0000u};
+    }));
+    std::printf("%-26s %10.1f\n", "title regex hit", PerEvaluate(r, rounds, [&](int) {
+        return Sample{L"ide.exe", L"IdeFrame", L"Project " + std::to_wstring(rand(30)) + L" - main.cpp", 0x00CF0000u};
+    }));
+    std::printf("%-26s %10.1f\n", "exe glob hit", PerEvaluate(r, rounds, [&](int) {
+        return Sample{L"tool" + std::to_wstring(rand(20)) + L"_x64.exe", L"ToolWindow", shortTitle, 0x00CF0000u};
+    }));
+    std::printf("%-26s %10.1f\n", "no match, short title", PerEvaluate(r, rounds, [&](int) {
+        return Sample{L"other" + std::to_wstring(rand(1000)) + L".exe", L"Other", shortTitle, 0x00CF0000u};
+    }));
+    std::printf("%-26s %10.1f\n", "no match, 411-char title", PerEvaluate(r, rounds, [&](int) {
+        return Sample{L"other" + std::to_wstring(rand(1000)) + L".exe", L"Other", longTitle, 0x00CF0000u};
+    }));
+    return 0;
+}
@@ -0,0 +1,173 @@
+// tests/window_rules_test.cpp
+// [rules] matching: literal, glob and regex patterns on each of exe/class/title (case-insensitive),
+// every matcher of a rule required, style and exStyle flags set/cleared, rules merged in file
+// order with the first Size winning, titles longer than the literal fold buffer, and the lines
+// Build rejects.
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+#include "settings/window_rules.hpp"
+
+using namespace rules;
+
+namespace {
+constexpr uint32_t kThickFrame = 0x00040000u;
+constexpr uint32_t kCaption = 0x00C00000u;
+constexpr uint32_t kPopup = 0x80000000u;
+constexpr uint32_t kToolWindowEx = 0x00000080u;
+
+RuleSet Rules(const std::vector<RuleLine>& lines) {
+    RuleSet r;
+    const auto errors = r.Build(lines);
+    CHECK(errors.empty());
+    return r;
+}
+
+uint8_t Actions(const RuleSet& r, std::wstring_view exe, std::wstring_view cls = L"", std::wstring_view title = L"", uint32_t style = 0, uint32_t exStyle = 0) {
+    return r.Evaluate({exe, cls, title, style, exStyle}).actions;
+}
+} // namespace
+
+TEST(literal_per_field_ignores_case) {
+    const RuleSet r = Rules({{"exe:OBS64.exe", "Minimize"}, {"class:Notepad", "Float"}, {"title:\"Task Manager\"", "Ignore"}});
+    CHECK_EQ(Actions(r, L"obs64.EXE"), Minimize);
+    CHECK_EQ(Actions(r, L"obs64.exe.bak"), 0);
+    CHECK_EQ(Actions(r, L"xobs64.exe"), 0);
+    CHECK_EQ(Actions(r, L"notepad.exe", L"NOTEPAD"), Float);
+    CHECK_EQ(Actions(r, L"taskmgr.exe", L"TaskManagerWindow", L"task manager"), Ignore);
+    CHECK_EQ(Actions(r, L"taskmgr.exe", L"TaskManagerWindow", L"Task Manager (2)"), 0);
+    // patterns are per field: an exe literal says nothing about titles
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"obs64.exe"), 0);
+}
+
+TEST(glob_per_field) {
+    const RuleSet r = Rules({{"exe:game??.exe", "Ignore"}, {"class:Chrome_*", "Float"}, {"title:\"*Picture in Picture*\"", "Minimize"}});
+    CHECK_EQ(Actions(r, L"GAME01.exe"), Ignore);
+    CHECK_EQ(Actions(r, L"game1.exe"), 0);
+    CHECK_EQ(Actions(r, L"game123.exe"), 0);
+    CHECK_EQ(Actions(r, L"chrome.exe", L"chrome_widgetwin_1"), Float);
+    CHECK_EQ(Actions(r, L"chrome.exe", L"Chrome"), 0);
+    CHECK_EQ(Actions(r, L"firefox.exe", L"MozillaDialogClass", L"picture in picture"), Minimize);
+    CHECK_EQ(Actions(r, L"firefox.exe", L"MozillaDialogClass", L"Picture-in-Picture"), 0);
+}
+
+TEST(regex_per_field) {
+    const RuleSet r = Rules({{"title:/^Steam( - .*)?$/", "Float"}, {"exe:/^(psst|spotify)\\.exe$/", "Minimize"}, {"class:/^Afx:/", "Ignore"}});
+    CHECK_EQ(Actions(r, L"steam.exe", L"", L"Steam"), Float);
+    CHECK_EQ(Actions(r, L"steam.exe", L"", L"steam - News"), Float); // icase
+    CHECK_EQ(Actions(r, L"steam.exe", L"", L"Steamy"), 0);
+    CHECK_EQ(Actions(r, L"Spotify.exe"), Minimize);
+    CHECK_EQ(Actions(r, L"spotify.exe.old"), 0);
+    CHECK_EQ(Actions(r, L"app.exe", L"Afx:00400000:8"), Ignore);
+    CHECK_EQ(Actions(r, L"app.exe", L"MyAfx:"), 0);
+}
+
+TEST(every_matcher_must_hold) {
+    const RuleSet r = Rules({{"exe:chrome.exe class:Chrome_WidgetWin_1 title:\"*Picture in Picture*\"", "Float"}});
+    CHECK_EQ(Actions(r, L"chrome.exe", L"Chrome_WidgetWin_1", L"Picture in Picture"), Float);
+    CHECK_EQ(Actions(r, L"msedge.exe", L"Chrome_WidgetWin_1", L"Picture in Picture"), 0);
+    CHECK_EQ(Actions(r, L"chrome.exe", L"Chrome_WidgetWin_0", L"Picture in Picture"), 0);
+    CHECK_EQ(Actions(r, L"chrome.exe", L"Chrome_WidgetWin_1", L"New Tab"), 0);
+}
+
+TEST(style_flags) {
+    const RuleSet r = Rules({{"style:!THICKFRAME exe:game*.exe", "Ignore"}, {"style:popup style:!caption", "Float"}, {"style:TOOLWINDOW", "Minimize"}});
+    CHECK_EQ(Actions(r, L"game.exe", L"", L"", kCaption), Ignore);
+    CHECK_EQ(Actions(r, L"game.exe", L"", L"", kCaption | kThickFrame), 0);
+    CHECK_EQ(Actions(r, L"other.exe", L"", L"", kCaption), 0);
+    // set and clear on the same rule
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"", kPopup), Float);
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"", kPopup | kCaption), 0);
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"", kCaption), 0);
+    // ex styles are checked against exStyle, not style
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"", kCaption, kToolWindowEx), Minimize);
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"", kToolWindowEx), 0);
+}
+
+TEST(rules_merge_and_first_size_wins) {
+    const RuleSet r = Rules({
+      {"exe:steam.exe", "Size, 1280, 800"},
+      {"title:Steam*", "Size, 1920, 1080"},
+      {"exe:steam.exe", "Float"},
+      {"exe:*.exe", "Minimize"},
+    });
+    const Result res = r.Evaluate({L"steam.exe", L"", L"Steam", 0, 0});
+    CHECK_EQ(res.actions, FixedSize | Float | Minimize);
+    CHECK_EQ(res.width, 1280);
+    CHECK_EQ(res.height, 800);
+    CHECK(res.Has(Float));
+    CHECK(!res.Has(Ignore));
+
+    // the first rule drops out: the next Size in file order applies
+    const Result other = r.Evaluate({L"steamwebhelper.exe", L"", L"Steam Big Picture", 0, 0});
+    CHECK_EQ(other.actions, FixedSize | Minimize);
+    CHECK_EQ(other.width, 1920);
+    CHECK_EQ(other.height, 1080);
+
+    CHECK_EQ(r.Evaluate({L"x", L"", L"", 0, 0}).actions, 0);
+}
+
+TEST(titles_longer_than_the_fold_buffer) {
+    const std::string longTitle(600, 'a');
+    const std::wstring wide(600, L'A');
+    const RuleSet r = Rules({
+      {"title:" + longTitle, "Ignore"},
+      {"title:\"*needle*\"", "Float"},
+      {"title:/needle$/", "Minimize"},
+    });
+    CHECK_EQ(Actions(r, L"x.exe", L"", wide), Ignore);          // literal over 512 chars, folded
+    CHECK_EQ(Actions(r, L"x.exe", L"", wide + L"b"), 0);
+    CHECK_EQ(Actions(r, L"x.exe", L"", wide.substr(0, 512)), 0);
+
+    std::wstring haystack(5000, L'x');
+    haystack += L"NEEDLE";
+    CHECK_EQ(Actions(r, L"x.exe", L"", haystack), Float | Minimize);
+}
+
+TEST(utf8_patterns_match_wide_titles) {
+    const RuleSet r = Rules({{"title:\"Caf\xC3\xA9 *\"", "Float"}});
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"Caf\u00E9 Menu"), Float);
+    CHECK_EQ(Actions(r, L"x.exe", L"", L"Cafe Menu"), 0);
+}
+
+TEST(bad_lines_are_skipped_and_the_rest_kept) {
+    RuleSet r;
+    const auto errors = r.Build({
+      {"exe:a.exe", "Explode"},            // 0 unknown action
+      {"colour:red", "Ignore"},            // 1 unknown field
+      {"exe:a.exe exe:b.exe", "Ignore"},   // 2 one matcher per field
+      {"title:/([/", "Ignore"},            // 3 invalid regex
+      {"title:\"open", "Ignore"},          // 4 unterminated quote
+      {"style:SHINY", "Ignore"},           // 5 unknown style
+      {"", "Ignore"},                      // 6 no matchers
+      {"exe:a.exe", "Size, 0, 600"},       // 7 size must be positive
+      {"exe:good.exe", "Float # comment"}, // 8 fine
+    });
+    CHECK_EQ(errors.size(), 8u);
+    for (size_t i = 0; i < errors.size(); ++i)
+        CHECK_EQ(errors[i].first, i);
+    CHECK_EQ(r.size(), 1u);
+    CHECK_EQ(Actions(r, L"good.exe"), Float);
+    CHECK_EQ(Actions(r, L"a.exe"), 0);
+}
+
+TEST(build_limits_and_ids) {
+    std::vector<RuleLine> lines;
+    for (size_t i = 0; i <= RuleSet::kMaxRules; ++i)
+        lines.push_back({"exe:app" + std::to_string(i) + ".exe", "Ignore"});
+    RuleSet r;
+    const auto errors = r.Build(lines);
+    CHECK_EQ(errors.size(), 1u);
+    CHECK_EQ(errors[0].first, RuleSet::kMaxRules);
+    CHECK_EQ(r.size(), RuleSet::kMaxRules);
+    CHECK_EQ(Actions(r, L"app1023.exe"), Ignore);
+    CHECK_EQ(Actions(r, L"app1024.exe"), 0);
+
+    // every Build is a new rule set for the memo
+    const uint64_t first = r.Id();
+    r.Build({{"exe:x.exe", "Float"}});
+    CHECK(r.Id() != first);
+    CHECK_EQ(Actions(r, L"app1.exe"), 0);
+    CHECK_EQ(Actions(RuleSet{}, L"x.exe"), 0);
+}
@@ -77,6 +77,7 @@ class Tray : public BaseTray {
     std::function<bool()> leftClickCb;
     std::function<bool()> doubleClickCb;
     std::function<bool()> rightClickCb;
+    std::function<void()> displayChangeCb;
 
     bool isExiting = false;
 
@@ -203,6 +204,10 @@ class Tray : public BaseTray {
     void onRightClick(std::function<bool()> cb) {
         rightClickCb = std::move(cb);
     }
+    // Monitors added/removed/rearranged, resolution or work area changed
+    void onDisplayChange(std::function<void()> cb) {
+        displayChangeCb = std::move(cb);
+    }
 
     // Change the tray icon at runtime.
     void setIcon(Icon ic) {
@@ -362,6 +367,16 @@ class Tray : public BaseTray {
                 tray.exit();
                 return 0;
             }
+            case WM_SETTINGCHANGE:
+                if (wParam != SPI_SETWORKAREA)
+                    break;
+                [[fallthrough]];
+            case WM_DISPLAYCHANGE: {
+                auto& tray = it->second.get();
+                if (tray.displayChangeCb)
+                    tray.displayChangeCb();
+                break;
+            }
             case WM_NCDESTROY: {
                 trayList.erase(hwnd);
                 break;
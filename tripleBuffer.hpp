@@ -0,0 +1,52 @@
+#pragma once
+// tripleBuffer.hpp
+// Single-producer, single-consumer "latest value" handoff. Writer and reader each own one slot,
+// the third sits in the middle; publishing and picking up a value is a single atomic exchange,
+// so both sides are wait-free and never block each other. Intermediate values may be skipped.
+//
+//   producer: buf.Write(v);
+//   consumer: const T& v = buf.Read(); // newest published value, or the previous one
+// Portable (no Windows headers).
+#include <atomic>
+#include <cstdint>
+
+template <typename T>
+class TripleBuffer {
+  public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const T& init) {
+        for (auto& s : slots_)
+            s.value = init;
+    }
+
+    // Producer thread only
+    void Write(const T& v) noexcept {
+        slots_[back_].value = v;
+        back_ = middle_.exchange(back_ | kFresh, std::memory_order_acq_rel) & kIndex;
+    }
+
+    // Consumer thread only. The reference stays valid until the next Read().
+    const T& Read() noexcept {
+        if (middle_.load(std::memory_order_relaxed) & kFresh)
+            front_ = middle_.exchange(front_, std::memory_order_acq_rel) & kIndex;
+        return slots_[front_].value;
+    }
+
+    // Consumer thread only: a value was published since the last Read()
+    bool Fresh() const noexcept {
+        return (middle_.load(std::memory_order_relaxed) & kFresh) != 0;
+    }
+
+  private:
+    static constexpr uint8_t kIndex = 0x3;
+    static constexpr uint8_t kFresh = 0x4;
+
+    struct alignas(64) Slot {
+        T value{};
+    };
+
+    Slot slots_[3];
+    alignas(64) std::atomic<uint8_t> middle_{1};
+    alignas(64) uint8_t back_ = 2;  // producer
+    alignas(64) uint8_t front_ = 0; // consumer
+};
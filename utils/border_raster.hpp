@@ -0,0 +1,268 @@
+// helpers/border_raster.hpp
+#pragma once
+// CPU rasterizer for the overlay border: anti-aliased rounded-rect strokes with an optional linear
+// gradient, written as premultiplied BGRA. Only the border band (the rows and columns a stroke can
+// reach) is written; the interior of the buffer is never touched and stays whatever it was (zero).
+// One kernel body, instantiated for AVX2 (8 lanes), SSE2 / NEON (4 lanes) or scalar, picked at
+// compile time. Portable (no Windows headers).
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HW_RASTER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HW_RASTER_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define HW_RASTER_NEON
+#endif
+
+namespace utils::raster {
+struct Rgba {
+    float r, g, b, a; // straight alpha, 0..1
+};
+
+// One stroke centred on a rounded rect inset from the buffer edges, like D2D DrawRoundedRectangle
+struct Stroke {
+    float inset;  // distance from the buffer edge to the stroke centre line
+    float width;  // stroke width
+    float radius; // corner radius of the centre line
+    Rgba start;   // colour at the gradient start point
+    Rgba end;     // colour at the gradient end point (same as start for solid)
+};
+
+// Strokes are composited in order (src-over), the gradient axis is shared
+struct Border {
+    Stroke strokes[2];
+    float gx1 = 0.f, gy1 = 0.f, gx2 = 0.f, gy2 = 0.f;
+};
+
+struct Target {
+    uint32_t* pixels = nullptr; // premultiplied BGRA, top-down
+    int width = 0;
+    int height = 0;
+    int stride = 0; // in pixels
+};
+
+namespace detail {
+// -------- lane types --------
+struct VScalar {
+    static constexpr int N = 1;
+    float v;
+    static VScalar Set(float f) noexcept { return {f}; }
+    static VScalar Ramp(float base) noexcept { return {base}; }
+    friend VScalar operator+(VScalar a, VScalar b) noexcept { return {a.v + b.v}; }
+    friend VScalar operator-(VScalar a, VScalar b) noexcept { return {a.v - b.v}; }
+    friend VScalar operator*(VScalar a, VScalar b) noexcept { return {a.v * b.v}; }
+    static VScalar Min(VScalar a, VScalar b) noexcept { return {a.v < b.v ? a.v : b.v}; }
+    static VScalar Max(VScalar a, VScalar b) noexcept { return {a.v > b.v ? a.v : b.v}; }
+    static VScalar Abs(VScalar a) noexcept { return {std::fabs(a.v)}; }
+    static VScalar Sqrt(VScalar a) noexcept { return {std::sqrt(a.v)}; }
+    // channels already clamped to [0, 255.5)
+    static void StoreBGRA(uint32_t* dst, VScalar b, VScalar g, VScalar r, VScalar a) noexcept {
+        *dst = static_cast<uint32_t>(b.v) | static_cast<uint32_t>(g.v) << 8 | static_cast<uint32_t>(r.v) << 16 | static_cast<uint32_t>(a.v) << 24;
+    }
+};
+
+#if defined(HW_RASTER_AVX2)
+struct VWide {
+    static constexpr int N = 8;
+    __m256 v;
+    static VWide Set(float f) noexcept { return {_mm256_set1_ps(f)}; }
+    static VWide Ramp(float base) noexcept { return {_mm256_add_ps(_mm256_set1_ps(base), _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7))}; }
+    friend VWide operator+(VWide a, VWide b) noexcept { return {_mm256_add_ps(a.v, b.v)}; }
+    friend VWide operator-(VWide a, VWide b) noexcept { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend VWide operator*(VWide a, VWide b) noexcept { return {_mm256_mul_ps(a.v, b.v)}; }
+    static VWide Min(VWide a, VWide b) noexcept { return {_mm256_min_ps(a.v, b.v)}; }
+    static VWide Max(VWide a, VWide b) noexcept { return {_mm256_max_ps(a.v, b.v)}; }
+    static VWide Abs(VWide a) noexcept { return {_mm256_andnot_ps(_mm256_set1_ps(-0.f), a.v)}; }
+    static VWide Sqrt(VWide a) noexcept { return {_mm256_sqrt_ps(a.v)}; }
+    static void StoreBGRA(uint32_t* dst, VWide b, VWide g, VWide r, VWide a) noexcept {
+        __m256i px = _mm256_cvttps_epi32(b.v);
+        px = _mm256_or_si256(px, _mm256_slli_epi32(_mm256_cvttps_epi32(g.v), 8));
+        px = _mm256_or_si256(px, _mm256_slli_epi32(_mm256_cvttps_epi32(r.v), 16));
+        px = _mm256_or_si256(px, _mm256_slli_epi32(_mm256_cvttps_epi32(a.v), 24));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), px);
+    }
+};
+inline constexpr const char* kKernel = "avx2";
+#elif defined(HW_RASTER_SSE2)
+struct VWide {
+    static constexpr int N = 4;
+    __m128 v;
+    static VWide Set(float f) noexcept { return {_mm_set1_ps(f)}; }
+    static VWide Ramp(float base) noexcept { return {_mm_add_ps(_mm_set1_ps(base), _mm_setr_ps(0, 1, 2, 3))}; }
+    friend VWide operator+(VWide a, VWide b) noexcept { return {_mm_add_ps(a.v, b.v)}; }
+    friend VWide operator-(VWide a, VWide b) noexcept { return {_mm_sub_ps(a.v, b.v)}; }
+    friend VWide operator*(VWide a, VWide b) noexcept { return {_mm_mul_ps(a.v, b.v)}; }
+    static VWide Min(VWide a, VWide b) noexcept { return {_mm_min_ps(a.v, b.v)}; }
+    static VWide Max(VWide a, VWide b) noexcept { return {_mm_max_ps(a.v, b.v)}; }
+    static VWide Abs(VWide a) noexcept { return {_mm_andnot_ps(_mm_set1_ps(-0.f), a.v)}; }
+    static VWide Sqrt(VWide a) noexcept { return {_mm_sqrt_ps(a.v)}; }
+    static void StoreBGRA(uint32_t* dst, VWide b, VWide g, VWide r, VWide a) noexcept {
+        __m128i px = _mm_cvttps_epi32(b.v);
+        px = _mm_or_si128(px, _mm_slli_epi32(_mm_cvttps_epi32(g.v), 8));
+        px = _mm_or_si128(px, _mm_slli_epi32(_mm_cvttps_epi32(r.v), 16));
+        px = _mm_or_si128(px, _mm_slli_epi32(_mm_cvttps_epi32(a.v), 24));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), px);
+    }
+};
+inline constexpr const char* kKernel = "sse2";
+#elif defined(HW_RASTER_NEON)
+struct VWide {
+    static constexpr int N = 4;
+    float32x4_t v;
+    static VWide Set(float f) noexcept { return {vdupq_n_f32(f)}; }
+    static VWide Ramp(float base) noexcept {
+        static constexpr float kRamp[4] = {0, 1, 2, 3};
+        return {vaddq_f32(vdupq_n_f32(base), vld1q_f32(kRamp))};
+    }
+    friend VWide operator+(VWide a, VWide b) noexcept { return {vaddq_f32(a.v, b.v)}; }
+    friend VWide operator-(VWide a, VWide b) noexcept { return {vsubq_f32(a.v, b.v)}; }
+    friend VWide operator*(VWide a, VWide b) noexcept { return {vmulq_f32(a.v, b.v)}; }
+    static VWide Min(VWide a, VWide b) noexcept { return {vminq_f32(a.v, b.v)}; }
+    static VWide Max(VWide a, VWide b) noexcept { return {vmaxq_f32(a.v, b.v)}; }
+    static VWide Abs(VWide a) noexcept { return {vabsq_f32(a.v)}; }
+    static VWide Sqrt(VWide a) noexcept { return {vsqrtq_f32(a.v)}; }
+    static void StoreBGRA(uint32_t* dst, VWide b, VWide g, VWide r, VWide a) noexcept {
+        uint32x4_t px = vcvtq_u32_f32(b.v);
+        px = vorrq_u32(px, vshlq_n_u32(vcvtq_u32_f32(g.v), 8));
+        px = vorrq_u32(px, vshlq_n_u32(vcvtq_u32_f32(r.v), 16));
+        px = vorrq_u32(px, vshlq_n_u32(vcvtq_u32_f32(a.v), 24));
+        vst1q_u32(dst, px);
+    }
+};
+inline constexpr const char* kKernel = "neon";
+#else
+using VWide = VScalar;
+inline constexpr const char* kKernel = "scalar";
+#endif
+
+// -------- prepared geometry --------
+struct PreparedStroke {
+    float cx, cy; // rect centre
+    float hx, hy; // half extent minus radius
+    float radius;
+    float edge; // width / 2 + 0.5: coverage = clamp(edge - |d|)
+    Rgba c0, dc;
+};
+
+struct Prepared {
+    PreparedStroke s[2];
+    float gx1, gy1, gdx, gdy; // gradient axis scaled by 1 / |axis|^2
+};
+
+inline Prepared Prepare(const Target& t, const Border& b) noexcept {
+    Prepared p{};
+    for (int i = 0; i < 2; ++i) {
+        const Stroke& st = b.strokes[i];
+        PreparedStroke& ps = p.s[i];
+        ps.cx = t.width * 0.5f;
+        ps.cy = t.height * 0.5f;
+        ps.radius = std::max(0.f, st.radius);
+        ps.hx = std::max(0.f, ps.cx - st.inset - ps.radius);
+        ps.hy = std::max(0.f, ps.cy - st.inset - ps.radius);
+        ps.edge = st.width * 0.5f + 0.5f;
+        ps.c0 = st.start;
+        ps.dc = {st.end.r - st.start.r, st.end.g - st.start.g, st.end.b - st.start.b, st.end.a - st.start.a};
+    }
+    const float dx = b.gx2 - b.gx1;
+    const float dy = b.gy2 - b.gy1;
+    const float len2 = dx * dx + dy * dy;
+    p.gx1 = b.gx1;
+    p.gy1 = b.gy1;
+    p.gdx = len2 > 0.f ? dx / len2 : 0.f;
+    p.gdy = len2 > 0.f ? dy / len2 : 0.f;
+    return p;
+}
+
+// Rows and columns from each edge that any stroke can cover
+inline int BandWidth(const Border& b) noexcept {
+    float band = 0.f;
+    for (const Stroke& st : b.strokes)
+        band = std::max(band, st.inset + st.width * 0.5f + st.radius);
+    return static_cast<int>(std::ceil(band)) + 1;
+}
+
+// -------- kernel --------
+template <typename V>
+inline void ShadeSpan(uint32_t* row, int x0, int x1, float py, const Prepared& p) noexcept {
+    const V zero = V::Set(0.f);
+    const V one = V::Set(1.f);
+    const V scale = V::Set(255.f);
+    const float tRow = (py - p.gy1) * p.gdy;
+
+    for (int x = x0; x + V::N <= x1; x += V::N) {
+        const V px = V::Ramp(x + 0.5f);
+        const V t = V::Min(one, V::Max(zero, (px - V::Set(p.gx1)) * V::Set(p.gdx) + V::Set(tRow)));
+
+        V r = zero, g = zero, b = zero, a = zero;
+        for (const PreparedStroke& s : p.s) {
+            // signed distance to the rounded rect centre line
+            const V qx = V::Abs(px - V::Set(s.cx)) - V::Set(s.hx);
+            const float qy = std::fabs(py - s.cy) - s.hy;
+            const V ox = V::Max(qx, zero);
+            const V oy = V::Set(std::max(qy, 0.f));
+            const V inside = V::Min(V::Max(qx, V::Set(qy)), zero);
+            const V d = V::Sqrt(ox * ox + oy * oy) + inside - V::Set(s.radius);
+            const V cov = V::Min(one, V::Max(zero, V::Set(s.edge) - V::Abs(d)));
+
+            // premultiplied source, src-over onto the accumulator
+            const V sa = (V::Set(s.c0.a) + V::Set(s.dc.a) * t) * cov;
+            const V inv = one - sa;
+            r = (V::Set(s.c0.r) + V::Set(s.dc.r) * t) * sa + r * inv;
+            g = (V::Set(s.c0.g) + V::Set(s.dc.g) * t) * sa + g * inv;
+            b = (V::Set(s.c0.b) + V::Set(s.dc.b) * t) * sa + b * inv;
+            a = sa + a * inv;
+        }
+
+        const V half = V::Set(0.5f);
+        V::StoreBGRA(row + x, b * scale + half, g * scale + half, r * scale + half, a * scale + half);
+    }
+}
+
+inline void Span(uint32_t* row, int x0, int x1, float py, const Prepared& p) noexcept {
+    const int wide = x0 + (x1 - x0) / VWide::N * VWide::N;
+    ShadeSpan<VWide>(row, x0, wide, py, p);
+    if (wide == x1)
+        return;
+    // tail: one more vector ending at x1 (rewrites a few pixels with the same values), scalar if too short
+    if (x1 - x0 >= VWide::N)
+        ShadeSpan<VWide>(row, x1 - VWide::N, x1, py, p);
+    else
+        ShadeSpan<VScalar>(row, x0, x1, py, p);
+}
+} // namespace detail
+
+inline const char* KernelName() noexcept {
+    return detail::kKernel;
+}
+
+// Draws b into t, returns the number of pixels written
+inline size_t Draw(const Target& t, const Border& b) noexcept {
+    if (!t.pixels || t.width <= 0 || t.height <= 0)
+        return 0;
+
+    const detail::Prepared p = detail::Prepare(t, b);
+    const int band = detail::BandWidth(b);
+    size_t written = 0;
+
+    for (int y = 0; y < t.height; ++y) {
+        uint32_t* row = t.pixels + static_cast<size_t>(y) * t.stride;
+        const float py = y + 0.5f;
+        if (y < band || y >= t.height - band || 2 * band >= t.width) {
+            detail::Span(row, 0, t.width, py, p);
+            written += t.width;
+        } else {
+            detail::Span(row, 0, band, py, p);
+            detail::Span(row, t.width - band, t.width, py, p);
+            written += 2 * static_cast<size_t>(band);
+        }
+    }
+    return written;
+}
+} // namespace utils::raster
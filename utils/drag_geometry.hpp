@@ -0,0 +1,134 @@
+// helpers/drag_geometry.hpp
+#pragma once
+// Move/resize geometry for the overlay drag: (drag state, cursor) -> window bounds.
+// Pure constexpr functions on plain ints, no allocation, branches only as selects.
+// Portable (no Windows headers); overlayController converts from RECT/POINT.
+#include <cstdint>
+#include <limits>
+
+namespace utils::geom {
+struct Point {
+    int32_t x = 0, y = 0;
+};
+
+struct Size {
+    int32_t cx = 0, cy = 0;
+};
+
+struct Rect {
+    int32_t left = 0, top = 0, right = 0, bottom = 0;
+
+    constexpr int32_t Width() const noexcept { return right - left; }
+    constexpr int32_t Height() const noexcept { return bottom - top; }
+    constexpr bool operator==(const Rect&) const = default;
+};
+
+// bit 0: the right edge follows the cursor, bit 1: the bottom edge does
+enum class Corner : uint8_t { TopLeft = 0, TopRight = 1, BottomLeft = 2, BottomRight = 3 };
+
+constexpr bool MovesRight(Corner c) noexcept { return (static_cast<uint8_t>(c) & 1) != 0; }
+constexpr bool MovesBottom(Corner c) noexcept { return (static_cast<uint8_t>(c) & 2) != 0; }
+
+// Modifier-driven variants, combinable
+enum ResizeMode : uint8_t {
+    Free = 0,
+    AspectLock = 1 << 0, // keep the starting width:height
+    Centered = 1 << 1,   // grow/shrink symmetrically around the starting centre
+    Snap = 1 << 2,       // round width/height to multiples of grid
+};
+
+struct ResizeParams {
+    Rect start{};         // bounds when the drag began
+    Point startCursor{};  // cursor when the drag began
+    Corner corner = Corner::BottomRight;
+    Size minSize{1, 1};
+    Size maxSize{};       // <= 0: unbounded
+    uint8_t mode = Free;
+    int32_t grid = 16;    // Snap step in pixels
+};
+
+// Corner of r nearest to p (its quadrant); degenerate rects resize from the bottom right
+constexpr Corner PickCorner(const Rect& r, Point p) noexcept {
+    const int32_t w = r.Width();
+    const int32_t h = r.Height();
+    if (w <= 0 || h <= 0)
+        return Corner::BottomRight;
+    const uint8_t right = 2 * (p.x - r.left) >= w ? 1 : 0;
+    const uint8_t bottom = 2 * (p.y - r.top) >= h ? 2 : 0;
+    return static_cast<Corner>(right | bottom);
+}
+
+// Window follows the cursor keeping the grab offset
+constexpr Rect MoveTo(const Rect& start, Point dragOffset, Point cursor) noexcept {
+    const int32_t left = cursor.x - dragOffset.x;
+    const int32_t top = cursor.y - dragOffset.y;
+    return {left, top, left + start.Width(), top + start.Height()};
+}
+
+namespace detail {
+constexpr int32_t Clamp(int32_t v, int32_t lo, int32_t hi) noexcept {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+constexpr int32_t SnapTo(int32_t v, int32_t grid) noexcept {
+    return grid > 1 ? (v + grid / 2) / grid * grid : v;
+}
+} // namespace detail
+
+constexpr Rect Resize(const ResizeParams& p, Point cursor) noexcept {
+    const Rect& s = p.start;
+    const int32_t w0 = s.Width();
+    const int32_t h0 = s.Height();
+    const bool right = MovesRight(p.corner);
+    const bool bottom = MovesBottom(p.corner);
+    const bool centered = (p.mode & Centered) != 0;
+
+    // size from the cursor delta, doubled when both edges move
+    const int32_t gain = centered ? 2 : 1;
+    const int32_t dx = cursor.x - p.startCursor.x;
+    const int32_t dy = cursor.y - p.startCursor.y;
+    int32_t w = w0 + (right ? dx : -dx) * gain;
+    int32_t h = h0 + (bottom ? dy : -dy) * gain;
+
+    // aspect lock follows whichever axis grew more (relative to the start)
+    if ((p.mode & AspectLock) && w0 > 0 && h0 > 0) {
+        const int64_t wh = static_cast<int64_t>(w) * h0;
+        const int64_t hw = static_cast<int64_t>(h) * w0;
+        if (wh >= hw)
+            h = static_cast<int32_t>(wh / w0);
+        else
+            w = static_cast<int32_t>(hw / h0);
+    }
+
+    if (p.mode & Snap) {
+        w = detail::SnapTo(w, p.grid);
+        h = detail::SnapTo(h, p.grid);
+    }
+
+    // window limits win over aspect and snapping
+    constexpr int32_t kMax = std::numeric_limits<int32_t>::max();
+    const int32_t minW = p.minSize.cx > 1 ? p.minSize.cx : 1;
+    const int32_t minH = p.minSize.cy > 1 ? p.minSize.cy : 1;
+    w = detail::Clamp(w, minW, p.maxSize.cx > 0 && p.maxSize.cx >= minW ? p.maxSize.cx : kMax);
+    h = detail::Clamp(h, minH, p.maxSize.cy > 0 && p.maxSize.cy >= minH ? p.maxSize.cy : kMax);
+
+    Rect r{};
+    if (centered) {
+        // integer centre, the odd pixel goes right/down
+        r.left = s.left + (w0 - w) / 2;
+        r.top = s.top + (h0 - h) / 2;
+        r.right = r.left + w;
+        r.bottom = r.top + h;
+    } else {
+        r.left = right ? s.left : s.right - w;
+        r.right = right ? s.left + w : s.right;
+        r.top = bottom ? s.top : s.bottom - h;
+        r.bottom = bottom ? s.top + h : s.bottom;
+    }
+    return r;
+}
+
+static_assert(PickCorner({0, 0, 100, 100}, {10, 90}) == Corner::BottomLeft);
+static_assert(Resize({{0, 0, 100, 50}, {100, 50}, Corner::BottomRight}, {120, 60}) == Rect{0, 0, 120, 60});
+static_assert(Resize({{0, 0, 100, 50}, {0, 0}, Corner::TopLeft, {80, 40}}, {50, 50}) == Rect{20, 10, 100, 50});
+} // namespace utils::geom
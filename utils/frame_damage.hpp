@@ -0,0 +1,39 @@
+// helpers/frame_damage.hpp
+#pragma once
+// Overlay damage tracking. A frame is drawn only when something that affects its pixels changed
+// since the last drawn frame; moving the window alone never needs a redraw.
+// Portable (no Windows headers).
+#include <cstdint>
+
+namespace utils::render {
+struct FrameKey {
+    int32_t width = 0;
+    int32_t height = 0;
+    uint32_t dpi = 0;
+    uint32_t style = 0; // bumped on color, gradient or thickness changes
+    float phase = 0.f;  // gradient angle
+
+    bool operator==(const FrameKey&) const = default;
+};
+
+class DamageTracker {
+  public:
+    // True if k differs from the last committed key (and records it)
+    bool Commit(const FrameKey& k) noexcept {
+        if (valid && k == last)
+            return false;
+        last = k;
+        valid = true;
+        return true;
+    }
+
+    // Next Commit() draws regardless (window shown, target recreated)
+    void Invalidate() noexcept {
+        valid = false;
+    }
+
+  private:
+    FrameKey last{};
+    bool valid = false;
+};
+} // namespace utils::render
@@ -0,0 +1,29 @@
+// helpers/frame_loop.hpp
+#pragma once
+// One overlay frame after the draw decision: pace it and count it. OverlayWindow::PreRender runs
+// this once per loop iteration with the real clock; the tests drive it headless with a fake clock
+// and a synthetic cursor path.
+// Portable (no Windows headers).
+#include <functional>
+
+#include "frame_pacer.hpp"
+#include "render_stats.hpp"
+
+namespace utils::render {
+// moved: onFrame saw a new cursor sample; drawn: Render() found damage and drew
+template <typename Clock>
+pacing::Frame PaceFrame(pacing::FramePacer<Clock>& pacer, Counters& c, bool moved, bool drawn, bool presentWaits, const std::function<void()>& waitInput) {
+    const auto before = pacer.GetStats();
+    const pacing::Frame frame = pacer.Step(moved, drawn, presentWaits, waitInput);
+    if (frame == pacing::Frame::Waited) {
+        Count(c.framesSkipped);
+        return frame;
+    }
+    const auto& after = pacer.GetStats();
+    Count(frame == pacing::Frame::Drawn ? c.framesDrawn : c.framesSkipped);
+    Count(c.frames);
+    Count(c.missedFrames, after.missed - before.missed);
+    Count(c.idleFrames, after.idleFrames - before.idleFrames);
+    return frame;
+}
+} // namespace utils::render
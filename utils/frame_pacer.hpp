@@ -0,0 +1,113 @@
+// helpers/frame_pacer.hpp
+#pragma once
+// Overlay frame scheduling policy. Frames start on a fixed grid at the monitor's refresh period;
+// while the cursor is idle the period drops to an idle cap. A frame that overruns its slot counts
+// as missed and the grid skips ahead instead of bursting to catch up.
+// Portable (no Windows headers): the clock is injected, so the policy can be driven by a fake clock.
+//
+//   struct Clock { uint64_t Now(); void SleepUntil(uint64_t ns); };
+#include <cstdint>
+#include <functional>
+
+#include "latency.hpp"
+
+namespace utils::pacing {
+enum class Frame : uint8_t {
+    Drawn,   // rendered and presented
+    Skipped, // nothing to draw but the loop keeps ticking (the window moved)
+    Waited,  // nothing changed at all: slept on input instead of the grid
+};
+
+struct PacerConfig {
+    uint64_t periodNs = 16'666'667;     // 1 / refresh rate
+    uint64_t idlePeriodNs = 33'333'333; // cap while the cursor is still
+    uint64_t idleAfterNs = 250'000'000; // no activity for this long -> idle
+};
+
+template <typename Clock>
+class FramePacer {
+  public:
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t missed = 0; // frames that finished after the next slot started
+        uint64_t idleFrames = 0;
+    };
+
+    FramePacer(Clock& c, const PacerConfig& config, latency::Histogram* frameTimes = nullptr) noexcept : clock(c), cfg(config), hist(frameTimes) {
+        const uint64_t now = clock.Now();
+        next = now + cfg.periodNs;
+        lastStart = now;
+        lastActivity = now;
+    }
+
+    // Something on screen changed (cursor moved, geometry changed)
+    void Activity() noexcept {
+        lastActivity = clock.Now();
+    }
+
+    bool Idle(uint64_t now) const noexcept {
+        return now - lastActivity >= cfg.idleAfterNs;
+    }
+
+    // Call after presenting a frame. presentWaited: the present already blocked on vblank
+    // (vsync), so only re-base the grid; otherwise sleep until the next slot.
+    void EndFrame(bool presentWaited = false) noexcept {
+        uint64_t now = clock.Now();
+        const bool idle = Idle(now);
+        const uint64_t period = idle ? cfg.idlePeriodNs : cfg.periodNs;
+        ++stats.frames;
+        if (idle)
+            ++stats.idleFrames;
+
+        if (presentWaited && !idle) {
+            next = now + period;
+        } else {
+            if (now > next) {
+                ++stats.missed;
+                next += ((now - next) / period + 1) * period;
+            }
+            clock.SleepUntil(next);
+            now = clock.Now();
+            next += period;
+        }
+
+        if (hist)
+            hist->Record(now - lastStart);
+        lastStart = now;
+    }
+
+    // One iteration of a render loop, after onFrame and the draw. Only a frame that was actually
+    // presented can have waited on vblank; skipped frames still sleep to the next slot so a drag
+    // that only moves the window is paced like one that redraws.
+    Frame Step(bool moved, bool drawn, bool presentWaits, const std::function<void()>& waitInput = {}) {
+        if (moved)
+            Activity();
+        if (!drawn && !moved && waitInput) {
+            waitInput();
+            Rebase();
+            return Frame::Waited;
+        }
+        EndFrame(drawn && presentWaits);
+        return drawn ? Frame::Drawn : Frame::Skipped;
+    }
+
+    // Restart the grid from now, after the loop slept on something other than the pacer
+    void Rebase() noexcept {
+        lastStart = clock.Now();
+        next = lastStart + cfg.periodNs;
+    }
+
+    const Stats& GetStats() const noexcept {
+        return stats;
+    }
+
+  private:
+    Clock& clock;
+    PacerConfig cfg;
+    latency::Histogram* hist;
+    uint64_t next = 0;
+    uint64_t lastStart = 0;
+    uint64_t lastActivity = 0;
+    Stats stats{};
+};
+} // namespace utils::pacing
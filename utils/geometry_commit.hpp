@@ -0,0 +1,47 @@
+// helpers/geometry_commit.hpp
+#pragma once
+// The commit decision behind OverlayWindow::SetGeometry: whether a new screen rect needs a
+// window-manager commit at all and which parts of it changed (position, size, z-order). At most
+// one commit per call reaches the recorder; the overlay records into SetWindowPos, tests into a list.
+// Portable (no Windows headers).
+#include "drag_geometry.hpp"
+
+namespace utils::render {
+struct GeometryCommit {
+    geom::Rect rect;
+    bool move = false;    // position changed, SWP_NOMOVE otherwise
+    bool size = false;    // size changed, SWP_NOSIZE otherwise
+    bool reorder = false; // restack requested, SWP_NOZORDER otherwise
+};
+
+class GeometryRecorder {
+  public:
+    virtual ~GeometryRecorder() = default;
+    virtual void Commit(const GeometryCommit& c) = 0;
+};
+
+// Last committed rect. Unchanged rects without a restack are skipped; the first Set after
+// construction or Reset() always commits both position and size.
+class GeometryState {
+  public:
+    // What was committed; all false when skipped
+    GeometryCommit Set(const geom::Rect& r, bool reorder, GeometryRecorder& out) {
+        const GeometryCommit c{r,
+          !known || r.left != last.left || r.top != last.top,
+          !known || r.Width() != last.Width() || r.Height() != last.Height(),
+          reorder};
+        if (!c.move && !c.size && !c.reorder)
+            return {};
+        out.Commit(c);
+        last = r;
+        known = true;
+        return c;
+    }
+
+    void Reset() noexcept { known = false; }
+
+  private:
+    geom::Rect last{};
+    bool known = false;
+};
+} // namespace utils::render
@@ -0,0 +1,31 @@
+// helpers/gradient.hpp
+#pragma once
+// Linear gradient geometry for the overlay border. The brushes are built once per style;
+// rotation only moves their start/end points, computed here.
+// Portable (no Windows headers).
+#include <cmath>
+
+namespace utils::gradient {
+struct Endpoints {
+    float x1, y1, x2, y2;
+};
+
+// Gradient axis through the centre of a width x height box at angleDeg, long enough
+// to cover the corners at any angle (half-length = half the diagonal)
+inline Endpoints ForAngle(float width, float height, float angleDeg) noexcept {
+    const float angleRad = angleDeg * (3.14159265f / 180.0f);
+    const float cx = width * 0.5f;
+    const float cy = height * 0.5f;
+    const float radius = std::hypot(cx, cy);
+    const float dx = std::cos(angleRad) * radius;
+    const float dy = std::sin(angleRad) * radius;
+    return {cx - dx, cy - dy, cx + dx, cy + dy};
+}
+
+// Angle after dtSec at speedDegPerSec, wrapped to [0, 360)
+inline float Advance(float angleDeg, float speedDegPerSec, float dtSec) noexcept {
+    const float a = angleDeg + speedDegPerSec * dtSec;
+    const float wrapped = a - 360.0f * std::floor(a / 360.0f);
+    return wrapped >= 360.0f ? 0.0f : wrapped;
+}
+} // namespace utils::gradient
@@ -0,0 +1,152 @@
+// helpers/latency.hpp
+#pragma once
+// Always-on latency histograms for the input pipeline.
+// Log-linear buckets (8 per power of two, <= 12.5% error), relaxed atomics only:
+// Record() is one fetch_add plus a rarely taken max update, safe from hook callbacks.
+// Portable (no Windows headers).
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+// Report() needs <format>; the portable tests also build on standard libraries without it
+#if __has_include(<format>)
+#include <format>
+#endif
+#include <string>
+#include <string_view>
+
+namespace utils::latency {
+class Histogram {
+  public:
+    static constexpr int kSubBits = 3;
+    static constexpr uint64_t kSub = 1ull << kSubBits;
+    static constexpr size_t kBuckets = (64 - kSubBits + 1) * kSub;
+
+    struct Snapshot {
+        uint64_t count = 0;
+        uint64_t p50 = 0;
+        uint64_t p99 = 0;
+        uint64_t p999 = 0;
+        uint64_t max = 0;
+    };
+
+    static constexpr size_t Index(uint64_t v) noexcept {
+        if (v < kSub)
+            return static_cast<size_t>(v);
+        const int e = std::bit_width(v) - 1; // >= kSubBits
+        const uint64_t sub = (v >> (e - kSubBits)) & (kSub - 1);
+        return static_cast<size_t>((e - kSubBits + 1) * kSub + sub);
+    }
+
+    // Largest value that maps to bucket i
+    static constexpr uint64_t UpperBound(size_t i) noexcept {
+        if (i < kSub)
+            return i;
+        const int e = static_cast<int>(i / kSub) + kSubBits - 1;
+        const uint64_t sub = i & (kSub - 1);
+        const uint64_t lo = (1ull << e) | (sub << (e - kSubBits));
+        return lo + (1ull << (e - kSubBits)) - 1;
+    }
+
+    void Record(uint64_t v) noexcept {
+        buckets[Index(v)].fetch_add(1, std::memory_order_relaxed);
+        uint64_t cur = maxValue.load(std::memory_order_relaxed);
+        while (v > cur && !maxValue.compare_exchange_weak(cur, v, std::memory_order_relaxed)) {}
+    }
+
+    void Reset() noexcept {
+        for (auto& b : buckets)
+            b.store(0, std::memory_order_relaxed);
+        maxValue.store(0, std::memory_order_relaxed);
+    }
+
+    Snapshot Snap() const noexcept {
+        std::array<uint32_t, kBuckets> counts{};
+        Snapshot s{};
+        for (size_t i = 0; i < kBuckets; ++i) {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+            s.count += counts[i];
+        }
+        s.max = maxValue.load(std::memory_order_relaxed);
+        if (!s.count)
+            return s;
+
+        const uint64_t r50 = (s.count * 500 + 999) / 1000;
+        const uint64_t r99 = (s.count * 990 + 999) / 1000;
+        const uint64_t r999 = (s.count * 999 + 999) / 1000;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < kBuckets; ++i) {
+            if (!counts[i])
+                continue;
+            seen += counts[i];
+            const uint64_t ub = UpperBound(i) < s.max ? UpperBound(i) : s.max;
+            if (!s.p50 && seen >= r50)
+                s.p50 = ub;
+            if (!s.p99 && seen >= r99)
+                s.p99 = ub;
+            if (!s.p999 && seen >= r999) {
+                s.p999 = ub;
+                break;
+            }
+        }
+        return s;
+    }
+
+  private:
+    std::array<std::atomic<uint32_t>, kBuckets> buckets{};
+    std::atomic<uint64_t> maxValue{0};
+};
+
+static_assert(Histogram::Index(Histogram::UpperBound(100)) == 100, "bucket bounds must round-trip");
+static_assert(Histogram::Index(~0ull) < Histogram::kBuckets, "bucket table too small");
+
+// Pipeline stages, all in nanoseconds
+enum class Stage : uint8_t {
+    KeyHook,     // HookProc entry -> queued
+    KeyQueue,    // capture -> dequeued by the input thread
+    KeyDecode,   // modifier/state tracking in ProcessKey
+    KeyLookup,   // keybind lookup
+    KeyAction,   // DispatchAction for all bound actions
+    KeyTotal,    // capture -> actions done
+    MouseHook,   // MouseProc entry -> queued
+    MouseQueue,  // capture -> dequeued
+    MouseDecode, // hit-test and target filtering
+    MouseAction, // target setup -> OverlayController::UpdateState
+    MouseTotal,  // capture -> UpdateState
+    ArmOnDemand,     // SUPER down -> mouse hook installed (MOUSE_HOOK = ONDEMAND)
+    ArmPersistent,   // SUPER down -> capture gate open (MOUSE_HOOK = PERSISTENT)
+    FirstOnDemand,   // SUPER down -> first captured click
+    FirstPersistent, // same, persistent hook
+    Count
+};
+
+inline constexpr std::string_view kStageNames[] = {
+  "key.hook", "key.queue", "key.decode", "key.lookup", "key.action", "key.total", "mouse.hook", "mouse.queue", "mouse.decode", "mouse.action", "mouse.total",
+  "arm.ondemand", "arm.persist", "first.ondemand", "first.persist"};
+static_assert(std::size(kStageNames) == static_cast<size_t>(Stage::Count), "stage names out of sync");
+
+inline std::array<Histogram, static_cast<size_t>(Stage::Count)> g_stages{};
+
+inline void Record(Stage s, uint64_t ns) noexcept {
+    g_stages[static_cast<size_t>(s)].Record(ns);
+}
+
+inline void ResetAll() noexcept {
+    for (auto& h : g_stages)
+        h.Reset();
+}
+
+// Plain text table, one stage per line, values in microseconds
+#if __has_include(<format>)
+inline std::string Report() {
+    std::string out = std::format("{:<16}{:>10}{:>12}{:>12}{:>12}{:>12}\n", "stage", "count", "p50 us", "p99 us", "p999 us", "max us");
+    for (size_t i = 0; i < g_stages.size(); ++i) {
+        const Histogram::Snapshot s = g_stages[i].Snap();
+        out += std::format(
+          "{:<16}{:>10}{:>12.2f}{:>12.2f}{:>12.2f}{:>12.2f}\n", kStageNames[i], s.count, s.p50 / 1000.0, s.p99 / 1000.0, s.p999 / 1000.0, s.max / 1000.0);
+    }
+    return out;
+}
+#endif
+} // namespace utils::latency
@@ -0,0 +1,75 @@
+// helpers/live_throttle.hpp
+#pragma once
+// Per-application pacing for live drag: how often a window may be sent new geometry.
+// Each app's turnaround (time for SetWindowPos to return, i.e. for the owning thread to handle
+// the resize) is tracked as an EWMA; the next update waits turnaround * headroom, clamped to
+// [minInterval, maxInterval]. Fast apps track at display rate, slow apps get fewer, coalesced
+// updates. Estimates are kept per app across drags.
+// Portable (no Windows headers): apps are identified by a caller-supplied 64-bit key.
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace utils::live {
+struct ThrottleConfig {
+    uint64_t minIntervalNs = 8'000'000;   // never faster than this (set to the display period)
+    uint64_t maxIntervalNs = 200'000'000; // slow apps still get 5 updates/s
+    float headroom = 1.5f;                // leave the app time to repaint between updates
+    float alpha = 0.2f;                   // weight of a new turnaround sample
+};
+
+class AppThrottle {
+  public:
+    // Next drag: forget the last apply time, keep the turnaround estimate
+    void BeginDrag() noexcept {
+        applied = false;
+    }
+
+    uint64_t IntervalNs(const ThrottleConfig& c) const noexcept {
+        const uint64_t want = static_cast<uint64_t>(turnaroundNs * c.headroom);
+        return want < c.minIntervalNs ? c.minIntervalNs : (want > c.maxIntervalNs ? c.maxIntervalNs : want);
+    }
+
+    // Earliest time the next update may start
+    uint64_t DueAt(const ThrottleConfig& c) const noexcept {
+        return applied ? lastStartNs + IntervalNs(c) : 0;
+    }
+
+    bool Due(uint64_t nowNs, const ThrottleConfig& c) const noexcept {
+        return nowNs >= DueAt(c);
+    }
+
+    void Applied(uint64_t startNs, uint64_t turnaround, const ThrottleConfig& c) noexcept {
+        const float t = static_cast<float>(turnaround);
+        turnaroundNs = samples ? turnaroundNs + c.alpha * (t - turnaroundNs) : t;
+        lastStartNs = startNs;
+        applied = true;
+        ++samples;
+    }
+
+    uint64_t TurnaroundNs() const noexcept {
+        return static_cast<uint64_t>(turnaroundNs);
+    }
+
+  private:
+    float turnaroundNs = 0.f;
+    uint64_t lastStartNs = 0;
+    uint64_t samples = 0;
+    bool applied = false;
+};
+
+// Owned by the applying thread
+class ThrottleTable {
+  public:
+    static constexpr size_t kMaxApps = 256;
+
+    AppThrottle& For(uint64_t appKey) {
+        if (apps.size() >= kMaxApps && !apps.contains(appKey))
+            apps.clear(); // estimates are cheap to relearn
+        return apps[appKey];
+    }
+
+  private:
+    std::unordered_map<uint64_t, AppThrottle> apps;
+};
+} // namespace utils::live
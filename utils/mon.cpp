@@ -2,7 +2,9 @@
 #include "mon.hpp"
 #include <vector>
 #include <dwmapi.h>
+#include <ShellScalingApi.h>
 #pragma comment(lib, "Dwmapi.lib")
+#pragma comment(lib, "Shcore.lib")
 
 namespace utils::mon {
 // -------- Monitors and work areas --------
@@ -27,44 +29,91 @@ RECT GetWorkArea(HMONITOR mon) {
 }
 
 // helpers/mon.cpp
-HMONITOR FindAdjacentMonitorX(HWND hwnd, bool toRight) {
-    HMONITOR cur = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
-    MONITORINFO cmi{sizeof(cmi)};
-    if (!GetMonitorInfoW(cur, &cmi))
-        return nullptr;
-
-    const long cx = (cmi.rcWork.left + cmi.rcWork.right) / 2;
-
-    std::vector<MonInfo> mons;
-    EnumDisplayMonitors(nullptr, nullptr, EnumMonProc, reinterpret_cast<LPARAM>(&mons));
-
-    long bestDist = LONG_MAX;
-    HMONITOR best = nullptr;
-
-    for (const auto& m : mons) {
-        if (m.mon == cur)
-            continue; // do not consider current monitor
-        long dx = m.center.x - cx;
-
-        if (toRight) {
-            if (dx <= 0)
-                continue; // must be strictly to the right
-            if (dx < bestDist) {
-                bestDist = dx;
-                best = m.mon;
-            }
-        } else {
-            if (dx >= 0)
-                continue;   // must be strictly to the left
-            long pdx = -dx; // distance magnitude
-            if (pdx < bestDist) {
-                bestDist = pdx;
-                best = m.mon;
-            }
-        }
+// -------- Topology --------
+
+static int QueryRefreshRate(const wchar_t* device) {
+    DEVMODEW dm{};
+    dm.dmSize = sizeof(dm);
+    if (!EnumDisplaySettingsW(device, ENUM_CURRENT_SETTINGS, &dm))
+        return 60;
+
+    // 0 and 1 mean "hardware default"
+    return dm.dmDisplayFrequency > 1 ? static_cast<int>(dm.dmDisplayFrequency) : 60;
+}
+
+static geom::Rect FromRECT(const RECT& r) {
+    return {r.left, r.top, r.right, r.bottom};
+}
+
+static Topology QueryTopology() {
+    std::vector<Monitor> mons;
+    EnumDisplayMonitors(
+      nullptr, nullptr,
+      [](HMONITOR hMon, HDC, LPRECT, LPARAM lp) -> BOOL {
+          MONITORINFOEXW mi{};
+          mi.cbSize = sizeof(mi);
+          if (!GetMonitorInfoW(hMon, &mi))
+              return TRUE;
+          UINT dpiX = 96, dpiY = 96;
+          if (FAILED(GetDpiForMonitor(hMon, MDT_EFFECTIVE_DPI, &dpiX, &dpiY)))
+              dpiX = 96;
+          reinterpret_cast<std::vector<Monitor>*>(lp)->push_back(
+            {reinterpret_cast<uint64_t>(hMon), FromRECT(mi.rcMonitor), FromRECT(mi.rcWork), dpiX, static_cast<uint32_t>(QueryRefreshRate(mi.szDevice))});
+          return TRUE;
+      },
+      reinterpret_cast<LPARAM>(&mons));
+    return BuildTopology(std::move(mons));
+}
+
+namespace {
+struct TopologyCache {
+    std::mutex lock;
+    std::shared_ptr<const Topology> current;
+};
+
+TopologyCache& Cache() {
+    static TopologyCache cache;
+    return cache;
+}
+} // namespace
+
+std::shared_ptr<const Topology> GetTopology() {
+    TopologyCache& cache = Cache();
+    {
+        std::scoped_lock lock(cache.lock);
+        if (cache.current)
+            return cache.current;
     }
+    RefreshTopology();
+    std::scoped_lock lock(cache.lock);
+    return cache.current;
+}
+
+void RefreshTopology() {
+    auto next = std::make_shared<const Topology>(QueryTopology());
+    TopologyCache& cache = Cache();
+    std::scoped_lock lock(cache.lock);
+    cache.current = std::move(next);
+}
 
-    return best; // nullptr if none found
+HMONITOR FindAdjacentMonitor(HWND hwnd, spatial::Dir dir) {
+    const HMONITOR cur = MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST);
+    const std::shared_ptr<const Topology> topo = GetTopology();
+    const Monitor* next = topo->Neighbour(reinterpret_cast<uint64_t>(cur), dir);
+    return next ? reinterpret_cast<HMONITOR>(next->key) : nullptr;
+}
+
+int GetRefreshRate(HMONITOR mon) {
+    const std::shared_ptr<const Topology> topo = GetTopology();
+    if (const int32_t i = topo->Find(reinterpret_cast<uint64_t>(mon)); i != kNoMonitor)
+        return static_cast<int>(topo->monitors[i].refreshHz);
+
+    // not in the cached layout (changed since the last rebuild)
+    MONITORINFOEXW mi{};
+    mi.cbSize = sizeof(mi);
+    if (!GetMonitorInfoW(mon, &mi))
+        return 60;
+    return QueryRefreshRate(mi.szDevice);
 }
 
 bool IsBorderlessFullscreen(HWND hwnd, const RECT& wr) {
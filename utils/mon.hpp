@@ -1,36 +1,23 @@
 // helpers/mon.hpp
-
+#pragma once
 #include <windows.h>
+#include <memory>
 
-// Internal helpers and data
-namespace {
-struct MonInfo {
-    HMONITOR mon{};
-    RECT work{};
-    POINT center{};
-};
-
-static BOOL CALLBACK EnumMonProc(HMONITOR hMon, HDC, LPRECT, LPARAM lp) {
-    auto* out = reinterpret_cast<std::vector<MonInfo>*>(lp);
-    MONITORINFO mi{sizeof(mi)};
-    if (!GetMonitorInfoW(hMon, &mi))
-        return TRUE;
-    MonInfo m;
-    m.mon = hMon;
-    m.work = mi.rcWork;
-    m.center.x = (mi.rcWork.left + mi.rcWork.right) / 2;
-    m.center.y = (mi.rcWork.top + mi.rcWork.bottom) / 2;
-    out->push_back(m);
-    return TRUE;
-}
-} // namespace
+#include "monitor_graph.hpp"
 
 namespace utils::mon {
 // Monitors and work areas
 HMONITOR GetMonitorFromCursor();
 RECT GetWorkAreaFromWindow(HWND hwnd);
 RECT GetWorkArea(HMONITOR mon);
-HMONITOR FindAdjacentMonitorX(HWND hwnd, bool toRight); // nearest strictly left/right along X
+int GetRefreshRate(HMONITOR mon); // Hz, 60 if unknown
+
+// Monitor layout, built on first use and on RefreshTopology (display or work area changes);
+// readers keep the returned pointer for as long as they use it
+std::shared_ptr<const Topology> GetTopology();
+void RefreshTopology();
+// Neighbour of hwnd's monitor sharing the edge in dir (see monitor_graph.hpp), nullptr if none
+HMONITOR FindAdjacentMonitor(HWND hwnd, spatial::Dir dir);
 
 bool IsBorderlessFullscreen(HWND hwnd, const RECT& wr);
 
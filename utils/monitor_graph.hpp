@@ -0,0 +1,110 @@
+// helpers/monitor_graph.hpp
+#pragma once
+// Monitor layout with precomputed left/right/up/down neighbours.
+// Two monitors are neighbours when they share an edge: the other monitor starts past this one's
+// edge (give or take `tolerance` px, mixed-DPI layouts rarely line up exactly) and their spans
+// across that edge overlap by more than `tolerance`. The closest such monitor wins, then the one
+// with the longest shared edge. Without any, the nearest monitor wholly past the edge is used
+// (diagonal corners of L-shaped layouts), measured as gap + perpendicular offset.
+// Built once per display change; lookups are array reads.
+// Portable (no Windows headers): monitors are opaque 64-bit keys.
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "drag_geometry.hpp"
+#include "spatial_index.hpp"
+
+namespace utils::mon {
+struct Monitor {
+    uint64_t key = 0;
+    geom::Rect bounds{}; // rcMonitor, what neighbours are computed on
+    geom::Rect work{};   // rcWork
+    uint32_t dpi = 96;
+    uint32_t refreshHz = 60;
+};
+
+inline constexpr int32_t kNoMonitor = -1;
+
+struct Topology {
+    std::vector<Monitor> monitors;
+    std::vector<std::array<int32_t, 4>> neighbours; // per monitor, indexed by spatial::Dir
+
+    int32_t Find(uint64_t key) const noexcept {
+        for (size_t i = 0; i < monitors.size(); ++i)
+            if (monitors[i].key == key)
+                return static_cast<int32_t>(i);
+        return kNoMonitor;
+    }
+
+    const Monitor* Neighbour(uint64_t key, spatial::Dir dir) const noexcept {
+        const int32_t i = Find(key);
+        if (i == kNoMonitor)
+            return nullptr;
+        const int32_t n = neighbours[i][static_cast<size_t>(dir)];
+        return n == kNoMonitor ? nullptr : &monitors[n];
+    }
+};
+
+namespace detail {
+struct Edge {
+    int64_t gap;     // from a's edge to b's near edge, along dir
+    int64_t overlap; // shared span across dir
+    int64_t offset;  // perpendicular distance when the spans do not overlap
+};
+
+constexpr Edge Measure(const geom::Rect& a, const geom::Rect& b, spatial::Dir dir) noexcept {
+    const bool horizontal = dir == spatial::Dir::Left || dir == spatial::Dir::Right;
+    Edge e{};
+    switch (dir) {
+        case spatial::Dir::Left: e.gap = int64_t{a.left} - b.right; break;
+        case spatial::Dir::Right: e.gap = int64_t{b.left} - a.right; break;
+        case spatial::Dir::Up: e.gap = int64_t{a.top} - b.bottom; break;
+        case spatial::Dir::Down: e.gap = int64_t{b.top} - a.bottom; break;
+    }
+    const int64_t lo = horizontal ? std::max(a.top, b.top) : std::max(a.left, b.left);
+    const int64_t hi = horizontal ? std::min(a.bottom, b.bottom) : std::min(a.right, b.right);
+    e.overlap = hi - lo;
+    e.offset = e.overlap < 0 ? -e.overlap : 0;
+    return e;
+}
+} // namespace detail
+
+inline Topology BuildTopology(std::vector<Monitor> monitors, int32_t tolerance = 8) {
+    Topology t;
+    t.monitors = std::move(monitors);
+    t.neighbours.assign(t.monitors.size(), {kNoMonitor, kNoMonitor, kNoMonitor, kNoMonitor});
+
+    for (size_t i = 0; i < t.monitors.size(); ++i) {
+        for (size_t d = 0; d < 4; ++d) {
+            const auto dir = static_cast<spatial::Dir>(d);
+            int32_t edgeBest = kNoMonitor, cornerBest = kNoMonitor;
+            detail::Edge edge{}, corner{};
+
+            for (size_t j = 0; j < t.monitors.size(); ++j) {
+                if (j == i)
+                    continue;
+                const detail::Edge e = detail::Measure(t.monitors[i].bounds, t.monitors[j].bounds, dir);
+                if (e.gap < -tolerance)
+                    continue; // not past the edge (overlapping or behind)
+                const int64_t gap = e.gap < 0 ? 0 : e.gap;
+                if (e.overlap > tolerance) {
+                    const int64_t bestGap = edge.gap < 0 ? 0 : edge.gap;
+                    if (edgeBest == kNoMonitor || gap < bestGap || (gap == bestGap && e.overlap > edge.overlap)) {
+                        edgeBest = static_cast<int32_t>(j);
+                        edge = e;
+                    }
+                } else if (cornerBest == kNoMonitor || gap + e.offset < (corner.gap < 0 ? 0 : corner.gap) + corner.offset) {
+                    cornerBest = static_cast<int32_t>(j);
+                    corner = e;
+                }
+            }
+            t.neighbours[i][d] = edgeBest != kNoMonitor ? edgeBest : cornerBest;
+        }
+    }
+    return t;
+}
+} // namespace utils::mon
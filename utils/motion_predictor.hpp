@@ -0,0 +1,238 @@
+// helpers/motion_predictor.hpp
+#pragma once
+// Cursor extrapolation for the drag overlay.
+//  - SampleRing: timestamped cursor samples, one writer (the mouse hook), lock-free readers.
+//  - Predictor: alpha-beta filter over the samples, extrapolated to the expected present time.
+//    Every prediction is scored against the sample that later arrives for that time; the lead is
+//    scaled by how much better the prediction did than just using the last sample, so jittery
+//    or erratic motion falls back to no prediction.
+//  - Evaluate: offline run of the predictor over a recorded sample stream.
+// Portable (no Windows headers).
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace utils::motion {
+struct Sample {
+    uint64_t tNs = 0;
+    int32_t x = 0;
+    int32_t y = 0;
+};
+
+template <size_t N>
+class SampleRing {
+    static_assert((N & (N - 1)) == 0, "N must be power of 2");
+
+  public:
+    // Single writer
+    void Push(const Sample& s) noexcept {
+        const uint64_t i = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[i & (N - 1)];
+        slot.seq.store(2 * i + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.t.store(s.tNs, std::memory_order_relaxed);
+        slot.xy.store(static_cast<uint64_t>(static_cast<uint32_t>(s.x)) << 32 | static_cast<uint32_t>(s.y), std::memory_order_relaxed);
+        slot.seq.store(2 * i + 2, std::memory_order_release);
+        head.store(i + 1, std::memory_order_release);
+    }
+
+    uint64_t Head() const noexcept {
+        return head.load(std::memory_order_acquire);
+    }
+
+    // Calls fn for every sample pushed since `from` still in the ring (oldest first), returns the
+    // position to pass next time. Slots overwritten while being read are skipped.
+    template <typename Fn>
+    uint64_t ReadSince(uint64_t from, Fn&& fn) const {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        if (h - from > N - 1)
+            from = h - (N - 1);
+        for (uint64_t i = from; i < h; ++i) {
+            const Slot& slot = slots[i & (N - 1)];
+            const uint64_t s1 = slot.seq.load(std::memory_order_acquire);
+            const uint64_t t = slot.t.load(std::memory_order_relaxed);
+            const uint64_t xy = slot.xy.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (s1 != 2 * i + 2 || slot.seq.load(std::memory_order_relaxed) != s1)
+                continue;
+            fn(Sample{t, static_cast<int32_t>(xy >> 32), static_cast<int32_t>(xy & 0xffffffffu)});
+        }
+        return h;
+    }
+
+  private:
+    struct Slot {
+        std::atomic<uint64_t> seq{0}; // 2i+1 while writing sample i, 2i+2 once written
+        std::atomic<uint64_t> t{0};
+        std::atomic<uint64_t> xy{0};
+    };
+
+    Slot slots[N];
+    alignas(64) std::atomic<uint64_t> head{0};
+};
+
+struct PredictorConfig {
+    float alpha = 0.5f;                 // position correction
+    float beta = 0.1f;                  // velocity correction
+    uint64_t maxHorizonNs = 50'000'000; // never extrapolate further than this
+    uint64_t resetGapNs = 100'000'000;  // a pause this long restarts the filter
+    float maxLeadPx = 96.f;             // cap on the applied offset
+    float errAlpha = 0.05f;             // EWMA weight for the error scores
+};
+
+class Predictor {
+  public:
+    struct Point {
+        float x, y;
+    };
+
+    explicit Predictor(const PredictorConfig& c = {}) noexcept : cfg(c) {}
+
+    void Update(const Sample& s) noexcept {
+        Score(s);
+        lastX = static_cast<float>(s.x);
+        lastY = static_cast<float>(s.y);
+
+        if (!init || s.tNs - t > cfg.resetGapNs || s.tNs < t) {
+            x = lastX;
+            y = lastY;
+            vx = vy = 0.f;
+            t = s.tNs;
+            init = true;
+            return;
+        }
+
+        const float dt = static_cast<float>(s.tNs - t) * 1e-9f;
+        if (dt <= 0.f) {
+            x = lastX;
+            y = lastY;
+            return;
+        }
+
+        const float px = x + vx * dt;
+        const float py = y + vy * dt;
+        const float rx = lastX - px;
+        const float ry = lastY - py;
+        x = px + cfg.alpha * rx;
+        y = py + cfg.alpha * ry;
+        vx += cfg.beta * rx / dt;
+        vy += cfg.beta * ry / dt;
+        t = s.tNs;
+    }
+
+    // Cursor position expected at targetNs; the last sample when there is nothing to gain
+    Point Predict(uint64_t targetNs) noexcept {
+        if (!init)
+            return {lastX, lastY};
+
+        const uint64_t h = std::min(targetNs > t ? targetNs - t : 0, cfg.maxHorizonNs);
+        const float hs = static_cast<float>(h) * 1e-9f;
+        const float rawX = x + vx * hs;
+        const float rawY = y + vy * hs;
+
+        // scored against the first sample at or after the target time
+        if (!pending && h > 0) {
+            pending = true;
+            pendingT = t + h;
+            predX = rawX;
+            predY = rawY;
+            baseX = lastX;
+            baseY = lastY;
+        }
+
+        float ox = (rawX - lastX) * Gain();
+        float oy = (rawY - lastY) * Gain();
+        const float len = std::sqrt(ox * ox + oy * oy);
+        if (len > cfg.maxLeadPx) {
+            ox *= cfg.maxLeadPx / len;
+            oy *= cfg.maxLeadPx / len;
+        }
+        return {lastX + ox, lastY + oy};
+    }
+
+    // 0..1: 1 - predicted error / error without prediction
+    float Gain() const noexcept {
+        if (errNone <= 0.f)
+            return 0.f;
+        return std::clamp(1.f - errPredicted / errNone, 0.f, 1.f);
+    }
+
+    float ErrorPredicted() const noexcept { return errPredicted; }
+    float ErrorNone() const noexcept { return errNone; }
+
+  private:
+    void Score(const Sample& s) noexcept {
+        if (!pending || s.tNs < pendingT)
+            return;
+        pending = false;
+        const float ep = std::hypot(predX - s.x, predY - s.y);
+        const float en = std::hypot(baseX - s.x, baseY - s.y);
+        errPredicted += cfg.errAlpha * (ep - errPredicted);
+        errNone += cfg.errAlpha * (en - errNone);
+    }
+
+    PredictorConfig cfg;
+    bool init = false;
+    uint64_t t = 0;
+    float x = 0.f, y = 0.f, vx = 0.f, vy = 0.f;
+    float lastX = 0.f, lastY = 0.f;
+
+    bool pending = false;
+    uint64_t pendingT = 0;
+    float predX = 0.f, predY = 0.f, baseX = 0.f, baseY = 0.f;
+    float errPredicted = 0.f;
+    float errNone = 0.f;
+};
+
+struct Evaluation {
+    uint64_t predictions = 0;
+    double meanErrorPx = 0.0;     // |predicted - actual| at the horizon
+    double meanErrorNonePx = 0.0; // |last sample - actual|: what the overlay shows without prediction
+    double meanLeadPx = 0.0;      // average applied offset
+};
+
+// Predicts horizonNs ahead after every sample and compares with the cursor actually reached then
+// (linear between the surrounding samples). Samples must be in time order.
+inline Evaluation Evaluate(const Sample* samples, size_t count, uint64_t horizonNs, const PredictorConfig& cfg = {}) {
+    Evaluation ev{};
+    Predictor p(cfg);
+    size_t j = 0;
+    double err = 0.0, errNone = 0.0, lead = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        const Sample& s = samples[i];
+        p.Update(s);
+        const uint64_t target = s.tNs + horizonNs;
+
+        if (j < i + 1)
+            j = i + 1;
+        while (j < count && samples[j].tNs < target)
+            ++j;
+        if (j >= count)
+            break;
+        const Sample& a = samples[j - 1];
+        const Sample& b = samples[j];
+        if (b.tNs - a.tNs > cfg.resetGapNs)
+            continue; // cursor was idle, nothing to predict
+
+        const double f = b.tNs > a.tNs ? static_cast<double>(target - std::min(target, a.tNs)) / (b.tNs - a.tNs) : 1.0;
+        const double ax = a.x + (b.x - a.x) * std::min(f, 1.0);
+        const double ay = a.y + (b.y - a.y) * std::min(f, 1.0);
+
+        const Predictor::Point q = p.Predict(target);
+        err += std::hypot(q.x - ax, q.y - ay);
+        errNone += std::hypot(s.x - ax, s.y - ay);
+        lead += std::hypot(q.x - s.x, q.y - s.y);
+        ++ev.predictions;
+    }
+    if (ev.predictions) {
+        ev.meanErrorPx = err / ev.predictions;
+        ev.meanErrorNonePx = errNone / ev.predictions;
+        ev.meanLeadPx = lead / ev.predictions;
+    }
+    return ev;
+}
+
+using CursorRing = SampleRing<64>;
+} // namespace utils::motion
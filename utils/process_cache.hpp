@@ -0,0 +1,135 @@
+// helpers/process_cache.hpp
+#pragma once
+// Process image names by (pid, creation time).
+//  - NameTable: interned, case-folded image names. Equal names get equal ids, so a check like
+//    "is this cs2.exe" is an integer compare; Find folds into a stack buffer and never allocates.
+//  - NameCache: bounded 4-way set-associative map (pid, creation time) -> name id. The creation
+//    time is part of the key, so a reused pid misses instead of returning the old process's name.
+// Folding is ASCII-only; image names that differ only in non-ASCII case intern separately.
+// Portable (no Windows headers).
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace utils::proc {
+using NameId = uint32_t;
+inline constexpr NameId kNoName = 0;
+
+class NameTable {
+  public:
+    static constexpr size_t kMaxLength = 260;
+
+    NameId Intern(std::wstring_view name) {
+        Folded f(name);
+        if (auto it = ids.find(f.View()); it != ids.end())
+            return it->second;
+        const std::wstring& stored = names.emplace_back(f.View());
+        const NameId id = static_cast<NameId>(names.size());
+        ids.emplace(stored, id);
+        return id;
+    }
+
+    // kNoName if the name was never interned
+    NameId Find(std::wstring_view name) const {
+        Folded f(name);
+        auto it = ids.find(f.View());
+        return it == ids.end() ? kNoName : it->second;
+    }
+
+    std::wstring_view Name(NameId id) const {
+        return id == kNoName || id > names.size() ? std::wstring_view{} : std::wstring_view{names[id - 1]};
+    }
+
+  private:
+    struct Folded {
+        explicit Folded(std::wstring_view s) : length(s.size() < kMaxLength ? s.size() : kMaxLength) {
+            for (size_t i = 0; i < length; ++i) {
+                const wchar_t c = s[i];
+                buf[i] = (c >= L'A' && c <= L'Z') ? static_cast<wchar_t>(c - L'A' + L'a') : c;
+            }
+        }
+        std::wstring_view View() const { return {buf.data(), length}; }
+
+        std::array<wchar_t, kMaxLength> buf;
+        size_t length;
+    };
+
+    std::deque<std::wstring> names; // stable storage, ids are 1-based indices
+    std::unordered_map<std::wstring_view, NameId> ids;
+};
+
+struct CacheStats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t stale = 0;     // pid found with another creation time (pid reuse)
+    uint64_t evictions = 0;
+};
+
+template <size_t Sets = 128, size_t Ways = 4>
+class NameCache {
+    static_assert((Sets & (Sets - 1)) == 0, "Sets must be power of 2");
+
+  public:
+    // kNoName on a miss
+    NameId Lookup(uint32_t pid, uint64_t startTime) {
+        Entry* set = SetFor(pid);
+        for (size_t w = 0; w < Ways; ++w) {
+            Entry& e = set[w];
+            if (e.name == kNoName || e.pid != pid)
+                continue;
+            if (e.startTime != startTime) {
+                e.name = kNoName;
+                ++stats.stale;
+                break;
+            }
+            e.used = ++tick;
+            ++stats.hits;
+            return e.name;
+        }
+        ++stats.misses;
+        return kNoName;
+    }
+
+    void Insert(uint32_t pid, uint64_t startTime, NameId name) {
+        Entry* set = SetFor(pid);
+        Entry* victim = &set[0];
+        for (size_t w = 0; w < Ways; ++w) {
+            Entry& e = set[w];
+            if (e.name == kNoName || (e.pid == pid && e.startTime == startTime)) {
+                victim = &e;
+                break;
+            }
+            if (e.used < victim->used)
+                victim = &e;
+        }
+        if (victim->name != kNoName && (victim->pid != pid || victim->startTime != startTime))
+            ++stats.evictions;
+        *victim = {pid, startTime, name, ++tick};
+    }
+
+    const CacheStats& Stats() const noexcept { return stats; }
+    static constexpr size_t Capacity() noexcept { return Sets * Ways; }
+
+  private:
+    struct Entry {
+        uint32_t pid = 0;
+        uint64_t startTime = 0;
+        NameId name = kNoName;
+        uint64_t used = 0;
+    };
+
+    Entry* SetFor(uint32_t pid) noexcept {
+        // pids are multiples of 4 on Windows
+        const uint32_t h = (pid >> 2) * 0x9E3779B1u;
+        return &entries[(h >> 16) & (Sets - 1)][0];
+    }
+
+    Entry entries[Sets][Ways]{};
+    uint64_t tick = 0;
+    CacheStats stats{};
+};
+} // namespace utils::proc
@@ -0,0 +1,84 @@
+// helpers/render_stats.hpp
+#pragma once
+// Overlay render counters, relaxed atomics only. Written by the overlay thread, read by the dump.
+// Portable (no Windows headers).
+#include <atomic>
+#include <cstdint>
+#if __has_include(<format>)
+#include <format>
+#endif
+#include <string>
+
+#include "latency.hpp"
+
+namespace utils::render {
+struct Counters {
+    std::atomic<uint64_t> brushCreates{0};    // D2D brushes and gradient stop collections created
+    std::atomic<uint64_t> frames{0};          // frames paced by the overlay loop
+    std::atomic<uint64_t> missedFrames{0};    // frames that overran their slot
+    std::atomic<uint64_t> idleFrames{0};      // frames paced at the idle cap
+    std::atomic<uint64_t> framesDrawn{0};     // loop iterations that redrew the border
+    std::atomic<uint64_t> framesSkipped{0};   // loop iterations with no damage
+    std::atomic<uint64_t> rasterPixels{0};    // pixels written by the software backend
+    std::atomic<uint64_t> geometryCommits{0}; // SetWindowPos calls from SetGeometry
+    std::atomic<uint64_t> liveApplies{0};     // live resize updates sent to the target window
+    std::atomic<uint64_t> borderFrames{0};    // batched persistent border updates
+    std::atomic<uint64_t> borderCreates{0};   // border surfaces created
+    std::atomic<uint64_t> borderReuses{0};    // parked border surfaces handed to another window
+    std::atomic<uint64_t> borderPlaces{0};    // border surfaces moved, resized or recoloured
+    std::atomic<uint64_t> borderRestacks{0};  // unchanged borders put back above their window
+    latency::Histogram liveTurnaround{};      // target SetWindowPos turnaround, ns
+    latency::Histogram frameTimes{};          // frame start -> next frame start, ns
+};
+
+inline Counters g_counters{};
+
+inline void Count(std::atomic<uint64_t>& c, uint64_t n = 1) noexcept {
+    c.fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void ResetAll() noexcept {
+    g_counters.brushCreates.store(0, std::memory_order_relaxed);
+    g_counters.frames.store(0, std::memory_order_relaxed);
+    g_counters.missedFrames.store(0, std::memory_order_relaxed);
+    g_counters.idleFrames.store(0, std::memory_order_relaxed);
+    g_counters.framesDrawn.store(0, std::memory_order_relaxed);
+    g_counters.framesSkipped.store(0, std::memory_order_relaxed);
+    g_counters.rasterPixels.store(0, std::memory_order_relaxed);
+    g_counters.geometryCommits.store(0, std::memory_order_relaxed);
+    g_counters.liveApplies.store(0, std::memory_order_relaxed);
+    g_counters.borderFrames.store(0, std::memory_order_relaxed);
+    g_counters.borderCreates.store(0, std::memory_order_relaxed);
+    g_counters.borderReuses.store(0, std::memory_order_relaxed);
+    g_counters.borderPlaces.store(0, std::memory_order_relaxed);
+    g_counters.borderRestacks.store(0, std::memory_order_relaxed);
+    g_counters.frameTimes.Reset();
+    g_counters.liveTurnaround.Reset();
+}
+
+#if __has_include(<format>)
+inline std::string Report() {
+    const latency::Histogram::Snapshot ft = g_counters.frameTimes.Snap();
+    const latency::Histogram::Snapshot lt = g_counters.liveTurnaround.Snap();
+    std::string out = std::format("{:<16}{:>10}\n", "brush.creates", g_counters.brushCreates.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "frames", g_counters.frames.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "frames.missed", g_counters.missedFrames.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "frames.idle", g_counters.idleFrames.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "frames.drawn", g_counters.framesDrawn.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "frames.skipped", g_counters.framesSkipped.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "raster.pixels", g_counters.rasterPixels.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "geometry.commits", g_counters.geometryCommits.load(std::memory_order_relaxed));
+    out += std::format(
+      "{:<16}{:>10}{:>12.2f}{:>12.2f}{:>12.2f}{:>12.2f}\n", "frame.time", ft.count, ft.p50 / 1000.0, ft.p99 / 1000.0, ft.p999 / 1000.0, ft.max / 1000.0);
+    out += std::format("{:<16}{:>10}\n", "live.applies", g_counters.liveApplies.load(std::memory_order_relaxed));
+    out += std::format(
+      "{:<16}{:>10}{:>12.2f}{:>12.2f}{:>12.2f}{:>12.2f}\n", "live.turnaround", lt.count, lt.p50 / 1000.0, lt.p99 / 1000.0, lt.p999 / 1000.0, lt.max / 1000.0);
+    out += std::format("{:<16}{:>10}\n", "border.frames", g_counters.borderFrames.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "border.creates", g_counters.borderCreates.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "border.reuses", g_counters.borderReuses.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "border.places", g_counters.borderPlaces.load(std::memory_order_relaxed));
+    out += std::format("{:<16}{:>10}\n", "border.restacks", g_counters.borderRestacks.load(std::memory_order_relaxed));
+    return out;
+}
+#endif
+} // namespace utils::render
@@ -0,0 +1,159 @@
+// helpers/spatial_index.hpp
+#pragma once
+// Uniform grid over screen rects for point queries.
+// The grid covers a fixed world rect (the virtual screen) in square cells; every item is listed in
+// each cell its rect touches, coordinates outside the world clamp to the border cells. Each cell is
+// kept sorted by rank (z position, top first) so a point query stops at the first hit like the
+// z-order walk does, over the few windows in one cell instead of all of them.
+// Items are caller-owned small ids: the grid stores ranks but no rects, so the caller passes the
+// old rect to Update/Erase and checks containment itself. Moving within the same cells costs
+// nothing. Copying a grid of the same dimensions reuses the cell storage.
+// Rect overlap and nearest-in-direction stay z-order walks (Intersects, Score): windows span many
+// cells, so visiting cells re-checks the same windows and measured slower than the walk
+// (tests/window_registry_bench.cpp).
+// Portable (no Windows headers).
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "drag_geometry.hpp"
+
+namespace utils::spatial {
+enum class Dir : uint8_t { Left, Right, Up, Down };
+
+class Grid {
+  public:
+    static constexpr int32_t kDefaultCell = 256;
+
+    // Drops every item; re-insert after a world change
+    void Reset(const geom::Rect& w, int32_t cellSize = kDefaultCell) {
+        world = w;
+        cell = cellSize > 0 ? cellSize : kDefaultCell;
+        cols = std::max<int32_t>(1, (w.Width() + cell - 1) / cell);
+        rows = std::max<int32_t>(1, (w.Height() + cell - 1) / cell);
+        cells.assign(static_cast<size_t>(cols) * rows, {});
+    }
+
+    uint32_t Rank(uint32_t id) const noexcept { return ranks[id]; }
+
+    // Cells stay sorted only while the relative order of ids is unchanged (a window added on top
+    // or removed shifts everyone by one); call Resort after a real restack.
+    void SetRank(uint32_t id, uint32_t rank) {
+        if (id >= ranks.size())
+            ranks.resize(id + 1, 0);
+        ranks[id] = rank;
+    }
+
+    void Resort() {
+        for (std::vector<uint32_t>& c : cells)
+            std::sort(c.begin(), c.end(), [this](uint32_t a, uint32_t b) { return ranks[a] < ranks[b]; });
+    }
+
+    const geom::Rect& World() const noexcept { return world; }
+
+    void Insert(uint32_t id, const geom::Rect& r, uint32_t rank) {
+        SetRank(id, rank);
+        Place(id, r);
+    }
+
+    void Erase(uint32_t id, const geom::Rect& r) {
+        const Span s = SpanOf(r);
+        for (int32_t y = s.r0; y <= s.r1; ++y)
+            for (int32_t x = s.c0; x <= s.c1; ++x) {
+                std::vector<uint32_t>& c = Cell(x, y);
+                if (auto it = std::find(c.begin(), c.end(), id); it != c.end())
+                    c.erase(it);
+            }
+    }
+
+    void Update(uint32_t id, const geom::Rect& from, const geom::Rect& to) {
+        if (SpanOf(from) == SpanOf(to))
+            return;
+        Erase(id, from);
+        Place(id, to);
+    }
+
+    // Every id whose rect may contain p, top first; check containment against the real rect
+    std::span<const uint32_t> At(geom::Point p) const {
+        return cells[Index(Col(p.x), Row(p.y))];
+    }
+
+    // Empty rects intersect nothing
+    static constexpr bool Intersects(const geom::Rect& a, const geom::Rect& b) noexcept {
+        return a.left < a.right && a.top < a.bottom && b.left < b.right && b.top < b.bottom && a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+    }
+
+    // Distance from `from` to r in dir: gap along dir + 2x the perpendicular gap; r counts as in dir
+    // when its centre is past from's centre and its near edge past from's opposite edge. < 0: not in dir
+    static constexpr int64_t Score(const geom::Rect& from, const geom::Rect& r, Dir dir) noexcept {
+        int64_t along = 0, perp = 0;
+        switch (dir) {
+            case Dir::Left:
+                if (r.left + r.right >= from.left + from.right || r.left >= from.left)
+                    return -1;
+                along = from.left - r.right;
+                break;
+            case Dir::Right:
+                if (r.left + r.right <= from.left + from.right || r.right <= from.right)
+                    return -1;
+                along = r.left - from.right;
+                break;
+            case Dir::Up:
+                if (r.top + r.bottom >= from.top + from.bottom || r.top >= from.top)
+                    return -1;
+                along = from.top - r.bottom;
+                break;
+            case Dir::Down:
+                if (r.top + r.bottom <= from.top + from.bottom || r.bottom <= from.bottom)
+                    return -1;
+                along = r.top - from.bottom;
+                break;
+        }
+        if (dir == Dir::Left || dir == Dir::Right)
+            perp = std::max<int64_t>({0, static_cast<int64_t>(r.top) - from.bottom, static_cast<int64_t>(from.top) - r.bottom});
+        else
+            perp = std::max<int64_t>({0, static_cast<int64_t>(r.left) - from.right, static_cast<int64_t>(from.left) - r.right});
+        return std::max<int64_t>(0, along) + 2 * perp;
+    }
+
+  private:
+    struct Span {
+        int32_t c0, r0, c1, r1;
+        constexpr bool operator==(const Span&) const = default;
+    };
+
+    int32_t Col(int32_t x) const noexcept {
+        const int64_t c = (static_cast<int64_t>(x) - world.left) / cell;
+        return static_cast<int32_t>(std::clamp<int64_t>(x < world.left ? 0 : c, 0, cols - 1));
+    }
+    int32_t Row(int32_t y) const noexcept {
+        const int64_t r = (static_cast<int64_t>(y) - world.top) / cell;
+        return static_cast<int32_t>(std::clamp<int64_t>(y < world.top ? 0 : r, 0, rows - 1));
+    }
+    Span SpanOf(const geom::Rect& r) const noexcept {
+        // right/bottom are exclusive; an empty rect still lands in the cell of its corner
+        return {Col(r.left), Row(r.top), Col(std::max(r.left, r.right - 1)), Row(std::max(r.top, r.bottom - 1))};
+    }
+    size_t Index(int32_t c, int32_t r) const noexcept { return static_cast<size_t>(r) * cols + c; }
+    std::vector<uint32_t>& Cell(int32_t c, int32_t r) { return cells[Index(c, r)]; }
+
+    void Place(uint32_t id, const geom::Rect& r) {
+        const Span s = SpanOf(r);
+        const auto byRank = [this](uint32_t a, uint32_t b) { return ranks[a] < ranks[b]; };
+        for (int32_t y = s.r0; y <= s.r1; ++y)
+            for (int32_t x = s.c0; x <= s.c1; ++x) {
+                std::vector<uint32_t>& c = Cell(x, y);
+                c.insert(std::upper_bound(c.begin(), c.end(), id, byRank), id);
+            }
+    }
+
+    geom::Rect world{0, 0, 0, 0};
+    int32_t cell = kDefaultCell;
+    int32_t cols = 1;
+    int32_t rows = 1;
+    std::vector<std::vector<uint32_t>> cells = std::vector<std::vector<uint32_t>>(1);
+    std::vector<uint32_t> ranks; // by id
+};
+} // namespace utils::spatial
@@ -0,0 +1,132 @@
+// helpers/surface_pool.hpp
+#pragma once
+// Reusable border surfaces for persistent window borders.
+// Each frame the caller hands the full set of placements (target key, bounds, active); the pool
+// diffs it against the previous frame:
+//  - a target that keeps its surface is only touched when its bounds or active state changed,
+//    or restacked when the caller reports a z-order change (Placement says nothing about z-order)
+//  - a new target takes a parked surface before a new one is created
+//  - surfaces whose target went away are parked (hidden), not destroyed, up to maxParked
+// A focus change between two windows is then two Place calls and no window creation.
+// Surface is any type with Place(const Placement&), Restack(const Placement&) and Park(); the pool
+// never touches the OS.
+// Portable (no Windows headers).
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "drag_geometry.hpp"
+
+namespace utils::pool {
+struct Placement {
+    uint64_t key = 0; // target window
+    geom::Rect bounds{};
+    bool active = false;
+
+    bool operator==(const Placement&) const = default;
+};
+
+struct ChurnStats {
+    uint64_t frames = 0;
+    uint64_t created = 0;   // factory calls
+    uint64_t reused = 0;    // parked surface handed to a new target
+    uint64_t parked = 0;    // surface whose target left the set
+    uint64_t destroyed = 0; // parked beyond maxParked
+    uint64_t placed = 0;    // Place calls (changed placements only)
+    uint64_t restacked = 0; // Restack calls (unchanged placements in a restack frame)
+};
+
+template <typename Surface>
+class SurfacePool {
+  public:
+    using Factory = std::function<std::unique_ptr<Surface>()>;
+
+    explicit SurfacePool(Factory f, size_t maxParked = 8) : factory(std::move(f)), maxParked(maxParked) {}
+
+    // One batched frame: placements is the complete set for this frame, keys unique.
+    // Targets that left are parked before new ones are bound, so a focus change reuses the surface.
+    // restack: windows changed z-order, every unchanged surface is restacked above its target.
+    void Apply(std::span<const Placement> placements, bool restack = false) {
+        ++stats.frames;
+        ++frameId;
+
+        fresh.clear();
+        for (const Placement& p : placements) {
+            auto it = bound.find(p.key);
+            if (it == bound.end()) {
+                fresh.push_back(&p);
+                continue;
+            }
+            Entry& e = it->second;
+            e.seen = frameId;
+            if (e.last != p) {
+                e.last = p;
+                e.surface->Place(p);
+                ++stats.placed;
+            } else if (restack) {
+                e.surface->Restack(p);
+                ++stats.restacked;
+            }
+        }
+
+        for (auto it = bound.begin(); it != bound.end();) {
+            if (it->second.seen == frameId) {
+                ++it;
+                continue;
+            }
+            it->second.surface->Park();
+            ++stats.parked;
+            if (parked.size() < maxParked)
+                parked.push_back(std::move(it->second.surface));
+            else
+                ++stats.destroyed;
+            it = bound.erase(it);
+        }
+
+        for (const Placement* p : fresh) {
+            std::unique_ptr<Surface> s;
+            if (!parked.empty()) {
+                s = std::move(parked.back());
+                parked.pop_back();
+                ++stats.reused;
+            } else {
+                s = factory();
+                if (!s)
+                    continue;
+                ++stats.created;
+            }
+            s->Place(*p);
+            ++stats.placed;
+            bound.emplace(p->key, Entry{std::move(s), *p, frameId});
+        }
+    }
+
+    // Parks everything (e.g. borders switched off); the surfaces stay for the next Apply
+    void Clear() {
+        Apply({});
+    }
+
+    size_t Bound() const noexcept { return bound.size(); }
+    size_t Parked() const noexcept { return parked.size(); }
+    const ChurnStats& Stats() const noexcept { return stats; }
+
+  private:
+    struct Entry {
+        std::unique_ptr<Surface> surface;
+        Placement last{};
+        uint64_t seen = 0;
+    };
+
+    Factory factory;
+    size_t maxParked;
+    uint64_t frameId = 0;
+    std::unordered_map<uint64_t, Entry> bound;
+    std::vector<std::unique_ptr<Surface>> parked;
+    std::vector<const Placement*> fresh; // scratch, kept for its capacity
+    ChurnStats stats{};
+};
+} // namespace utils::pool
@@ -4,6 +4,7 @@
 
 #include "utils/dwm.hpp"
 #include "utils/mon.hpp"
+#include "utils/window_tracker.hpp"
 
 #include <dwmapi.h>
 #pragma comment(lib, "Dwmapi.lib")
@@ -16,7 +17,7 @@
 
 namespace utils {
 // -------- Window discovery --------
-static bool IsShellProtected(HWND h) {
+bool IsShellProtected(HWND h) {
     if (!h)
         return false;
 
@@ -169,6 +170,9 @@ static HWND HitTestZOrder(HWND startTop, const POINT& pt, MapToRootFn mapToRoot)
 
 // Permissive: any top-level that visually contains the point.
 HWND GetWindow(const POINT& pt) {
+    if (HWND cached; wnd::Tracker::WindowAt(pt, cached))
+        return cached;
+
     HWND hit = WindowFromPoint(pt);
     if (!hit)
         return nullptr;
@@ -196,6 +200,9 @@ HWND GetWindow(const POINT& pt) {
 
 // Strict/filtered: obeys your previous filtering rules.
 HWND GetFilteredWindow(const POINT& pt) {
+    if (HWND cached; wnd::Tracker::FilteredWindowAt(pt, cached))
+        return cached;
+
     HWND hit = WindowFromPoint(pt);
     if (!hit)
         return nullptr;
@@ -223,24 +230,172 @@ HWND GetFilteredWindow() {
     return GetFilteredWindow(pt);
 }
 
-std::wstring GetProcessName(HWND hwnd) {
+// -------- Process names --------
+
+namespace {
+struct ProcessNames {
+    std::mutex lock;
+    proc::NameTable table;
+    proc::NameCache<> cache;
+};
+
+ProcessNames& Names() {
+    static ProcessNames names;
+    return names;
+}
+} // namespace
+
+proc::NameId GetProcessNameId(HWND hwnd) {
     DWORD pid = 0;
     if (!GetWindowThreadProcessId(hwnd, &pid) || !pid)
-        return {};
+        return proc::kNoName;
 
     HANDLE hProc = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
     if (!hProc)
-        return {};
+        return proc::kNoName;
+
+    proc::NameId id = proc::kNoName;
+    FILETIME created{}, exited{}, kernel{}, user{};
+    if (GetProcessTimes(hProc, &created, &exited, &kernel, &user)) {
+        const uint64_t start = (static_cast<uint64_t>(created.dwHighDateTime) << 32) | created.dwLowDateTime;
+        ProcessNames& names = Names();
+        {
+            std::scoped_lock lock(names.lock);
+            id = names.cache.Lookup(pid, start);
+        }
 
-    wchar_t path[MAX_PATH] = {};
-    DWORD size = MAX_PATH;
-    std::wstring result;
-    if (QueryFullProcessImageNameW(hProc, 0, path, &size)) {
-        const wchar_t* fname = wcsrchr(path, L'\\');
-        result = fname ? fname + 1 : path;
+        wchar_t path[MAX_PATH] = {};
+        DWORD size = MAX_PATH;
+        if (id == proc::kNoName && QueryFullProcessImageNameW(hProc, 0, path, &size)) {
+            const wchar_t* fname = wcsrchr(path, L'\\');
+            std::scoped_lock lock(names.lock);
+            id = names.table.Intern(fname ? fname + 1 : path);
+            names.cache.Insert(pid, start, id);
+        }
     }
     CloseHandle(hProc);
-    return result;
+    return id;
+}
+
+std::wstring GetProcessName(HWND hwnd) {
+    const proc::NameId id = GetProcessNameId(hwnd);
+    ProcessNames& names = Names();
+    std::scoped_lock lock(names.lock);
+    return std::wstring(names.table.Name(id));
+}
+
+proc::CacheStats GetProcessCacheStats() {
+    ProcessNames& names = Names();
+    std::scoped_lock lock(names.lock);
+    return names.cache.Stats();
+}
+
+// -------- Window rules --------
+
+namespace {
+struct RuleMemo {
+    uint64_t ruleSet = 0;
+    proc::NameId exe = proc::kNoName;
+    uint64_t used = 0;       // last hit, for eviction
+    uint64_t generation = 0; // new tick on creation and ForgetRules: a match computed across it is not stored
+    bool stored = false;     // false while a match is in flight or after ForgetRules
+    rules::Result result;
+};
+
+struct RuleMemos {
+    static constexpr size_t kMax = 512;
+    std::mutex lock;
+    std::unordered_map<HWND, RuleMemo> byWindow;
+    uint64_t tick = 0;
+};
+
+RuleMemos& Memos() {
+    static RuleMemos memos;
+    return memos;
+}
+
+// Caller holds memos.lock
+RuleMemo& MemoFor(RuleMemos& memos, HWND hwnd) {
+    if (memos.byWindow.size() >= RuleMemos::kMax && !memos.byWindow.contains(hwnd)) {
+        auto oldest = memos.byWindow.begin();
+        for (auto it = memos.byWindow.begin(); it != memos.byWindow.end(); ++it)
+            if (it->second.used < oldest->second.used)
+                oldest = it;
+        memos.byWindow.erase(oldest);
+    }
+    auto [it, created] = memos.byWindow.try_emplace(hwnd);
+    it->second.used = ++memos.tick;
+    if (created)
+        it->second.generation = memos.tick; // never one an evicted entry for this hwnd had
+    return it->second;
+}
+} // namespace
+
+rules::Result MatchRules(const rules::RuleSet& ruleSet, HWND hwnd, proc::NameId* exe) {
+    if (!hwnd)
+        return {};
+
+    RuleMemos& memos = Memos();
+    uint64_t generation;
+    {
+        std::scoped_lock lock(memos.lock);
+        RuleMemo& memo = MemoFor(memos, hwnd);
+        if (memo.stored && memo.ruleSet == ruleSet.Id()) {
+            if (exe)
+                *exe = memo.exe;
+            return memo.result;
+        }
+        generation = memo.generation;
+    }
+
+    RuleMemo memo;
+    memo.ruleSet = ruleSet.Id();
+    if (!wnd::Tracker::ExeOf(hwnd, memo.exe))
+        memo.exe = GetProcessNameId(hwnd);
+    if (ruleSet.size() != 0) {
+        wchar_t cls[256] = {};
+        const int clsLen = GetClassNameW(hwnd, cls, static_cast<int>(std::size(cls)));
+        // the length may overestimate (mixed ANSI/Unicode windows), never underestimate
+        const int titleCap = GetWindowTextLengthW(hwnd);
+        std::wstring title(titleCap > 0 ? static_cast<size_t>(titleCap) + 1 : 1, L'\0');
+        const int titleLen = GetWindowTextW(hwnd, title.data(), static_cast<int>(title.size()));
+        title.resize(titleLen > 0 ? static_cast<size_t>(titleLen) : 0);
+        const uint32_t style = static_cast<uint32_t>(GetWindowLongPtrW(hwnd, GWL_STYLE));
+        const uint32_t exStyle = static_cast<uint32_t>(GetWindowLongPtrW(hwnd, GWL_EXSTYLE));
+
+        std::wstring name;
+        {
+            ProcessNames& names = Names();
+            std::scoped_lock lock(names.lock);
+            name = names.table.Name(memo.exe);
+        }
+        memo.result = ruleSet.Evaluate({name, {cls, static_cast<size_t>(clsLen)}, title, style, exStyle});
+    }
+    if (exe)
+        *exe = memo.exe;
+
+    // stored only if this window was not forgotten meanwhile; other windows' changes don't matter
+    std::scoped_lock lock(memos.lock);
+    auto it = memos.byWindow.find(hwnd);
+    if (it == memos.byWindow.end() || it->second.generation != generation)
+        return memo.result;
+    RuleMemo& slot = it->second;
+    slot.ruleSet = memo.ruleSet;
+    slot.exe = memo.exe;
+    slot.result = memo.result;
+    slot.stored = true;
+    slot.used = ++memos.tick;
+    return memo.result;
+}
+
+void ForgetRules(HWND hwnd) {
+    RuleMemos& memos = Memos();
+    std::scoped_lock lock(memos.lock);
+    // kept as an unstored entry so a match in flight for this window sees the bump
+    if (auto it = memos.byWindow.find(hwnd); it != memos.byWindow.end()) {
+        it->second.stored = false;
+        it->second.generation = ++memos.tick;
+    }
 }
 
 // -------- Focus and elevation --------
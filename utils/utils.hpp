@@ -4,6 +4,8 @@
 
 #include "tinylog.hpp"
 #include "settings/parser.hpp"
+#include "utils/process_cache.hpp"
+#include <string_view>
 #include <avrt.h>
 #pragma comment(lib, "avrt.lib")
 
@@ -65,7 +67,11 @@ HWND TopLevel(HWND hwnd);
 // Returns nullptr if it does not pass filters.
 HWND FilteredTopLevel(HWND hwnd);
 
+// Desktop and wallpaper hosts (Progman, WorkerW, ...), never a target.
+bool IsShellProtected(HWND hwnd);
+
 // ---- Hit-testing using visual rects ----
+// On the window tracker's reader thread these read its snapshot (utils/window_tracker.hpp).
 // Permissive: any valid top-level whose visual rect contains the point.
 HWND GetWindow(const POINT& pt);
 
@@ -75,7 +81,20 @@ HWND GetFilteredWindow(const POINT& pt);
 // Convenience overloads that use the current cursor position.
 HWND GetWindow();
 HWND GetFilteredWindow();
+
+// ---- Process names ----
+// Image name of hwnd's process, case-folded ("cs2.exe"), cached by (pid, creation time):
+// a hit costs a limited process handle, no path query and no allocation.
+proc::NameId GetProcessNameId(HWND hwnd);
 std::wstring GetProcessName(HWND hwnd);
+proc::CacheStats GetProcessCacheStats();
+
+// ---- Window rules ----
+// [rules] actions for hwnd, and its image name id through exe. Memoised per window and rule set;
+// the window tracker drops a window's memo when it is destroyed, renamed or restyled, so a hit
+// costs no syscalls. The image name comes from the tracker when the window is already known.
+rules::Result MatchRules(const rules::RuleSet& ruleSet, HWND hwnd, proc::NameId* exe = nullptr);
+void ForgetRules(HWND hwnd);
 
 inline POINT Center(const RECT& r) {
     return POINT{(r.left + r.right) / 2, (r.top + r.bottom) / 2};
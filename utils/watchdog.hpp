@@ -0,0 +1,122 @@
+// helpers/watchdog.hpp
+#pragma once
+// Low-level hook health. Windows silently unhooks callbacks that overrun LowLevelHooksTimeout,
+// so each hook times itself (HookStats) and a watchdog compares that with an independent
+// activity probe (async key state, user input the cursor followed) to spot a hook that stopped
+// receiving input. Programs move the cursor too (SetCursorPos, ClipCursor) without any hook
+// event, so one probe hit proves nothing: only several consecutive checks with evidence and no
+// callback at all count as silence.
+// Portable (no Windows headers): the probes live in the managers.
+#include <atomic>
+#include <cstdint>
+
+#include "../inputEvent.hpp"
+
+namespace utils::watchdog {
+// Written by the hook thread only, read by the watchdog
+class HookStats {
+  public:
+    struct Snapshot {
+        uint64_t callbacks = 0;
+        uint64_t overBudget = 0;
+        uint64_t lastNs = 0;  // end of the most recent callback
+        uint64_t worstNs = 0; // longest callback since the last TakeWorst()
+    };
+
+    void Record(uint64_t startNs, uint64_t endNs, uint64_t budgetNs) noexcept {
+        const uint64_t dur = endNs - startNs;
+        callbacks.store(callbacks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (dur > budgetNs)
+            overBudget.store(overBudget.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (dur > worstNs.load(std::memory_order_relaxed))
+            worstNs.store(dur, std::memory_order_relaxed);
+        lastNs.store(endNs, std::memory_order_release);
+    }
+
+    Snapshot Snap() const noexcept {
+        return {callbacks.load(std::memory_order_relaxed),
+          overBudget.load(std::memory_order_relaxed),
+          lastNs.load(std::memory_order_acquire),
+          worstNs.load(std::memory_order_relaxed)};
+    }
+
+    // Watchdog side: report the worst case and start a new window
+    uint64_t TakeWorst() noexcept {
+        return worstNs.exchange(0, std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<uint64_t> callbacks{0};
+    std::atomic<uint64_t> overBudget{0};
+    std::atomic<uint64_t> lastNs{0};
+    std::atomic<uint64_t> worstNs{0};
+};
+
+// Times one callback, every return path included
+class HookScope {
+  public:
+    HookScope(HookStats& s, uint64_t startNs, uint64_t budgetNs) noexcept : stats(s), start(startNs), budget(budgetNs) {}
+    ~HookScope() {
+        stats.Record(start, input::NowNs(), budget);
+    }
+    HookScope(const HookScope&) = delete;
+    HookScope& operator=(const HookScope&) = delete;
+
+  private:
+    HookStats& stats;
+    uint64_t start;
+    uint64_t budget;
+};
+
+enum class Verdict : uint8_t {
+    Ok,
+    OverBudget, // callbacks overran the budget since the last check, Windows may drop the hook
+    Silent,     // the probe saw input the hook never did, the hook is gone
+};
+
+// Pure decision logic, driven by the watchdog thread (or a simulated hook source)
+class Watchdog {
+  public:
+    struct Limits {
+        uint64_t budgetNs = 2'000'000;    // per callback
+        uint64_t silenceNs = 500'000'000; // evidence without a callback for this long
+        uint32_t misses = 3;              // ... and over at least this many consecutive checks
+    };
+
+    Watchdog() noexcept = default;
+    explicit Watchdog(Limits l) noexcept : limits(l) {}
+
+    const Limits& GetLimits() const noexcept {
+        return limits;
+    }
+
+    // evidence: since the previous check the probe saw input the hook should have seen too
+    Verdict Check(const HookStats::Snapshot& s, bool evidence, uint64_t nowNs) noexcept {
+        const uint64_t over = s.overBudget - lastOverBudget;
+        lastOverBudget = s.overBudget;
+
+        if (s.callbacks != lastCallbacks) {
+            lastCallbacks = s.callbacks; // the hook is alive
+            misses = 0;
+        } else if (evidence) {
+            if (misses++ == 0)
+                firstMissNs = nowNs;
+        } else {
+            misses = 0; // a quiet check breaks the streak
+        }
+
+        if (misses >= limits.misses && nowNs - firstMissNs >= limits.silenceNs) {
+            misses = 0; // one incident per streak
+            return Verdict::Silent;
+        }
+        return over ? Verdict::OverBudget : Verdict::Ok;
+    }
+
+  private:
+    Limits limits{};
+    uint64_t lastOverBudget = 0;
+    uint64_t lastCallbacks = 0;
+    uint64_t firstMissNs = 0;
+    uint32_t misses = 0;
+};
+} // namespace utils::watchdog
@@ -0,0 +1,278 @@
+// helpers/window_registry.hpp
+#pragma once
+// In-process copy of the visible top-level windows, top of the z-order first.
+// The tracker thread keeps a Registry current from WinEvent notifications and publishes Snapshots;
+// hit-tests then run over a contiguous array instead of WindowFromPoint + GetParent/DWM queries
+// per window. HitFiltered/HitAny reproduce utils::GetFilteredWindow/GetWindow on that data; the
+// Snapshot overloads look only at the windows listed in the point's spatial::Grid cell.
+// Portable (no Windows headers): windows are opaque 64-bit keys, style bits are plain integers.
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "drag_geometry.hpp"
+#include "spatial_index.hpp"
+
+namespace utils::wnd {
+enum Flags : uint8_t {
+    Usable = 1 << 0,           // visible, not minimized, not cloaked: can be under the cursor
+    Filtered = 1 << 1,         // passes utils::FilteredTopLevel
+    ShellProtected = 1 << 2,   // desktop / wallpaper hosts
+    PointTransparent = 1 << 3, // skipped by WindowFromPoint (disabled, or layered + transparent)
+    Cloaked = 1 << 4,
+    Iconic = 1 << 5,
+};
+
+struct WindowInfo {
+    uint64_t key = 0;
+    geom::Rect window{}; // GetWindowRect, what WindowFromPoint hits
+    geom::Rect visual{}; // DWM extended frame bounds
+    uint32_t style = 0;
+    uint32_t exStyle = 0;
+    uint32_t pid = 0;
+    uint32_t exe = 0; // utils::proc::NameId of the image, looked up once per window
+    uint8_t flags = 0;
+    uint32_t slot = 0; // grid id, assigned by the Registry
+};
+
+// Window and visual rect together: what the grid indexes
+constexpr geom::Rect Bounds(const WindowInfo& w) noexcept {
+    return {std::min(w.window.left, w.visual.left), std::min(w.window.top, w.visual.top), std::max(w.window.right, w.visual.right),
+      std::max(w.window.bottom, w.visual.bottom)};
+}
+
+struct Snapshot {
+    std::vector<WindowInfo> z; // top first
+    spatial::Grid grid;        // slots over Bounds(), rank = index into z
+    uint64_t version = 0;
+};
+
+// Single writer
+class Registry {
+  public:
+    const WindowInfo* Find(uint64_t key) const {
+        auto it = index.find(key);
+        return it == index.end() ? nullptr : &z[it->second];
+    }
+
+    // Re-grids every window; call when the virtual screen changes
+    void SetWorld(const geom::Rect& world) {
+        grid.Reset(world);
+        for (size_t i = 0; i < z.size(); ++i)
+            grid.Insert(z[i].slot, Bounds(z[i]), static_cast<uint32_t>(i));
+        ++version;
+    }
+    const geom::Rect& World() const noexcept { return grid.World(); }
+
+    // Updates in place; a new window goes on top (where it appears until the next Restack)
+    void Upsert(const WindowInfo& w) {
+        if (auto it = index.find(w.key); it != index.end()) {
+            WindowInfo& cur = z[it->second];
+            grid.Update(cur.slot, Bounds(cur), Bounds(w));
+            const uint32_t slot = cur.slot;
+            cur = w;
+            cur.slot = slot;
+        } else {
+            WindowInfo& added = *z.insert(z.begin(), w);
+            added.slot = AllocSlot();
+            Reindex(1); // everything below shifts down, order kept
+            index[added.key] = 0;
+            grid.Insert(added.slot, Bounds(added), 0);
+        }
+        ++version;
+    }
+
+    void Remove(uint64_t key) {
+        auto it = index.find(key);
+        if (it == index.end())
+            return;
+        const size_t i = it->second;
+        index.erase(it);
+        Release(z[i]);
+        z.erase(z.begin() + static_cast<ptrdiff_t>(i));
+        Reindex(i);
+        ++version;
+    }
+
+    // New z-order, top first. Known keys are reordered, unlisted ones dropped, unknown ones ignored
+    // (Upsert them first).
+    void Restack(std::span<const uint64_t> topToBottom) {
+        scratch.clear();
+        scratch.reserve(topToBottom.size());
+        for (uint64_t key : topToBottom)
+            if (auto it = index.find(key); it != index.end()) {
+                scratch.push_back(z[it->second]);
+                index.erase(it); // also guards against a key listed twice
+            }
+        for (const auto& [key, i] : index)
+            Release(z[i]);
+        z.swap(scratch);
+        index.clear();
+        Reindex(0);
+        grid.Resort();
+        ++version;
+    }
+
+    std::span<const WindowInfo> Windows() const noexcept { return z; }
+    size_t Size() const noexcept { return z.size(); }
+    uint64_t Version() const noexcept { return version; }
+
+    // Reuses the snapshot's capacity
+    void CopyTo(Snapshot& s) const {
+        s.z.assign(z.begin(), z.end());
+        s.grid = grid;
+        s.version = version;
+    }
+
+  private:
+    void Reindex(size_t from) {
+        for (size_t i = from; i < z.size(); ++i) {
+            index[z[i].key] = static_cast<uint32_t>(i);
+            grid.SetRank(z[i].slot, static_cast<uint32_t>(i));
+        }
+    }
+
+    uint32_t AllocSlot() {
+        if (!freeSlots.empty()) {
+            const uint32_t slot = freeSlots.back();
+            freeSlots.pop_back();
+            return slot;
+        }
+        return nextSlot++;
+    }
+
+    void Release(const WindowInfo& w) {
+        grid.Erase(w.slot, Bounds(w));
+        freeSlots.push_back(w.slot);
+    }
+
+    std::vector<WindowInfo> z;
+    std::vector<WindowInfo> scratch;
+    std::unordered_map<uint64_t, uint32_t> index;
+    spatial::Grid grid;
+    std::vector<uint32_t> freeSlots;
+    uint32_t nextSlot = 0;
+    uint64_t version = 0;
+};
+
+namespace detail {
+constexpr bool Contains(const geom::Rect& r, geom::Point p) noexcept {
+    return p.x >= r.left && p.x < r.right && p.y >= r.top && p.y < r.bottom;
+}
+
+// WindowFromPoint on top-levels: the first hittable window rect containing p
+inline size_t PointOwner(std::span<const WindowInfo> z, geom::Point p) {
+    for (size_t i = 0; i < z.size(); ++i) {
+        const WindowInfo& w = z[i];
+        if ((w.flags & (Usable | PointTransparent)) == Usable && Contains(w.window, p))
+            return i;
+    }
+    return z.size();
+}
+
+// Below z[from], the first window passing `need`/`reject` whose visual rect contains p
+inline const WindowInfo* VisualBelow(std::span<const WindowInfo> z, size_t from, geom::Point p, uint8_t need, uint8_t reject) {
+    for (size_t i = from + 1; i < z.size(); ++i) {
+        const WindowInfo& w = z[i];
+        if ((w.flags & (need | reject)) == need && Contains(w.visual, p))
+            return &w;
+    }
+    return nullptr;
+}
+
+// PointOwner/VisualBelow over the grid cell of p: every window containing p is listed there, top first
+inline size_t PointOwner(const Snapshot& s, geom::Point p) {
+    for (uint32_t slot : s.grid.At(p)) {
+        const size_t i = s.grid.Rank(slot);
+        const WindowInfo& w = s.z[i];
+        if ((w.flags & (Usable | PointTransparent)) == Usable && Contains(w.window, p))
+            return i;
+    }
+    return s.z.size();
+}
+
+inline const WindowInfo* VisualBelow(const Snapshot& s, size_t from, geom::Point p, uint8_t need, uint8_t reject) {
+    for (uint32_t slot : s.grid.At(p)) {
+        const size_t i = s.grid.Rank(slot);
+        const WindowInfo& w = s.z[i];
+        if (i > from && (w.flags & (need | reject)) == need && Contains(w.visual, p))
+            return &w;
+    }
+    return nullptr;
+}
+} // namespace detail
+
+// utils::GetFilteredWindow: the window under p must itself pass the filter; the invisible resize
+// border (window rect outside the visual rect) falls through to the next filtered window below.
+inline const WindowInfo* HitFiltered(std::span<const WindowInfo> z, geom::Point p) {
+    const size_t i = detail::PointOwner(z, p);
+    if (i == z.size() || !(z[i].flags & Filtered))
+        return nullptr;
+    if (detail::Contains(z[i].visual, p))
+        return &z[i];
+    return detail::VisualBelow(z, i, p, Usable | Filtered, 0);
+}
+
+// utils::GetWindow: any usable top-level, looking past the desktop/shell windows
+inline const WindowInfo* HitAny(std::span<const WindowInfo> z, geom::Point p) {
+    const size_t i = detail::PointOwner(z, p);
+    if (i == z.size())
+        return nullptr;
+    if (!(z[i].flags & ShellProtected) && detail::Contains(z[i].visual, p))
+        return &z[i];
+    return detail::VisualBelow(z, i, p, Usable, ShellProtected);
+}
+
+inline const WindowInfo* HitFiltered(const Snapshot& s, geom::Point p) {
+    const size_t i = detail::PointOwner(s, p);
+    if (i == s.z.size() || !(s.z[i].flags & Filtered))
+        return nullptr;
+    if (detail::Contains(s.z[i].visual, p))
+        return &s.z[i];
+    return detail::VisualBelow(s, i, p, Usable | Filtered, 0);
+}
+
+inline const WindowInfo* HitAny(const Snapshot& s, geom::Point p) {
+    const size_t i = detail::PointOwner(s, p);
+    if (i == s.z.size())
+        return nullptr;
+    if (!(s.z[i].flags & ShellProtected) && detail::Contains(s.z[i].visual, p))
+        return &s.z[i];
+    return detail::VisualBelow(s, i, p, Usable, ShellProtected);
+}
+
+inline const WindowInfo* Find(const Snapshot& s, uint64_t key) {
+    for (const WindowInfo& w : s.z)
+        if (w.key == key)
+            return &w;
+    return nullptr;
+}
+
+// Windows whose visual rect intersects r and pass need/reject, top first
+inline void Overlapping(const Snapshot& s, const geom::Rect& r, uint8_t need, uint8_t reject, std::vector<const WindowInfo*>& out) {
+    out.clear();
+    for (const WindowInfo& w : s.z)
+        if ((w.flags & (need | reject)) == need && spatial::Grid::Intersects(w.visual, r))
+            out.push_back(&w);
+}
+
+// Nearest window (visual rects) in dir from `from`, topmost on ties
+inline const WindowInfo* Neighbour(const Snapshot& s, const WindowInfo& from, spatial::Dir dir, uint8_t need) {
+    const WindowInfo* best = nullptr;
+    int64_t bestScore = std::numeric_limits<int64_t>::max();
+    for (const WindowInfo& w : s.z) {
+        if (w.key == from.key || (w.flags & need) != need)
+            continue;
+        const int64_t score = spatial::Grid::Score(from.visual, w.visual, dir);
+        if (score >= 0 && score < bestScore) {
+            bestScore = score;
+            best = &w;
+        }
+    }
+    return best;
+}
+} // namespace utils::wnd
@@ -0,0 +1,234 @@
+#include <pch.hpp>
+// helpers/window_tracker.cpp
+#include "window_tracker.hpp"
+#include "dwm.hpp"
+#include "utils.hpp"
+#include <dwmapi.h>
+#pragma comment(lib, "Dwmapi.lib")
+
+namespace utils::wnd {
+static geom::Rect FromRECT(const RECT& r) {
+    return {r.left, r.top, r.right, r.bottom};
+}
+
+static geom::Rect VirtualScreen() {
+    const int x = GetSystemMetrics(SM_XVIRTUALSCREEN);
+    const int y = GetSystemMetrics(SM_YVIRTUALSCREEN);
+    return {x, y, x + GetSystemMetrics(SM_CXVIRTUALSCREEN), y + GetSystemMetrics(SM_CYVIRTUALSCREEN)};
+}
+
+Tracker::Tracker() : ownPid(GetCurrentProcessId()) {
+    instance = this;
+    trackThread = std::jthread([this](std::stop_token st) { TrackLoop(st); });
+}
+
+Tracker::~Tracker() {
+    if (trackThread.joinable()) {
+        trackThread.request_stop(); // the stop callback wakes the message wait
+        trackThread.join();
+    }
+    instance = nullptr;
+}
+
+void Tracker::BindReader() noexcept {
+    readerThread.store(GetCurrentThreadId(), std::memory_order_release);
+}
+
+const Snapshot* Tracker::ReaderSnapshot() {
+    if (readerThread.load(std::memory_order_relaxed) != GetCurrentThreadId() || !published.load(std::memory_order_acquire))
+        return nullptr;
+    return &snapshots.Read();
+}
+
+bool Tracker::FilteredWindowAt(const POINT& pt, HWND& out) {
+    const Snapshot* s = instance ? instance->ReaderSnapshot() : nullptr;
+    if (!s)
+        return false;
+    const WindowInfo* w = HitFiltered(*s, {pt.x, pt.y});
+    out = w ? reinterpret_cast<HWND>(w->key) : nullptr;
+    return true;
+}
+
+bool Tracker::WindowAt(const POINT& pt, HWND& out) {
+    const Snapshot* s = instance ? instance->ReaderSnapshot() : nullptr;
+    if (!s)
+        return false;
+    const WindowInfo* w = HitAny(*s, {pt.x, pt.y});
+    out = w ? reinterpret_cast<HWND>(w->key) : nullptr;
+    return true;
+}
+
+bool Tracker::ExeOf(HWND hwnd, proc::NameId& out) {
+    const Snapshot* s = instance ? instance->ReaderSnapshot() : nullptr;
+    if (!s)
+        return false;
+    const WindowInfo* w = Find(*s, reinterpret_cast<uint64_t>(hwnd));
+    if (!w || w->exe == proc::kNoName)
+        return false;
+    out = w->exe;
+    return true;
+}
+
+void Tracker::Refresh(HWND hwnd) {
+    const uint64_t key = reinterpret_cast<uint64_t>(hwnd);
+    WindowInfo w{key};
+
+    RECT win{}, vis{};
+    DWORD pid = 0;
+    GetWindowThreadProcessId(hwnd, &pid);
+    if (!pid || pid == ownPid || !IsWindowVisible(hwnd) || !utils::dwm::GetVisual(hwnd, win, vis)) {
+        registry.Remove(key);
+        return;
+    }
+
+    w.window = FromRECT(win);
+    w.visual = FromRECT(vis);
+    w.style = static_cast<uint32_t>(GetWindowLongPtrW(hwnd, GWL_STYLE));
+    w.exStyle = static_cast<uint32_t>(GetWindowLongPtrW(hwnd, GWL_EXSTYLE));
+    w.pid = pid;
+
+    // the image never changes for a window, only the first sighting opens its process
+    const WindowInfo* known = registry.Find(key);
+    w.exe = known && known->pid == pid && known->exe != proc::kNoName ? known->exe : utils::GetProcessNameId(hwnd);
+    if (known && (known->style != w.style || known->exStyle != w.exStyle))
+        utils::ForgetRules(hwnd); // style: matchers may now answer differently
+
+    BOOL cloaked = FALSE;
+    if (SUCCEEDED(DwmGetWindowAttribute(hwnd, DWMWA_CLOAKED, &cloaked, sizeof(cloaked))) && cloaked)
+        w.flags |= Cloaked;
+    if (IsIconic(hwnd))
+        w.flags |= Iconic;
+    if (!(w.flags & (Cloaked | Iconic)))
+        w.flags |= Usable;
+    if ((w.flags & Usable) && utils::FilteredTopLevel(hwnd) == hwnd)
+        w.flags |= Filtered;
+    if (utils::IsShellProtected(hwnd))
+        w.flags |= ShellProtected;
+    constexpr uint32_t kClickThrough = WS_EX_LAYERED | WS_EX_TRANSPARENT;
+    if ((w.style & WS_DISABLED) || (w.exStyle & kClickThrough) == kClickThrough)
+        w.flags |= PointTransparent;
+
+    registry.Upsert(w);
+}
+
+void Tracker::Resync() {
+    // monitor layout changes show up as a burst of moves and reorders
+    const geom::Rect world = VirtualScreen();
+    const geom::Rect& cur = registry.World();
+    if (world.left != cur.left || world.top != cur.top || world.right != cur.right || world.bottom != cur.bottom)
+        registry.SetWorld(world);
+
+    order.clear();
+    EnumWindows(
+      [](HWND h, LPARAM lp) -> BOOL {
+          if (IsWindowVisible(h))
+              reinterpret_cast<Tracker*>(lp)->order.push_back(reinterpret_cast<uint64_t>(h));
+          return TRUE;
+      },
+      reinterpret_cast<LPARAM>(this));
+
+    for (uint64_t key : order)
+        if (!registry.Find(key))
+            Refresh(reinterpret_cast<HWND>(key));
+    registry.Restack(order);
+}
+
+// Out of context: runs on the tracker thread while it pumps messages
+void CALLBACK Tracker::WinEventProc(HWINEVENTHOOK, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD, DWORD) {
+    if (!instance || !hwnd)
+        return;
+    Tracker& t = *instance;
+    const HWND desktop = GetDesktopWindow();
+
+    // top-level z-order changes are reported on the desktop
+    if (event == EVENT_OBJECT_REORDER) {
+        if (hwnd == desktop || GetAncestor(hwnd, GA_PARENT) == desktop)
+            t.orderDirty = true;
+        return;
+    }
+    if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF)
+        return;
+
+    switch (event) {
+        case EVENT_OBJECT_DESTROY:
+            utils::ForgetRules(hwnd); // the handle may be reused by an unrelated window
+            [[fallthrough]];
+        case EVENT_OBJECT_HIDE:
+            t.registry.Remove(reinterpret_cast<uint64_t>(hwnd)); // no-op for child windows
+            return;
+        case EVENT_OBJECT_NAMECHANGE:
+            if (GetAncestor(hwnd, GA_PARENT) == desktop)
+                utils::ForgetRules(hwnd); // title matchers
+            return;
+        case EVENT_SYSTEM_FOREGROUND:
+            t.orderDirty = true;
+            break;
+        default:
+            break;
+    }
+
+    if (GetAncestor(hwnd, GA_PARENT) != desktop)
+        return;
+    const bool known = t.registry.Find(reinterpret_cast<uint64_t>(hwnd)) != nullptr;
+    t.Refresh(hwnd);
+    if (!known)
+        t.orderDirty = true; // new windows go on top until placed by the next resync
+}
+
+void Tracker::Hook() {
+    const auto add = [&](DWORD first, DWORD last) {
+        if (HWINEVENTHOOK h = SetWinEventHook(first, last, nullptr, WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS))
+            hooks.push_back(h);
+        else
+            LOG_E("Window tracker hook {:#x} failed: {}", first, GetLastError());
+    };
+    HOOK_INSTALL();
+    add(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND);
+    add(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND);
+    add(EVENT_OBJECT_CREATE, EVENT_OBJECT_REORDER); // create, destroy, show, hide, reorder
+    add(EVENT_OBJECT_LOCATIONCHANGE, EVENT_OBJECT_LOCATIONCHANGE);
+    add(EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE);
+    add(EVENT_OBJECT_CLOAKED, EVENT_OBJECT_UNCLOAKED);
+}
+
+void Tracker::Unhook() {
+    HOOK_REMOVE();
+    for (HWINEVENTHOOK h : hooks)
+        UnhookWinEvent(h);
+    hooks.clear();
+}
+
+void Tracker::TrackLoop(std::stop_token st) {
+    SET_THREAD_NAME("Window Tracker");
+
+    MSG msg;
+    PeekMessageW(&msg, nullptr, WM_USER, WM_USER, PM_NOREMOVE); // message queue exists before the id is published
+    threadId.store(GetCurrentThreadId(), std::memory_order_release);
+    std::stop_callback onStop(st, [this] { PostThreadMessageW(threadId.load(std::memory_order_relaxed), WM_NULL, 0, 0); });
+
+    Hook();
+    uint64_t publishedVersion = ~0ull;
+
+    while (!st.stop_requested()) {
+        // a burst of events is drained before anything is published
+        if (orderDirty) {
+            orderDirty = false;
+            Resync();
+        }
+        if (registry.Version() != publishedVersion) {
+            registry.CopyTo(staging);
+            snapshots.Write(staging);
+            publishedVersion = registry.Version();
+            published.store(true, std::memory_order_release);
+        }
+
+        MsgWaitForMultipleObjectsEx(0, nullptr, INFINITE, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE)) {
+            TranslateMessage(&msg);
+            DispatchMessageW(&msg);
+        }
+    }
+
+    Unhook();
+}
+} // namespace utils::wnd
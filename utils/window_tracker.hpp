@@ -0,0 +1,58 @@
+// helpers/window_tracker.hpp
+#pragma once
+#include <Windows.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "process_cache.hpp"
+#include "window_registry.hpp"
+#include "../tripleBuffer.hpp"
+
+namespace utils::wnd {
+// Keeps a Registry of the visible top-level windows current from WinEvent notifications on its own
+// thread (create/destroy/show/hide/location/reorder/minimize/cloak) and publishes a Snapshot after
+// each burst, with a spatial grid over the window rects. One reader thread hit-tests the snapshot
+// without syscalls: utils::GetWindow and utils::GetFilteredWindow use it there and keep the
+// z-order walk on every other thread.
+class Tracker {
+  public:
+    Tracker();
+    ~Tracker();
+
+    // Call once on the thread that hit-tests (the input reactor)
+    static void BindReader() noexcept;
+
+    // false: not the reader thread or nothing published yet, do the syscall walk
+    static bool FilteredWindowAt(const POINT& pt, HWND& out);
+    static bool WindowAt(const POINT& pt, HWND& out);
+    // Image name id recorded when the window was first seen (reader thread, same contract)
+    static bool ExeOf(HWND hwnd, proc::NameId& out);
+
+  private:
+    void TrackLoop(std::stop_token st);
+    void Hook();
+    void Unhook();
+    void Refresh(HWND hwnd); // re-query one window
+    void Resync();           // z-order from EnumWindows, picks up windows missed so far
+    const Snapshot* ReaderSnapshot();
+    static void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject, LONG idChild, DWORD thread, DWORD time);
+
+    static inline Tracker* instance = nullptr;
+    static inline std::atomic<DWORD> readerThread{0};
+
+    // tracker thread
+    Registry registry;
+    Snapshot staging;
+    std::vector<uint64_t> order;
+    std::vector<HWINEVENTHOOK> hooks;
+    bool orderDirty = true;
+    DWORD ownPid = 0;
+
+    TripleBuffer<Snapshot> snapshots; // tracker -> reader
+    std::atomic<bool> published{false};
+    std::atomic<DWORD> threadId{0};
+
+    std::jthread trackThread; // last: stopped before the rest goes away
+};
+} // namespace utils::wnd
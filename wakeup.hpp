@@ -0,0 +1,90 @@
+#pragma once
+// wakeup.hpp
+// Lost-wakeup-free signal for single consumer loops.
+// Producers bump a sequence counter and only pay for a kernel wake (WaitOnAddress/futex)
+// when the consumer is actually parked. The consumer spins a bounded number of times before parking.
+//
+//   const uint32_t seen = wake.Epoch();
+//   while (queue.pop(ev)) ...;
+//   wake.Wait(seen); // returns at once if anything was signalled since Epoch()
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+class Wakeup {
+  public:
+    struct Stats {
+        uint64_t notifies = 0;     // Notify() calls
+        uint64_t kernelWakes = 0;  // notifies that had to wake a parked consumer
+        uint64_t spinHits = 0;     // waits satisfied during the spin phase
+        uint64_t parks = 0;        // waits that blocked in the kernel
+    };
+
+    explicit Wakeup(uint32_t spinLimit = 512) noexcept : spinLimit_(spinLimit) {}
+
+    uint32_t Epoch() const noexcept {
+        return seq_.load(std::memory_order_acquire);
+    }
+
+    void Notify() noexcept {
+        notifies_.fetch_add(1, std::memory_order_relaxed);
+        // seq_cst pairs with the waiter registration in Wait(): either the waiter sees
+        // the new sequence before parking or we see it registered and wake it.
+        seq_.fetch_add(1, std::memory_order_seq_cst);
+        // only the first producer after a park pays for the syscall
+        if (parked_.load(std::memory_order_seq_cst) && parked_.exchange(false, std::memory_order_seq_cst)) {
+            kernelWakes_.fetch_add(1, std::memory_order_relaxed);
+            seq_.notify_one();
+        }
+    }
+
+    void Wait(uint32_t seen) noexcept {
+        for (uint32_t i = 0; i < spinLimit_; ++i) {
+            if (seq_.load(std::memory_order_acquire) != seen) {
+                spinHits_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            CpuRelax();
+        }
+
+        for (;;) {
+            parked_.store(true, std::memory_order_seq_cst);
+            if (seq_.load(std::memory_order_seq_cst) != seen)
+                break;
+            parks_.fetch_add(1, std::memory_order_relaxed);
+            seq_.wait(seen, std::memory_order_acquire);
+            if (seq_.load(std::memory_order_acquire) != seen)
+                break;
+        }
+        parked_.store(false, std::memory_order_relaxed);
+    }
+
+    Stats GetStats() const noexcept {
+        return {notifies_.load(std::memory_order_relaxed),
+          kernelWakes_.load(std::memory_order_relaxed),
+          spinHits_.load(std::memory_order_relaxed),
+          parks_.load(std::memory_order_relaxed)};
+    }
+
+    static inline void CpuRelax() noexcept {
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+  private:
+    alignas(64) std::atomic<uint32_t> seq_{0};
+    std::atomic<bool> parked_{false}; // single consumer
+    uint32_t spinLimit_;
+
+    alignas(64) std::atomic<uint64_t> notifies_{0};
+    std::atomic<uint64_t> kernelWakes_{0};
+    std::atomic<uint64_t> spinHits_{0};
+    std::atomic<uint64_t> parks_{0};
+};